@@ -3,17 +3,50 @@
 #include <iostream>
 
 bool Arguments::empty() const {
-	return file_path.empty() && !help && !version && !init;
+	return file_path.empty() && !help && !version && !init && !build;
 }
 
 CLI::CLI(const std::vector<std::string>& raw_args) : args(raw_args.size()) {
-	for (const std::string& arg : raw_args) {
-		if (arg.find(".zk", 0) != std::string::npos) args.file_path = arg;
+	for (size_t i = 0; i < raw_args.size(); i++) {
+		const std::string& arg = raw_args[i];
+		if (arg.rfind("--engine=", 0) == 0) {
+			// Options don't count as separate arguments.
+			args.engine = arg.substr(9);
+			args.count--;
+		}
+		else if (arg == "--jit") {
+			args.jit = true;
+			args.count--;
+		}
+		else if (arg == "--dump-optimized") {
+			args.dumpOptimized = true;
+			args.count--;
+		}
+		else if (arg == "--diagnostics") {
+			args.diagnostics = true;
+			args.count--;
+		}
+		else if (arg.rfind("--inline-budget=", 0) == 0) {
+			args.inlineBudget = arg.substr(16);
+			args.count--;
+		}
+		else if (arg == "-o" && i + 1 < raw_args.size()) {
+			args.output = raw_args[++i];
+			args.count -= 2;
+		}
+		else if (arg == "build") {
+			args.build = true;
+			args.count--;
+		}
+		else if (arg.find(".zk", 0) != std::string::npos) args.file_path = arg;
 		else if (arg.find("help", 0) != std::string::npos) args.help = true;
 		else if (arg.find("version", 0) != std::string::npos) args.version = true;
 		else if (arg.find("init", 0) != std::string::npos) args.init = true;
 		else if (arg.find("--file", 0) != std::string::npos) args.count--;
 	}
+	if (args.build && args.output.empty()) {
+		args.output = args.file_path.substr(0, args.file_path.rfind(".zk"));
+	}
 }
 
 void CLI::checkout() const {
@@ -29,14 +62,39 @@ void CLI::checkout() const {
 			"Too many arguments."
 		);
 	}
+	if (args.build && args.file_path.empty()) {
+		throw ZynkError(
+			ZynkErrorType::CLIError,
+			"No script to build was given."
+		);
+	}
+	if (args.engine != "tree" && args.engine != "vm" && args.engine != "closure") {
+		throw ZynkError(
+			ZynkErrorType::CLIError,
+			"Unknown engine '" + args.engine + "'. Available engines: tree, vm, closure."
+		);
+	}
+	if (args.inlineBudget.find_first_not_of("0123456789") != std::string::npos || args.inlineBudget.size() > 9) {
+		throw ZynkError(
+			ZynkErrorType::CLIError,
+			"Invalid inline budget '" + args.inlineBudget + "'. Expected a number of nodes."
+		);
+	}
 }
 
 void CLI::show_help() const {
 	std::cout << std::endl << "<----- Zynk Help ----->" << std::endl;
 	std::cout << "Zynk - A simple interpreted programming language, written in C++." << std::endl << std::endl;
-	std::cout << "Example Usage:\n >> Zynk main.zk\n\n";
+	std::cout << "Example Usage:\n >> Zynk main.zk\n >> Zynk build main.zk -o main\n\n";
 	std::cout << "Arguments:\n"
 		" --file <path>: Specifies the path to the script file that you want to interpret.\n"
+		" --engine=<tree|vm|closure>: Selects the execution engine (tree-walking evaluator by default).\n"
+		" --jit: Compiles hot numeric functions and loops to machine code (x86-64 only).\n"
+		" --dump-optimized: Prints the script as the optimizer rewrote it, instead of running it.\n"
+		" --diagnostics: Reports what the optimizer changed on stderr before running the script.\n"
+		" --inline-budget=<nodes>: Largest function body the optimizer inlines at calls (0 disables inlining).\n"
+		" build <path> -o <output>: Compiles the script to a native executable through C++.\n"
+		"   ZYNK_CXX, ZYNK_INCLUDE_DIR and ZYNK_LIBRARY override the compiler, headers and library it uses.\n"
 		" --init: Initializes a basic script file template in the current directory.\n"
 		" --version: Displays the current version of Zynk interpreter.\n"
 		" --help: Displays this help message.\n";
@@ -15,6 +15,13 @@ struct Arguments {
 	bool help = false;
 	bool version = false;
 	bool init = false;
+	std::string engine = "tree";
+	bool jit = false;
+	bool build = false;
+	bool dumpOptimized = false;
+	bool diagnostics = false;
+	std::string inlineBudget; // Largest function body inlined, in nodes. The optimizer's default if empty.
+	std::string output; // Executable written by `build`, the script name without .zk by default.
 };
 
 class CLI {
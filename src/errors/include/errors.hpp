@@ -22,6 +22,7 @@ enum class ZynkErrorType {
     DuplicateDeclarationError,
     TypeCastError,
     RecursionError,
+    BuildError,
 };
 
 class ZynkError : public std::runtime_error {
@@ -60,6 +61,7 @@ private:
             case ZynkErrorType::DuplicateDeclarationError: return "DuplicateDeclarationError";
             case ZynkErrorType::TypeCastError: return "TypeCastError";
             case ZynkErrorType::RecursionError: return "RecursionError";
+            case ZynkErrorType::BuildError: return "BuildError";
             default: return "UnknownError";
         }
     }
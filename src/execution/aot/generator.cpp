@@ -0,0 +1,436 @@
+#include "include/generator.hpp"
+
+#include <cstring>
+
+static std::string binaryOperatorName(ASTBinaryOperator op) {
+    switch (op) {
+        case ASTBinaryOperator::Add: return "ASTBinaryOperator::Add";
+        case ASTBinaryOperator::Subtract: return "ASTBinaryOperator::Subtract";
+        case ASTBinaryOperator::Multiply: return "ASTBinaryOperator::Multiply";
+        case ASTBinaryOperator::Divide: return "ASTBinaryOperator::Divide";
+    }
+    return "";
+}
+
+static std::string comparisonOperatorName(ASTComparisonOperator op) {
+    switch (op) {
+        case ASTComparisonOperator::Equal: return "ASTComparisonOperator::Equal";
+        case ASTComparisonOperator::NotEqual: return "ASTComparisonOperator::NotEqual";
+        case ASTComparisonOperator::Greater: return "ASTComparisonOperator::Greater";
+        case ASTComparisonOperator::GreaterOrEqual: return "ASTComparisonOperator::GreaterOrEqual";
+        case ASTComparisonOperator::Less: return "ASTComparisonOperator::Less";
+        case ASTComparisonOperator::LessOrEqual: return "ASTComparisonOperator::LessOrEqual";
+    }
+    return "";
+}
+
+static std::string functionName(size_t id) {
+    return "function_" + std::to_string(id);
+}
+
+std::string CppGenerator::generate(const ASTProgram& program, const std::string& filePath) {
+    functions.assign(program.functionCount, nullptr);
+
+    open("static void program(NativeRuntime& rt) {");
+    line("rt.env.enterProgram(" + std::to_string(program.frameSize) + ");");
+    generateBody(program.body);
+    line("rt.env.exitFrame();");
+    close();
+    while (!pending.empty()) {
+        const ASTFunction* function = pending.back();
+        pending.pop_back();
+        generateFunction(*function);
+    }
+
+    std::ostringstream source;
+    source << "// Generated by Zynk from " << filePath << ".\n"
+           << "#include \"execution/aot/include/native.hpp\"\n"
+           << "#include \"errors/include/errors.hpp\"\n\n"
+           << "#include <iostream>\n"
+           << "#include <stdexcept>\n\n";
+    if (!names.empty()) {
+        source << "static const std::string names[] = {\n";
+        for (const std::string& text : names) source << "    " << quote(text) << ",\n";
+        source << "};\n\n";
+    }
+    if (!constants.empty()) {
+        source << "static const Value constants[] = {\n";
+        for (const std::string& value : constants) source << "    " << value << ",\n";
+        source << "};\n\n";
+    }
+    for (const ASTFunction* function : functions) {
+        if (function == nullptr) continue;
+        source << "static Value " << functionName(function->id) << "(NativeRuntime& rt, size_t scope, Value* arguments);\n";
+    }
+    source << "\n" << code.str() << "\n";
+
+    source << "int main() {\n    return NativeRuntime::main(program, {\n";
+    for (const ASTFunction* function : functions) {
+        if (function == nullptr) {
+            source << "        { \"\", ASTValueType::None, 0, 0 },\n";
+            continue;
+        }
+        source << "        { " << quote(function->name) << ", " << valueType(function->returnType) << ", "
+               << function->line << ", " << function->frameSize << " },\n";
+    }
+    source << "    }, " << quote(filePath) << ");\n}\n";
+    return source.str();
+}
+
+void CppGenerator::generateFunction(const ASTFunction& function) {
+    inFunction = true;
+    openBlocks = 0;
+    loops.clear();
+
+    code << "\n";
+    open("static Value " + functionName(function.id) + "(NativeRuntime& rt, size_t scope, Value* arguments) {");
+    line("rt.env.enterFunction(rt.function(" + std::to_string(function.id) + "), scope);");
+    for (size_t i = 0; i < function.arguments.size(); i++) {
+        const auto argument = static_cast<const ASTFunctionArgument*>(function.arguments[i].get());
+        line(
+            "rt.env.bindArgument(" + std::to_string(argument->slot) + ", " + valueType(argument->valueType)
+            + ", std::move(arguments[" + std::to_string(i) + "]));"
+        );
+    }
+    generateBody(function.body);
+    line("rt.env.exitFrame();");
+    if (function.returnType != ASTValueType::None) {
+        line("rt.missingReturn(" + std::to_string(function.id) + ");");
+    } else {
+        line("return Value();");
+    }
+    close();
+}
+
+void CppGenerator::generateBody(const std::vector<std::unique_ptr<ASTBase>>& body) {
+    for (const std::unique_ptr<ASTBase>& child : body) {
+        if (child != nullptr) generateStatement(*child);
+    }
+}
+
+void CppGenerator::generateStatement(const ASTBase& statement) {
+    const std::string statementLine = std::to_string(statement.line);
+
+    switch (statement.type) {
+        case ASTType::FunctionDeclaration: {
+            const auto& function = static_cast<const ASTFunction&>(statement);
+            functions[function.id] = &function;
+            pending.push_back(&function);
+            line("rt.env.declareFunction(&rt.function(" + std::to_string(function.id) + "));");
+            break;
+        }
+        case ASTType::FunctionCall:
+            generateFunctionCall(static_cast<const ASTFunctionCall&>(statement));
+            break;
+        case ASTType::VariableDeclaration: {
+            const auto& declaration = static_cast<const ASTVariableDeclaration&>(statement);
+            const std::string value = generateExpression(declaration.value.get());
+            line(
+                "rt.env.declareVariable(" + name(declaration.name) + ", " + std::to_string(declaration.slot) + ", "
+                + valueType(declaration.varType) + ", " + moved(value) + ", " + statementLine + ");"
+            );
+            break;
+        }
+        case ASTType::VariableModify: {
+            const auto& variableModify = static_cast<const ASTVariableModify&>(statement);
+            line("rt.env.getVariable(" + name(variableModify.name) + ", " + binding(variableModify.binding) + ", " + statementLine + ");");
+            const std::string value = generateExpression(variableModify.value.get());
+            line("rt.env.findVariable(" + binding(variableModify.binding) + ")->value = " + moved(value) + ";");
+            break;
+        }
+        case ASTType::Print: {
+            const auto& print = static_cast<const ASTPrint&>(statement);
+            const std::string value = generateExpression(print.expression.get());
+            line("std::cout << " + value + (print.newLine ? " << \"\\n\";" : ";"));
+            break;
+        }
+        case ASTType::Condition: {
+            const auto& condition = static_cast<const ASTCondition&>(statement);
+            const std::string status = generateExpression(condition.expression.get());
+            line("rt.env.enterNewBlock();");
+            openBlocks++;
+            open("if (" + status + ".isTruthy()) {");
+            generateBody(condition.body);
+            if (!condition.elseBody.empty()) {
+                close("} else {");
+                indent++;
+                generateBody(condition.elseBody);
+            }
+            close();
+            openBlocks--;
+            line("rt.env.exitCurrentBlock();");
+            break;
+        }
+        case ASTType::While: {
+            const auto& loop = static_cast<const ASTWhile&>(statement);
+            line("rt.env.enterNewBlock();");
+            openBlocks++;
+            loops.push_back(openBlocks);
+            open("while (true) {");
+            line("if (!" + generateExpression(loop.value.get()) + ".isTruthy()) break;");
+            generateBody(loop.body);
+            close();
+            loops.pop_back();
+            openBlocks--;
+            line("rt.env.exitCurrentBlock();");
+            break;
+        }
+        case ASTType::Return: {
+            const std::string value = generateExpression(&statement);
+            if (!inFunction) {
+                line("throw ZynkError(ZynkErrorType::SyntaxError, \"'return' outside of a function.\", " + statementLine + ");");
+                break;
+            }
+            exitBlocks(openBlocks);
+            line("rt.env.exitFrame();");
+            line("return " + value + ";");
+            break;
+        }
+        case ASTType::Break:
+            if (loops.empty()) {
+                line("throw ZynkError(ZynkErrorType::SyntaxError, \"'break' outside of a loop.\", " + statementLine + ");");
+                break;
+            }
+            exitBlocks(openBlocks - loops.back());
+            line("break;");
+            break;
+        case ASTType::ReadInput:
+        case ASTType::Variable:
+        case ASTType::Value:
+            generateExpression(&statement);
+            break;
+        default:
+            line("throw std::runtime_error(\"Unknown AST type encountered during evaluation.\");");
+    }
+}
+
+std::string CppGenerator::generateExpression(const ASTBase* expression) {
+    if (expression == nullptr) return "Value()";
+
+    const std::string expressionLine = std::to_string(expression->line);
+    switch (expression->type) {
+        case ASTType::Value:
+            return constant(static_cast<const ASTValue*>(expression)->constant);
+        case ASTType::Variable: {
+            const auto variable = static_cast<const ASTVariable*>(expression);
+            const std::string result = temporary();
+            line(
+                "Value " + result + " = rt.env.getVariable(" + name(variable->name) + ", "
+                + binding(variable->binding) + ", " + expressionLine + ")->value;"
+            );
+            return result;
+        }
+        case ASTType::ReadInput: {
+            const auto read = static_cast<const ASTReadInput*>(expression);
+            if (read->out != nullptr) line("std::cout << " + generateExpression(read->out.get()) + ";");
+            const std::string result = temporary();
+            line("Value " + result + " = NativeRuntime::readLine();");
+            return result;
+        }
+        case ASTType::TypeCast: {
+            const auto typeCast = static_cast<const ASTTypeCast*>(expression);
+            const std::string base = generateExpression(typeCast->value.get());
+            const std::string result = temporary();
+            line(
+                "Value " + result + " = NativeRuntime::cast(" + base + ", " + valueType(typeCast->castType)
+                + ", " + expressionLine + ");"
+            );
+            return result;
+        }
+        case ASTType::FString: {
+            const auto fString = static_cast<const ASTFString*>(expression);
+            const std::string result = temporary();
+            const std::string text = result + "Text";
+            line("std::string " + text + ";");
+            line(text + ".reserve(" + std::to_string(fString->literalLength + fString->parts.size() * 8) + ");");
+            for (const std::unique_ptr<ASTBase>& part : fString->parts) {
+                line(generateExpression(part.get()) + ".appendTo(" + text + ");");
+            }
+            line("Value " + result + " = Value::fromString(std::move(" + text + "));");
+            return result;
+        }
+        case ASTType::BinaryOperation: {
+            const auto operation = static_cast<const ASTBinaryOperation*>(expression);
+            const std::string left = generateExpression(operation->left.get());
+            const std::string right = generateExpression(operation->right.get());
+            const std::string result = temporary();
+            line(
+                "Value " + result + " = NativeRuntime::binary(" + left + ", " + right + ", "
+                + binaryOperatorName(operation->op) + ", " + expressionLine + ");"
+            );
+            return result;
+        }
+        case ASTType::ComparisonOperation: {
+            const auto operation = static_cast<const ASTComparisonOperation*>(expression);
+            const std::string left = generateExpression(operation->left.get());
+            const std::string right = generateExpression(operation->right.get());
+            const std::string result = temporary();
+            line(
+                "Value " + result + " = NativeRuntime::compare(" + left + ", " + right + ", "
+                + comparisonOperatorName(operation->op) + ");"
+            );
+            return result;
+        }
+        case ASTType::OrOperation:
+        case ASTType::AndOperation: {
+            // Both return the operand that decided the result, the right one is only evaluated if needed.
+            const bool isOr = expression->type == ASTType::OrOperation;
+            const ASTBase* left = isOr ? static_cast<const ASTOrOperation*>(expression)->left.get()
+                                       : static_cast<const ASTAndOperation*>(expression)->left.get();
+            const ASTBase* right = isOr ? static_cast<const ASTOrOperation*>(expression)->right.get()
+                                        : static_cast<const ASTAndOperation*>(expression)->right.get();
+            const std::string leftValue = generateExpression(left);
+            const std::string result = temporary();
+            line("Value " + result + " = " + moved(leftValue) + ";");
+            open(std::string("if (") + (isOr ? "!" : "") + result + ".isTruthy()) {");
+            line(result + " = " + moved(generateExpression(right)) + ";");
+            close();
+            return result;
+        }
+        case ASTType::FunctionCall:
+            return generateFunctionCall(*static_cast<const ASTFunctionCall*>(expression));
+        case ASTType::Return:
+            return generateExpression(static_cast<const ASTReturn*>(expression)->value.get());
+        default:
+            line(
+                "throw ZynkError(ZynkErrorType::RuntimeError, \"Invalid expression type encountered during evaluation.\", "
+                + expressionLine + ");"
+            );
+            return "Value()";
+    }
+}
+
+std::string CppGenerator::generateFunctionCall(const ASTFunctionCall& functionCall) {
+    // Calls are resolved by the type checker, the runtime only checks the declaration is in scope.
+    const std::string id = std::to_string(functionCall.function->id);
+    const std::string scope = "scope" + std::to_string(temporaries++);
+    line(
+        "const size_t " + scope + " = rt.enterCall(" + id + ", " + std::to_string(functionCall.depth) + ", "
+        + std::to_string(functionCall.line) + ");"
+    );
+
+    std::string arguments = "nullptr";
+    if (!functionCall.arguments.empty()) {
+        std::vector<std::string> values;
+        for (const std::unique_ptr<ASTBase>& argument : functionCall.arguments) {
+            values.push_back(generateExpression(argument.get()));
+        }
+        arguments = "arguments" + std::to_string(temporaries++);
+        std::string list;
+        for (const std::string& value : values) {
+            list += (list.empty() ? "" : ", ") + moved(value);
+        }
+        line("Value " + arguments + "[] = { " + list + " };");
+    }
+
+    const std::string result = temporary();
+    line("Value " + result + " = " + functionName(functionCall.function->id) + "(rt, " + scope + ", " + arguments + ");");
+    return result;
+}
+
+void CppGenerator::exitBlocks(size_t count) {
+    for (size_t i = 0; i < count; i++) line("rt.env.exitCurrentBlock();");
+}
+
+void CppGenerator::line(const std::string& text) {
+    code << std::string(indent * 4, ' ') << text << "\n";
+}
+
+void CppGenerator::open(const std::string& text) {
+    line(text);
+    indent++;
+}
+
+void CppGenerator::close(const std::string& text) {
+    indent--;
+    line(text);
+}
+
+std::string CppGenerator::temporary() {
+    return "t" + std::to_string(temporaries++);
+}
+
+std::string CppGenerator::name(const std::string& text) {
+    const auto found = nameIndices.find(text);
+    if (found != nameIndices.end()) return "names[" + std::to_string(found->second) + "]";
+
+    nameIndices.emplace(text, names.size());
+    names.push_back(text);
+    return "names[" + std::to_string(names.size() - 1) + "]";
+}
+
+std::string CppGenerator::constant(const Value& value) {
+    std::string initializer;
+    switch (value.type()) {
+        case ASTValueType::Integer:
+            // Written unsigned, INT64_MIN has no signed literal.
+            initializer = "Value::fromInt(static_cast<int64_t>(" + std::to_string(static_cast<uint64_t>(value.asInt())) + "ULL))";
+            break;
+        case ASTValueType::Float: {
+            const double number = value.asFloat();
+            uint64_t bits;
+            std::memcpy(&bits, &number, sizeof(bits));
+            initializer = "Value::fromFloat(NativeRuntime::floatFromBits(" + std::to_string(bits) + "ULL))";
+            break;
+        }
+        case ASTValueType::Bool:
+            initializer = value.asBool() ? "Value::fromBool(true)" : "Value::fromBool(false)";
+            break;
+        case ASTValueType::String:
+            initializer = "Value::fromString(std::string(" + quote(value.asString()) + ", "
+                + std::to_string(value.asString().size()) + "))";
+            break;
+        case ASTValueType::None:
+            initializer = "Value()";
+            break;
+    }
+
+    const auto found = constantIndices.find(initializer);
+    if (found != constantIndices.end()) return "constants[" + std::to_string(found->second) + "]";
+
+    constantIndices.emplace(initializer, constants.size());
+    constants.push_back(initializer);
+    return "constants[" + std::to_string(constants.size() - 1) + "]";
+}
+
+std::string CppGenerator::moved(const std::string& value) {
+    // Temporaries are used once, constants are copied.
+    return value.rfind("t", 0) == 0 ? "std::move(" + value + ")" : value;
+}
+
+std::string CppGenerator::binding(const ASTBinding& binding) {
+    return "ASTBinding{" + std::to_string(binding.depth) + ", " + std::to_string(binding.slot) + ", " + valueType(binding.type) + "}";
+}
+
+std::string CppGenerator::valueType(ASTValueType type) {
+    switch (type) {
+        case ASTValueType::String: return "ASTValueType::String";
+        case ASTValueType::Integer: return "ASTValueType::Integer";
+        case ASTValueType::Float: return "ASTValueType::Float";
+        case ASTValueType::Bool: return "ASTValueType::Bool";
+        case ASTValueType::None: return "ASTValueType::None";
+    }
+    return "ASTValueType::None";
+}
+
+std::string CppGenerator::quote(const std::string& text) {
+    static const char* digits = "01234567";
+    std::string quoted = "\"";
+    for (const char character : text) {
+        const unsigned char byte = static_cast<unsigned char>(character);
+        // A question mark could start a trigraph.
+        if (character == '"' || character == '\\' || character == '?') {
+            quoted += '\\';
+            quoted += character;
+        } else if (byte >= 0x20 && byte < 0x7f) {
+            quoted += character;
+        } else {
+            // Octal escapes end after three digits, unlike hexadecimal ones.
+            quoted += '\\';
+            quoted += digits[byte >> 6];
+            quoted += digits[(byte >> 3) & 7];
+            quoted += digits[byte & 7];
+        }
+    }
+    return quoted + "\"";
+}
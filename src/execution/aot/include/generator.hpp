@@ -0,0 +1,55 @@
+#ifndef GENERATOR_H
+#define GENERATOR_H
+
+#include "../../../parsing/include/ast.hpp"
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Translates a resolved and type checked program to C++, built against NativeRuntime.
+// Every Zynk function becomes a C++ function, and every expression is evaluated into a
+// temporary in the order the evaluator evaluates it, so the program runs and fails the same way.
+class CppGenerator {
+public:
+    // `filePath` is the script errors are reported for.
+    std::string generate(const ASTProgram& program, const std::string& filePath);
+private:
+    std::ostringstream code;
+    size_t indent = 0;
+    size_t temporaries = 0;
+
+    std::vector<std::string> names;
+    std::unordered_map<std::string, size_t> nameIndices;
+    std::vector<std::string> constants;
+    std::unordered_map<std::string, size_t> constantIndices;
+    std::vector<const ASTFunction*> functions; // Indexed by id.
+    std::vector<const ASTFunction*> pending; // Declared, but not generated yet.
+
+    bool inFunction = false;
+    // Blocks entered since the frame was, and the number of them entered around each enclosing loop.
+    size_t openBlocks = 0;
+    std::vector<size_t> loops;
+
+    void generateFunction(const ASTFunction& function);
+    void generateBody(const std::vector<std::unique_ptr<ASTBase>>& body);
+    void generateStatement(const ASTBase& statement);
+    // Returns the Value holding the result.
+    std::string generateExpression(const ASTBase* expression);
+    std::string generateFunctionCall(const ASTFunctionCall& functionCall);
+    void exitBlocks(size_t count);
+
+    void line(const std::string& text);
+    void open(const std::string& text);
+    void close(const std::string& text = "}");
+    std::string temporary();
+    std::string name(const std::string& text);
+    std::string constant(const Value& value);
+
+    static std::string moved(const std::string& value);
+    static std::string binding(const ASTBinding& binding);
+    static std::string valueType(ASTValueType type);
+    static std::string quote(const std::string& text);
+};
+
+#endif // GENERATOR_H
@@ -0,0 +1,45 @@
+#ifndef NATIVE_H
+#define NATIVE_H
+
+#include "../../include/runtime.hpp"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Runtime of the programs generated by CppGenerator. The generated code keeps its variables
+// and functions in the same environment the evaluator uses, and reports the same errors.
+class NativeRuntime {
+public:
+    // Declaration of a function of the program, indexed by its id.
+    struct Function {
+        const char* name;
+        ASTValueType returnType;
+        size_t line;
+        size_t frameSize;
+    };
+    using Program = void (*)(NativeRuntime& runtime);
+
+    explicit NativeRuntime(const std::vector<Function>& functions);
+
+    RuntimeEnvironment env;
+
+    // Runs the program like the Zynk executable runs a script, errors are reported for `filePath`.
+    static int main(Program program, const std::vector<Function>& functions, const char* filePath);
+
+    const ASTFunction& function(size_t id) const { return *functions[id]; }
+    // Checks that the called function is declared and the recursion limit isn't reached,
+    // before the arguments are evaluated. Returns the block the call runs in.
+    size_t enterCall(size_t id, size_t depth, size_t line) const;
+    [[noreturn]] void missingReturn(size_t id) const;
+
+    static Value binary(const Value& left, const Value& right, ASTBinaryOperator op, size_t line);
+    static Value compare(const Value& left, const Value& right, ASTComparisonOperator op);
+    static Value cast(const Value& value, ASTValueType type, size_t line);
+    static Value readLine();
+    // Floats are written by their bits, so that constants keep their exact value.
+    static double floatFromBits(uint64_t bits);
+private:
+    std::vector<std::unique_ptr<ASTFunction>> functions;
+};
+
+#endif // NATIVE_H
@@ -0,0 +1,89 @@
+#include "include/native.hpp"
+#include "../../errors/include/errors.hpp"
+#include "../include/evaluator.hpp"
+#include "../typechecker/include/checker.hpp"
+
+#include <cstring>
+#include <iostream>
+
+NativeRuntime::NativeRuntime(const std::vector<Function>& declarations) {
+    functions.reserve(declarations.size());
+    for (const Function& declaration : declarations) {
+        auto function = std::make_unique<ASTFunction>(declaration.name, declaration.returnType, declaration.line);
+        function->frameSize = declaration.frameSize;
+        function->id = functions.size();
+        functions.push_back(std::move(function));
+    }
+}
+
+int NativeRuntime::main(Program program, const std::vector<Function>& functions, const char* filePath) {
+    try {
+        NativeRuntime runtime(functions);
+        program(runtime);
+    } catch (const ZynkError& error) {
+        error.print(filePath);
+        return -1;
+    } catch (const std::exception& unknownError) {
+        ZynkError(
+            ZynkErrorType::PanicError,
+            std::string("The interpreter unexpectedly panicked. Additional info: \"") + unknownError.what() + "\"."
+        ).print(filePath);
+        return -1;
+    }
+    return 0;
+}
+
+size_t NativeRuntime::enterCall(size_t id, size_t depth, size_t line) const {
+    const size_t scope = env.getFunctionScope(*functions[id], depth, line);
+
+    if (env.isRecursionDepthExceeded()) {
+        throw ZynkError(
+            ZynkErrorType::RecursionError,
+            "Exceeded maximum recursion depth of " + std::to_string(env.MAX_DEPTH) + ".",
+            line
+        );
+    }
+    return scope;
+}
+
+void NativeRuntime::missingReturn(size_t id) const {
+    const ASTFunction& function = *functions[id];
+    throw ZynkError(
+        ZynkErrorType::TypeError,
+        "Function '" + function.name + "' does not return a value of type "
+        + TypeChecker::typeToString(function.returnType) + " in all control paths.",
+        function.line
+    );
+}
+
+Value NativeRuntime::binary(const Value& left, const Value& right, ASTBinaryOperator op, size_t line) {
+    try {
+        return calculateValue(left, right, op);
+    } catch (const ZynkError& err) {
+        throw ZynkError(err.base_type, err.what(), line);
+    }
+}
+
+Value NativeRuntime::compare(const Value& left, const Value& right, ASTComparisonOperator op) {
+    return compareValue(left, right, op);
+}
+
+Value NativeRuntime::cast(const Value& value, ASTValueType type, size_t line) {
+    try {
+        return castValue(value, type);
+    } catch (const ZynkError& err) {
+        throw ZynkError(err.base_type, err.what(), line);
+    }
+}
+
+Value NativeRuntime::readLine() {
+    std::string input;
+    std::getline(std::cin, input);
+    return Value::fromString(std::move(input));
+}
+
+double NativeRuntime::floatFromBits(uint64_t bits) {
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
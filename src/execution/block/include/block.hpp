@@ -2,42 +2,40 @@
 #define BLOCK_H
 
 #include "../../../parsing/include/ast.hpp"
-#include <unordered_map>
-#include <iostream>
-#include <memory>
-#include <string>
+#include <cstdint>
 
-class Block {
-public:
-    std::unordered_map<std::string, std::unique_ptr<ASTValue>> variables;
-    std::unordered_map<std::string, std::unique_ptr<ASTFunction>> functions;
-    Block* parentBlock;
+struct Variable {
+    Value value;
+    ASTValueType type = ASTValueType::None; // Declared type. A variable declared without a value holds null.
+    bool declared = false;
+};
 
-    Block(Block* parent = nullptr) : parentBlock(parent) {}
+// A program or function call. Its variables live inline in the shared slot stack of the runtime,
+// at the slots assigned by the resolver.
+struct Frame {
+    size_t base; // First slot of the frame in the slot stack.
+    size_t enclosing; // Frame of the lexically enclosing function.
+};
 
-    inline void setVariable(const std::string& name, std::unique_ptr<ASTValue> value) {
-        variables[name] = std::move(value);
-    }
+struct Block {
+    static constexpr size_t None = SIZE_MAX;
 
-    inline void setFunction(std::unique_ptr<ASTFunction> func) {
-        functions[func->name] = std::move(func);
-    }
+    size_t parentBlock; // Lexically enclosing block.
+    size_t frame;
+    // Functions declared in this block start here in the function stack of the runtime.
+    size_t firstFunction;
 
-    ASTValue* getVariable(const std::string& name, bool deepSearch = true) {
-        if (variables.find(name) != variables.end()) {
-            return variables[name].get();
-        }
-        if (parentBlock && deepSearch) return parentBlock->getVariable(name);
-        return nullptr;
-    }
+    // Range of frame slots declared in this block, released when the block is exited.
+    size_t firstSlot = SIZE_MAX;
+    size_t endSlot = 0;
+
+    Block(size_t parent, size_t frame, size_t firstFunction)
+        : parentBlock(parent), frame(frame), firstFunction(firstFunction) {}
 
-    ASTFunction* getFunction(const std::string& name, bool deepSearch = true) {
-        if (functions.find(name) != functions.end()) {
-            return functions[name].get();
-        }
-        if (parentBlock && deepSearch) return parentBlock->getFunction(name);
-        return nullptr;
+    inline void markSlot(size_t slot) {
+        if (slot < firstSlot) firstSlot = slot;
+        if (slot >= endSlot) endSlot = slot + 1;
     }
 };
 
-#endif // BLOCK_H
\ No newline at end of file
+#endif // BLOCK_H
@@ -0,0 +1,410 @@
+#include "include/closure.hpp"
+#include "../../errors/include/errors.hpp"
+
+#include <iostream>
+
+using BinaryKernel = Value (*)(const Value& left, const Value& right);
+using ComparisonKernel = Value (*)(const Value& left, const Value& right);
+
+template <ASTBinaryOperator Op>
+static Value binaryKernel(const Value& left, const Value& right) {
+    if (left.type() == ASTValueType::Integer && right.type() == ASTValueType::Integer) {
+        return Value::fromInt(calculateInteger(left.asInt(), right.asInt(), Op));
+    }
+    return calculateValue(left, right, Op);
+}
+
+template <ASTComparisonOperator Op>
+static Value comparisonKernel(const Value& left, const Value& right) {
+    if (left.type() != ASTValueType::Integer || right.type() != ASTValueType::Integer) {
+        return compareValue(left, right, Op);
+    }
+    const int64_t a = left.asInt();
+    const int64_t b = right.asInt();
+    switch (Op) {
+        case ASTComparisonOperator::Equal: return Value::fromBool(a == b);
+        case ASTComparisonOperator::NotEqual: return Value::fromBool(a != b);
+        case ASTComparisonOperator::Greater: return Value::fromBool(a > b);
+        case ASTComparisonOperator::GreaterOrEqual: return Value::fromBool(a >= b);
+        case ASTComparisonOperator::Less: return Value::fromBool(a < b);
+        case ASTComparisonOperator::LessOrEqual: return Value::fromBool(a <= b);
+    }
+    return Value::fromBool(false);
+}
+
+static BinaryKernel selectKernel(ASTBinaryOperator op) {
+    switch (op) {
+        case ASTBinaryOperator::Add: return binaryKernel<ASTBinaryOperator::Add>;
+        case ASTBinaryOperator::Subtract: return binaryKernel<ASTBinaryOperator::Subtract>;
+        case ASTBinaryOperator::Multiply: return binaryKernel<ASTBinaryOperator::Multiply>;
+        case ASTBinaryOperator::Divide: return binaryKernel<ASTBinaryOperator::Divide>;
+    }
+    return binaryKernel<ASTBinaryOperator::Add>;
+}
+
+static ComparisonKernel selectKernel(ASTComparisonOperator op) {
+    switch (op) {
+        case ASTComparisonOperator::Equal: return comparisonKernel<ASTComparisonOperator::Equal>;
+        case ASTComparisonOperator::NotEqual: return comparisonKernel<ASTComparisonOperator::NotEqual>;
+        case ASTComparisonOperator::Greater: return comparisonKernel<ASTComparisonOperator::Greater>;
+        case ASTComparisonOperator::GreaterOrEqual: return comparisonKernel<ASTComparisonOperator::GreaterOrEqual>;
+        case ASTComparisonOperator::Less: return comparisonKernel<ASTComparisonOperator::Less>;
+        case ASTComparisonOperator::LessOrEqual: return comparisonKernel<ASTComparisonOperator::LessOrEqual>;
+    }
+    return comparisonKernel<ASTComparisonOperator::Equal>;
+}
+
+ClosureEngine::ClosureEngine(bool useJit)
+    : jit(useJit ? std::make_unique<Jit>() : nullptr), tracer(useJit ? std::make_unique<Tracer>() : nullptr) {};
+
+void ClosureEngine::run(const ASTProgram& program) {
+    functions.assign(program.functionCount, Body());
+    const Body body = compileBody(program.body);
+
+    env.enterProgram(program.frameSize); // Main program code block.
+    for (const Statement& statement : body) {
+        const Completion completion = statement();
+
+        if (completion.kind == Completion::Kind::Break) {
+            throw ZynkError(ZynkErrorType::SyntaxError, "'break' outside of a loop.", completion.line);
+        }
+        if (completion.kind == Completion::Kind::Return) {
+            throw ZynkError(ZynkErrorType::SyntaxError, "'return' outside of a function.", completion.line);
+        }
+    }
+    env.exitFrame();
+}
+
+Completion ClosureEngine::executeBody(const Body& body) {
+    for (const Statement& statement : body) {
+        Completion completion = statement();
+        if (completion.kind != Completion::Kind::Normal) return completion;
+    }
+    return {};
+}
+
+ClosureEngine::Body ClosureEngine::compileBody(const std::vector<std::unique_ptr<ASTBase>>& body) {
+    Body statements;
+    statements.reserve(body.size());
+    for (const std::unique_ptr<ASTBase>& child : body) {
+        if (child != nullptr) statements.push_back(compileStatement(*child));
+    }
+    return statements;
+}
+
+ClosureEngine::Statement ClosureEngine::compileStatement(const ASTBase& statement) {
+    switch (statement.type) {
+        case ASTType::FunctionDeclaration: {
+            const auto& function = static_cast<const ASTFunction&>(statement);
+            functions[function.id] = compileBody(function.body);
+            return [this, &function]() {
+                env.declareFunction(&function);
+                return Completion();
+            };
+        }
+        case ASTType::VariableDeclaration: {
+            const auto& declaration = static_cast<const ASTVariableDeclaration&>(statement);
+            // A declaration without a value declares a `null` variable.
+            Expression value = compileExpression(declaration.value.get());
+            return [this, &declaration, value = std::move(value)]() {
+                env.declareVariable(declaration.name, declaration.slot, declaration.varType, value(), declaration.line);
+                return Completion();
+            };
+        }
+        case ASTType::VariableModify: {
+            const auto& variableModify = static_cast<const ASTVariableModify&>(statement);
+            Expression value = compileExpression(variableModify.value.get());
+            return [this, &variableModify, value = std::move(value)]() {
+                // The variable may not be declared yet when the function using it is called.
+                env.getVariable(variableModify.name, variableModify.binding, variableModify.line);
+                Value result = value();
+                // Evaluating the value can call a function, which may move the slot stack.
+                env.findVariable(variableModify.binding)->value = std::move(result);
+                return Completion();
+            };
+        }
+        case ASTType::Print: {
+            const auto& print = static_cast<const ASTPrint&>(statement);
+            Expression value = compileExpression(print.expression.get());
+            const char* end = print.newLine ? "\n" : "";
+            return [value = std::move(value), end]() {
+                std::cout << value() << end;
+                return Completion();
+            };
+        }
+        case ASTType::Condition:
+            return compileCondition(static_cast<const ASTCondition&>(statement));
+        case ASTType::While:
+            return compileWhile(static_cast<const ASTWhile&>(statement));
+        case ASTType::Return: {
+            Expression value = compileExpression(&statement);
+            const size_t line = statement.line;
+            return [value = std::move(value), line]() {
+                return Completion{ Completion::Kind::Return, value(), line };
+            };
+        }
+        case ASTType::Break: {
+            const size_t line = statement.line;
+            return [line]() {
+                return Completion{ Completion::Kind::Break, Value(), line };
+            };
+        }
+        case ASTType::FunctionCall:
+        case ASTType::ReadInput:
+        case ASTType::Variable:
+        case ASTType::Value: {
+            Expression expression = compileExpression(&statement);
+            return [expression = std::move(expression)]() {
+                expression();
+                return Completion();
+            };
+        }
+        default:
+            return []() -> Completion {
+                throw std::runtime_error("Unknown AST type encountered during evaluation.");
+            };
+    }
+}
+
+ClosureEngine::Statement ClosureEngine::compileCondition(const ASTCondition& condition) {
+    Expression expression = compileExpression(condition.expression.get());
+    Body body = compileBody(condition.body);
+    Body elseBody = compileBody(condition.elseBody);
+
+    return [this, expression = std::move(expression), body = std::move(body), elseBody = std::move(elseBody)]() {
+        const bool status = expression().isTruthy();
+
+        env.enterNewBlock();
+        Completion completion = executeBody(status ? body : elseBody);
+        env.exitCurrentBlock();
+        return completion;
+    };
+}
+
+ClosureEngine::Statement ClosureEngine::compileWhile(const ASTWhile& loop) {
+    Expression condition = compileExpression(loop.value.get());
+    Body body = compileBody(loop.body);
+
+    return [this, &loop, condition = std::move(condition), body = std::move(body)]() {
+        env.enterNewBlock();
+
+        // The tracer records iterations of the generic loop only.
+        Completion counted;
+        const auto run = [&body](size_t i) { return body[i](); };
+        if (loop.counted.has_value() && tracer == nullptr
+            && runCountedLoop(env, *loop.counted, body.size(), counted, run)) {
+            env.exitCurrentBlock();
+            return counted;
+        }
+
+        while (condition().isTruthy()) {
+            if (tracer != nullptr) {
+                const Tracer::Result result = tracer->run(loop, env);
+                if (result == Tracer::Result::LoopEnded) break;
+                if (result == Tracer::Result::CheckCondition) continue;
+            }
+            Completion completion = executeBody(body);
+
+            if (completion.kind == Completion::Kind::Break) break;
+            if (completion.kind == Completion::Kind::Return) {
+                env.exitCurrentBlock();
+                return completion;
+            }
+        }
+        env.exitCurrentBlock();
+        return Completion();
+    };
+}
+
+ClosureEngine::Expression ClosureEngine::compileExpression(const ASTBase* expression) {
+    if (expression == nullptr) return []() { return Value(); };
+
+    switch (expression->type) {
+        case ASTType::Value: {
+            const Value& constant = static_cast<const ASTValue*>(expression)->constant;
+            return [&constant]() { return constant; };
+        }
+        case ASTType::Variable: {
+            const auto& variable = *static_cast<const ASTVariable*>(expression);
+            return [this, &variable]() {
+                return env.getVariable(variable.name, variable.binding, variable.line)->value;
+            };
+        }
+        case ASTType::ReadInput:
+            return compileReadInput(*static_cast<const ASTReadInput*>(expression));
+        case ASTType::TypeCast: {
+            const auto& typeCast = *static_cast<const ASTTypeCast*>(expression);
+            Expression value = compileExpression(typeCast.value.get());
+            return [&typeCast, value = std::move(value)]() {
+                const Value base = value();
+                try {
+                    return castValue(base, typeCast.castType);
+                } catch (const ZynkError& err) {
+                    throw ZynkError(err.base_type, err.what(), typeCast.line);
+                }
+            };
+        }
+        case ASTType::FString:
+            return compileFString(*static_cast<const ASTFString*>(expression));
+        case ASTType::BinaryOperation:
+            return compileBinaryOperation(*static_cast<const ASTBinaryOperation*>(expression));
+        case ASTType::ComparisonOperation:
+            return compileComparisonOperation(*static_cast<const ASTComparisonOperation*>(expression));
+        case ASTType::OrOperation: {
+            const auto& operation = *static_cast<const ASTOrOperation*>(expression);
+            Expression left = compileExpression(operation.left.get());
+            Expression right = compileExpression(operation.right.get());
+            return [left = std::move(left), right = std::move(right)]() {
+                Value value = left();
+                if (value.isTruthy()) return value;
+                return right();
+            };
+        }
+        case ASTType::AndOperation: {
+            const auto& operation = *static_cast<const ASTAndOperation*>(expression);
+            Expression left = compileExpression(operation.left.get());
+            Expression right = compileExpression(operation.right.get());
+            return [left = std::move(left), right = std::move(right)]() {
+                Value value = left();
+                if (!value.isTruthy()) return value;
+                return right();
+            };
+        }
+        case ASTType::FunctionCall:
+            return compileFunctionCall(*static_cast<const ASTFunctionCall*>(expression));
+        case ASTType::Return:
+            return compileExpression(static_cast<const ASTReturn*>(expression)->value.get());
+        default: {
+            const size_t line = expression->line;
+            return [line]() -> Value {
+                throw ZynkError(ZynkErrorType::RuntimeError, "Invalid expression type encountered during evaluation.", line);
+            };
+        }
+    }
+}
+
+ClosureEngine::Expression ClosureEngine::compileReadInput(const ASTReadInput& read) {
+    Expression out = read.out != nullptr ? compileExpression(read.out.get()) : nullptr;
+
+    return [out = std::move(out)]() {
+        std::string input;
+        if (out) {
+            std::cout << out();
+        }
+        std::getline(std::cin, input);
+        return Value::fromString(std::move(input));
+    };
+}
+
+ClosureEngine::Expression ClosureEngine::compileFString(const ASTFString& fString) {
+    std::vector<Expression> parts;
+    for (const std::unique_ptr<ASTBase>& part : fString.parts) {
+        parts.push_back(compileExpression(part.get()));
+    }
+    const size_t capacity = fString.literalLength + fString.parts.size() * 8;
+
+    return [parts = std::move(parts), capacity]() {
+        std::string result;
+        result.reserve(capacity);
+        for (const Expression& part : parts) {
+            part().appendTo(result);
+        }
+        return Value::fromString(std::move(result));
+    };
+}
+
+ClosureEngine::Expression ClosureEngine::compileBinaryOperation(const ASTBinaryOperation& operation) {
+    Expression left = compileExpression(operation.left.get());
+    Expression right = compileExpression(operation.right.get());
+    const BinaryKernel kernel = selectKernel(operation.op);
+    const size_t line = operation.line;
+
+    return [left = std::move(left), right = std::move(right), kernel, line]() {
+        const Value leftValue = left();
+        const Value rightValue = right();
+
+        try {
+            return kernel(leftValue, rightValue);
+        } catch (const ZynkError& err) {
+            throw ZynkError(err.base_type, err.what(), line);
+        }
+    };
+}
+
+ClosureEngine::Expression ClosureEngine::compileComparisonOperation(const ASTComparisonOperation& operation) {
+    Expression left = compileExpression(operation.left.get());
+    Expression right = compileExpression(operation.right.get());
+    const ComparisonKernel kernel = selectKernel(operation.op);
+
+    return [left = std::move(left), right = std::move(right), kernel]() {
+        const Value leftValue = left();
+        const Value rightValue = right();
+        return kernel(leftValue, rightValue);
+    };
+}
+
+ClosureEngine::Expression ClosureEngine::compileFunctionCall(const ASTFunctionCall& functionCall) {
+    std::vector<Expression> argumentValues;
+    for (const std::unique_ptr<ASTBase>& argument : functionCall.arguments) {
+        argumentValues.push_back(compileExpression(argument.get()));
+    }
+    // Slots and types of the parameters, bound in the frame of the callee.
+    std::vector<std::pair<size_t, ASTValueType>> parameters;
+    for (const std::unique_ptr<ASTBase>& argument : functionCall.function->arguments) {
+        const auto parameter = static_cast<const ASTFunctionArgument*>(argument.get());
+        parameters.emplace_back(parameter->slot, parameter->valueType);
+    }
+
+    return [this, &functionCall, argumentValues = std::move(argumentValues), parameters = std::move(parameters)]() {
+        // The type checker resolved the call, so only the declaration has to be in scope.
+        const ASTFunction* func = functionCall.function;
+        const size_t scope = env.getFunctionScope(*func, functionCall.depth, functionCall.line);
+
+        if (env.isRecursionDepthExceeded()) {
+            throw ZynkError(
+                ZynkErrorType::RecursionError,
+                "Exceeded maximum recursion depth of " + std::to_string(env.MAX_DEPTH) + ".",
+                functionCall.line
+            );
+        }
+
+        // Arguments are evaluated in the frame of the caller, nested calls push theirs above them.
+        const size_t firstArgument = arguments.size();
+        for (const Expression& argument : argumentValues) {
+            arguments.push_back(argument());
+        }
+
+        if (jit != nullptr) {
+            Value result;
+            if (jit->call(*func, functionCall.depth, arguments.data() + firstArgument, env, result)) {
+                arguments.resize(firstArgument);
+                return result;
+            }
+        }
+
+        env.enterFunction(*func, scope);
+        for (size_t i = 0; i < parameters.size(); ++i) {
+            env.bindArgument(parameters[i].first, parameters[i].second, std::move(arguments[firstArgument + i]));
+        }
+        arguments.resize(firstArgument);
+        Completion completion = executeBody(functions[func->id]);
+        env.exitFrame();
+
+        if (completion.kind == Completion::Kind::Break) {
+            throw ZynkError(ZynkErrorType::SyntaxError, "'break' outside of a loop.", completion.line);
+        }
+        if (completion.kind == Completion::Kind::Return) {
+            return std::move(completion.value);
+        }
+
+        if (func->returnType != ASTValueType::None) {
+            throw ZynkError(
+                ZynkErrorType::TypeError,
+                "Function '" + functionCall.name + "' does not return a value of type "
+                + TypeChecker::typeToString(func->returnType) + " in all control paths.",
+                func->line
+            );
+        }
+        return Value();
+    };
+}
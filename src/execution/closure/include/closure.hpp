@@ -0,0 +1,46 @@
+#ifndef CLOSURE_H
+#define CLOSURE_H
+
+#include "../../include/evaluator.hpp"
+#include <functional>
+#include <memory>
+#include <vector>
+
+// Runs a program compiled to a tree of closures. Every node is translated once: its operands
+// are compiled to closures, its operator to a kernel and its variables to their bindings, so
+// running it is a chain of calls without the node dispatch of the Evaluator.
+// The closures borrow from the program tree, which must outlive the run.
+class ClosureEngine {
+public:
+    explicit ClosureEngine(bool useJit = false);
+
+    RuntimeEnvironment env;
+    // Runs the given program, which must have been resolved and type checked.
+    void run(const ASTProgram& program);
+private:
+    using Expression = std::function<Value()>;
+    using Statement = std::function<Completion()>;
+    using Body = std::vector<Statement>;
+
+    // Evaluated arguments of the calls in progress, the storage is reused by every call.
+    std::vector<Value> arguments;
+    std::vector<Body> functions; // Compiled function bodies, indexed by function id.
+    std::unique_ptr<Jit> jit; // Null unless enabled.
+    std::unique_ptr<Tracer> tracer; // Null unless the JIT is enabled.
+
+    Completion executeBody(const Body& body);
+
+    Body compileBody(const std::vector<std::unique_ptr<ASTBase>>& body);
+    Statement compileStatement(const ASTBase& statement);
+    Statement compileCondition(const ASTCondition& condition);
+    Statement compileWhile(const ASTWhile& loop);
+
+    Expression compileExpression(const ASTBase* expression);
+    Expression compileReadInput(const ASTReadInput& read);
+    Expression compileFString(const ASTFString& fString);
+    Expression compileBinaryOperation(const ASTBinaryOperation& operation);
+    Expression compileComparisonOperation(const ASTComparisonOperation& operation);
+    Expression compileFunctionCall(const ASTFunctionCall& functionCall);
+};
+
+#endif // CLOSURE_H
@@ -1,530 +1,306 @@
 #include "../errors/include/errors.hpp"
 #include "include/evaluator.hpp"
+#include "../value/include/numeric.hpp"
 
+#include <cstdint>
 #include <memory>
-#include <cassert>
-#include <unordered_map>
+#include <vector>
 
-Evaluator::Evaluator() : typeChecker(env) {};
+Evaluator::Evaluator(bool useJit)
+    : jit(useJit ? std::make_unique<Jit>() : nullptr), tracer(useJit ? std::make_unique<Tracer>() : nullptr) {};
 
-void Evaluator::evaluate(std::unique_ptr<ASTBase> ast) {
-    assert(ast != nullptr && "Ast should not be nullptr");
+void Evaluator::evaluate(const ASTBase& ast) {
+    if (ast.type == ASTType::Program) {
+        evaluateProgram(static_cast<const ASTProgram&>(ast));
+        return;
+    }
+    const Completion completion = execute(ast);
 
-    switch (ast->type) {
-        case ASTType::Program: {
-            std::unique_ptr<ASTProgram> programPtr(
-                static_cast<ASTProgram*>(ast.release())
-            );
-            evaluateProgram(std::move(programPtr));
-            break;
-        }
-        case ASTType::FunctionDeclaration: {
-            std::unique_ptr<ASTFunction> funcDeclPtr(
-                static_cast<ASTFunction*>(ast.release())
-            );
-            evaluateFunctionDeclaration(std::move(funcDeclPtr));
-            break;
-        }
-        case ASTType::FunctionCall: {
-            std::unique_ptr<ASTFunctionCall> funcCallPtr(
-                static_cast<ASTFunctionCall*>(ast.release())
-            );
-            evaluateFunctionCall(std::move(funcCallPtr));
-            break;
-        }
-        case ASTType::VariableDeclaration: {
-            std::unique_ptr<ASTVariableDeclaration> varDeclPtr(
-                static_cast<ASTVariableDeclaration*>(ast.release())
-            );
-            evaluateVariableDeclaration(std::move(varDeclPtr));
+    if (completion.kind == Completion::Kind::Break) {
+        throw ZynkError(ZynkErrorType::SyntaxError, "'break' outside of a loop.", completion.line);
+    }
+    if (completion.kind == Completion::Kind::Return) {
+        throw ZynkError(ZynkErrorType::SyntaxError, "'return' outside of a function.", completion.line);
+    }
+}
+
+Completion Evaluator::execute(const ASTBase& statement) {
+    switch (statement.type) {
+        case ASTType::FunctionDeclaration:
+            evaluateFunctionDeclaration(static_cast<const ASTFunction&>(statement));
             break;
-        }
-        case ASTType::VariableModify: {
-            std::unique_ptr<ASTVariableModify> varModPtr(
-                static_cast<ASTVariableModify*>(ast.release())
-            );
-            evaluateVariableModify(std::move(varModPtr));
+        case ASTType::FunctionCall:
+            evaluateFunctionCall(static_cast<const ASTFunctionCall&>(statement));
             break;
-        }
-        case ASTType::Print: {
-            std::unique_ptr<ASTPrint> printPtr(
-                static_cast<ASTPrint*>(ast.release())
-            );
-            evaluatePrint(std::move(printPtr));
+        case ASTType::VariableDeclaration:
+            evaluateVariableDeclaration(static_cast<const ASTVariableDeclaration&>(statement));
             break;
-        }
-        case ASTType::ReadInput: {
-            std::unique_ptr<ASTReadInput> readInputPtr(
-                static_cast<ASTReadInput*>(ast.release())
-            );
-            evaluateReadInput(std::move(readInputPtr));
+        case ASTType::VariableModify:
+            evaluateVariableModify(static_cast<const ASTVariableModify&>(statement));
             break;
-        }
-        case ASTType::Condition: {
-            std::unique_ptr<ASTCondition> conditionPtr(
-                static_cast<ASTCondition*>(ast.release())
-            );
-            evaluateCondition(std::move(conditionPtr));
+        case ASTType::Print:
+            evaluatePrint(static_cast<const ASTPrint&>(statement));
             break;
-        }
-        case ASTType::While: {
-            std::unique_ptr<ASTWhile> whilePtr(
-                static_cast<ASTWhile*>(ast.release())
-            );
-            evaluateWhile(std::move(whilePtr));
+        case ASTType::ReadInput:
+            evaluateReadInput(static_cast<const ASTReadInput&>(statement));
             break;
-        }
+        case ASTType::Condition:
+            return evaluateCondition(static_cast<const ASTCondition&>(statement));
+        case ASTType::While:
+            return evaluateWhile(static_cast<const ASTWhile&>(statement));
+        case ASTType::Return:
+            return evaluateReturn(static_cast<const ASTReturn&>(statement));
+        case ASTType::Break:
+            return { Completion::Kind::Break, Value(), statement.line };
         case ASTType::Variable:
-        case ASTType::Value: {
-            evaluateExpression(std::move(ast));
+        case ASTType::Value:
+            evaluateExpression(&statement);
             break;
-        }
         default:
             throw std::runtime_error("Unknown AST type encountered during evaluation.");
     }
+    return {};
 }
 
-inline void Evaluator::evaluateProgram(std::unique_ptr<ASTProgram> program) {
-    env.enterNewBlock(); // Main program code block.
-    for (std::unique_ptr<ASTBase>& child : program->body) {
-        if (child != nullptr) evaluate(std::move(child));
+Completion Evaluator::executeBody(const std::vector<std::unique_ptr<ASTBase>>& body) {
+    for (const std::unique_ptr<ASTBase>& child : body) {
+        if (child == nullptr) continue;
+
+        Completion completion = execute(*child);
+        if (completion.kind != Completion::Kind::Normal) return completion;
     }
-    env.exitCurrentBlock();
+    return {};
 }
 
-inline void Evaluator::evaluateFunctionDeclaration(std::unique_ptr<ASTFunction> function) {
-    env.declareFunction(std::move(function));
+inline void Evaluator::evaluateProgram(const ASTProgram& program) {
+    env.enterProgram(program.frameSize); // Main program code block.
+    for (const std::unique_ptr<ASTBase>& child : program.body) {
+        if (child != nullptr) evaluate(*child);
+    }
+    env.exitFrame();
 }
 
-inline void Evaluator::evaluatePrint(std::unique_ptr<ASTPrint> print) {
-    const std::string value = evaluateExpression(std::move(print->expression));
-    std::cout << value << (print->newLine ? "\n" : "");
+inline void Evaluator::evaluateFunctionDeclaration(const ASTFunction& function) {
+    // The environment only borrows the declaration, the program tree outlives it.
+    env.declareFunction(&function);
 }
 
-inline void Evaluator::evaluateVariableDeclaration(std::unique_ptr<ASTVariableDeclaration> declaration) {
-    if (declaration->value.get() != nullptr) {
-        typeChecker.checkType(declaration->varType, declaration->value.get());
+inline void Evaluator::evaluatePrint(const ASTPrint& print) {
+    const Value value = evaluateExpression(print.expression.get());
+    std::cout << value << (print.newLine ? "\n" : "");
+}
 
-        std::unique_ptr<ASTValue> varValue = std::make_unique<ASTValue>(
-            evaluateExpression(std::move(declaration->value)),
-            declaration->varType,
-            declaration->line
+inline void Evaluator::evaluateVariableDeclaration(const ASTVariableDeclaration& declaration) {
+    if (declaration.value.get() != nullptr) {
+        env.declareVariable(
+            declaration.name,
+            declaration.slot,
+            declaration.varType,
+            evaluateExpression(declaration.value.get()),
+            declaration.line
         );
-        env.declareVariable(declaration->name, std::move(varValue));
         return;
     }
-    // nullptr is here, because it allows to declare a variable, without specifying a value. 
+    // It is allowed to declare a variable, without specifying a value.
     // The variable in that time will be `null`.
-    env.declareVariable(declaration->name, nullptr);
+    env.declareVariable(declaration.name, declaration.slot, declaration.varType, Value(), declaration.line);
 }
 
-inline void Evaluator::evaluateVariableModify(std::unique_ptr<ASTVariableModify> variableModify) {
-    ASTValue* variable = env.getVariable(variableModify->name, variableModify->line, true);
+inline void Evaluator::evaluateVariableModify(const ASTVariableModify& variableModify) {
+    // The variable may not be declared yet when the function using it is called.
+    env.getVariable(variableModify.name, variableModify.binding, variableModify.line);
 
-    typeChecker.checkType(variable->valueType, variableModify->value.get());
-    variable->value = evaluateExpression(std::move(variableModify->value));
+    Value value = evaluateExpression(variableModify.value.get());
+    // Evaluating the value can call a function, which may move the slot stack.
+    env.findVariable(variableModify.binding)->value = std::move(value);
 }
 
-std::string Evaluator::evaluateReadInput(std::unique_ptr<ASTReadInput> read) {
+Value Evaluator::evaluateReadInput(const ASTReadInput& read) {
     std::string input;
-    if (read->out != nullptr) {
-        std::cout << evaluateExpression(std::move(read->out));
+    if (read.out != nullptr) {
+        std::cout << evaluateExpression(read.out.get());
     }
     std::getline(std::cin, input);
-    return input;
+    return Value::fromString(std::move(input));
 }
 
-std::string Evaluator::evaluateFString(std::unique_ptr<ASTFString> fString) {
+Value Evaluator::evaluateFString(const ASTFString& fString) {
     std::string result;
-    size_t start = 0;
-    std::string value = fString->value;
-
-    while (start < value.size()) {
-        size_t braceOpen = value.find('{', start);
-        if (braceOpen == std::string::npos) {
-            // There is no further brackets.
-            result += value.substr(start);
-            break;
-        }
-
-        result += value.substr(start, braceOpen - start);
-        size_t braceClose = value.find('}', braceOpen);
-        if (braceClose == std::string::npos) {
-            throw ZynkError(
-                ZynkErrorType::RuntimeError,
-                "Unclosed '{' in f-string.",
-                fString->line
-            );
-        }
-        std::string expression = value.substr(braceOpen + 1, braceClose - braceOpen - 1);
-        result += evaluateExpression(expression, fString->line);
-        start = braceClose + 1;
+    result.reserve(fString.literalLength + fString.parts.size() * 8);
+    for (const std::unique_ptr<ASTBase>& part : fString.parts) {
+        evaluateExpression(part.get()).appendTo(result);
     }
-    return result;
+    return Value::fromString(std::move(result));
 }
 
-std::string Evaluator::evaluateTypeCast(std::unique_ptr<ASTTypeCast> typeCast) {
-    std::string base = evaluateExpression(std::move(typeCast->value));
+Value Evaluator::evaluateTypeCast(const ASTTypeCast& typeCast) {
+    const Value base = evaluateExpression(typeCast.value.get());
 
-    switch (typeCast->castType) {
-        case ASTValueType::Integer:
-            try {
-                return std::to_string(std::stoi(base));
-            } catch (const std::invalid_argument&) {
-                throw ZynkError(
-                    ZynkErrorType::TypeCastError, 
-                    "Invalid argument. Unable to convert the provided value to an integer.",
-                    typeCast->line
-                );
-            }
-        case ASTValueType::Float:
-            try {
-                return std::to_string(std::stof(base));
-            } catch (const std::invalid_argument&) {
-                throw ZynkError(
-                    ZynkErrorType::TypeCastError,
-                    "Invalid argument. Unable to convert the provided value to an float.",
-                    typeCast->line
-                );
-            }
-        case ASTValueType::String:
-            return base; // Expressions by default are always strings.
-        case ASTValueType::Bool: {
-            return stringToBool(base) ? "true" : "false";
-        }
-        default: {
-            // This should never happen, but whatever
-            throw ZynkError(
-                ZynkErrorType::RuntimeError, 
-                "Invalid type cast encountered.",
-                typeCast->line
-            );
-        }
+    try {
+        return castValue(base, typeCast.castType);
+    } catch (const ZynkError& err) {
+        throw ZynkError(err.base_type, err.what(), typeCast.line);
     }
 }
 
-std::string Evaluator::evaluateBinaryOperation(std::unique_ptr<ASTBinaryOperation> operation) {
-    const ASTValueType valueTypes[2] = {
-        typeChecker.determineType(operation->left.get()),
-        typeChecker.determineType(operation->right.get())
-    };
-
-    for (const ASTValueType& valueType : valueTypes) {
-        if (valueType != ASTValueType::Integer && valueType != ASTValueType::Float) {
-            throw ZynkError(
-                ZynkErrorType::ExpressionError,
-                "Cannot perform BinaryOperation on '" + typeChecker.typeToString(valueType) + "' type.",
-                operation->line
-            );
-        }
-    }
-
-    const std::string left = evaluateExpression(std::move(operation->left));
-    const std::string right = evaluateExpression(std::move(operation->right));
+Value Evaluator::evaluateBinaryOperation(const ASTBinaryOperation& operation) {
+    const Value left = evaluateExpression(operation.left.get());
+    const Value right = evaluateExpression(operation.right.get());
 
     try {
-        return calculateString(left, right, operation->op);
+        return calculateValue(left, right, operation.op);
     } catch (const ZynkError& err) {
-        throw ZynkError(err.base_type, err.what(), operation->line);
+        throw ZynkError(err.base_type, err.what(), operation.line);
     }
 }
 
-std::string Evaluator::evaluateComparisonOperation(std::unique_ptr<ASTComparisonOperation> operation) {
-    const std::string left = evaluateExpression(std::move(operation->left));
-    const std::string right = evaluateExpression(std::move(operation->right));
-    const std::string& op = operation->op;
+Value Evaluator::evaluateComparisonOperation(const ASTComparisonOperation& operation) {
+    const Value left = evaluateExpression(operation.left.get());
+    const Value right = evaluateExpression(operation.right.get());
 
-    auto compare = [&](auto a, auto b) -> std::string {
-        if (op == "==") return a == b ? "true" : "false";
-        if (op == "!=") return a != b ? "true" : "false";
-        if (op == ">") return a > b ? "true" : "false";
-        if (op == ">=") return a >= b ? "true" : "false";
-        if (op == "<") return a < b ? "true" : "false";
-        if (op == "<=") return a <= b ? "true" : "false";
-        throw ZynkError(
-            ZynkErrorType::RuntimeError,
-            "Invalid operator '" + op + "' in ComparisonOperation.",
-            operation->line
-        );
-    };
-
-    try {
-        return compare(std::stof(left), std::stof(right));
-    } catch (const std::invalid_argument&) {
-        return compare(left, right);
-    }
+    return compareValue(left, right, operation.op);
 }
 
-std::unique_ptr<ASTBase> Evaluator::evaluateCondition(std::unique_ptr<ASTCondition> condition) {
-    const bool status = stringToBool(evaluateExpression(std::move(condition->expression)));
-    auto& body = status ? condition->body : condition->elseBody;
-    
-    env.enterNewBlock();
-    for (std::unique_ptr<ASTBase>& child : body) {
-
-        if (child->type == ASTType::Return) {
-            ASTValueType resultType = typeChecker.determineType(child.get());
-            const size_t childLine = child->line;
-            std::string result = evaluateExpression(std::move(child));
-            env.exitCurrentBlock();
-            return std::make_unique<ASTValue>(result, resultType, childLine);
-        }
+Completion Evaluator::evaluateCondition(const ASTCondition& condition) {
+    const bool status = evaluateExpression(condition.expression.get()).isTruthy();
 
-        if (child->type == ASTType::Break) {
-            env.exitCurrentBlock();
-            return std::make_unique<ASTBreak>(child->line);
-        }
-
-        if (child->type == ASTType::Condition) {
-            std::unique_ptr<ASTCondition> conditionPtr(
-                static_cast<ASTCondition*>(child.release())
-            );
-            auto result = evaluateCondition(std::move(conditionPtr));
-            if (result != nullptr) {
-                env.exitCurrentBlock();
-                return result;
-            }
-        }
-        else evaluate(std::move(child));
-    }
+    env.enterNewBlock();
+    Completion completion = executeBody(status ? condition.body : condition.elseBody);
     env.exitCurrentBlock();
-    return nullptr;
+    return completion;
 }
 
-std::unique_ptr<ASTBase> Evaluator::evaluateWhile(std::unique_ptr<ASTWhile> loop) {
+Completion Evaluator::evaluateWhile(const ASTWhile& loop) {
     env.enterNewBlock();
-    bool shouldContinue = true;
-
-    while (stringToBool(evaluateExpression(loop->value->clone())) && shouldContinue) {
-
-        for (std::unique_ptr<ASTBase>& child : loop->body) {
-            if (child == nullptr) continue;
 
-            if (child->type == ASTType::Break) {
-                shouldContinue = false;
-                break;
-            }
-
-            if (child->type == ASTType::Return) {
-                ASTValueType resultType = typeChecker.determineType(child.get());
-                std::string result = evaluateExpression(child->clone());
-                env.exitCurrentBlock();
-                return std::make_unique<ASTValue>(result, resultType, child->line);
-            }
+    // The tracer records iterations of the generic loop only.
+    Completion counted;
+    const auto run = [this, &loop](size_t i) {
+        return loop.body[i] != nullptr ? execute(*loop.body[i]) : Completion();
+    };
+    if (loop.counted.has_value() && tracer == nullptr
+        && runCountedLoop(env, *loop.counted, loop.body.size(), counted, run)) {
+        env.exitCurrentBlock();
+        return counted;
+    }
 
-            if (child->type == ASTType::Condition) {
-                std::unique_ptr<ASTCondition> conditionPtr(
-                    static_cast<ASTCondition*>(child->clone().release())
-                );
-                auto maybeResult = evaluateCondition(std::move(conditionPtr));
-                if (maybeResult == nullptr) continue;
+    while (evaluateExpression(loop.value.get()).isTruthy()) {
+        if (tracer != nullptr) {
+            const Tracer::Result result = tracer->run(loop, env);
+            if (result == Tracer::Result::LoopEnded) break;
+            if (result == Tracer::Result::CheckCondition) continue;
+        }
+        Completion completion = executeBody(loop.body);
 
-                if (maybeResult->type == ASTType::Break) {
-                    shouldContinue = false;
-                    break;
-                }
-                if (maybeResult->type == ASTType::Value) {
-                    env.exitCurrentBlock();
-                    return maybeResult;
-                }
-            }
-            evaluate(child->clone());
+        if (completion.kind == Completion::Kind::Break) break;
+        if (completion.kind == Completion::Kind::Return) {
+            env.exitCurrentBlock();
+            return completion;
         }
     }
     env.exitCurrentBlock();
-    return nullptr;
+    return {};
 }
 
-std::string Evaluator::evaluateFunctionCall(std::unique_ptr<ASTFunctionCall> functionCall) {
-    ASTFunction* func = env.getFunction(functionCall->name, functionCall->line);
+Completion Evaluator::evaluateReturn(const ASTReturn& returnStatement) {
+    return { Completion::Kind::Return, evaluateExpression(&returnStatement), returnStatement.line };
+}
 
-    if (func->arguments.size() != functionCall->arguments.size()) {
-        throw ZynkError(
-            ZynkErrorType::RuntimeError,
-            "Invalid number of arguments for function '" + functionCall->name + "'.",
-            functionCall->line
-        );
-    }
+Value Evaluator::evaluateFunctionCall(const ASTFunctionCall& functionCall) {
+    // The type checker resolved the call, so only the declaration has to be in scope.
+    const ASTFunction* func = functionCall.function;
+    const size_t scope = env.getFunctionScope(*func, functionCall.depth, functionCall.line);
 
     if (env.isRecursionDepthExceeded()) {
         throw ZynkError(
             ZynkErrorType::RecursionError,
             "Exceeded maximum recursion depth of " + std::to_string(env.MAX_DEPTH) + ".",
-            functionCall->line
+            functionCall.line
         );
     }
 
-    std::unordered_map<std::string, std::unique_ptr<ASTValue>> functionArgs;
-
-    for (size_t i = 0; i < func->arguments.size(); ++i) {
-        std::unique_ptr<ASTBase> funcCallArg = std::move(functionCall->arguments[i]);
-        auto funcArg = static_cast<ASTFunctionArgument*>(func->arguments[i].get());
-
-        typeChecker.checkType(funcArg->valueType, funcCallArg.get());
-
-        functionArgs.insert({
-                funcArg->name,
-                std::make_unique<ASTValue>(
-                    evaluateExpression(std::move(funcCallArg)),
-                    funcArg->valueType,
-                    funcArg->line)
-            }
-        );
+    // Arguments are evaluated in the frame of the caller, nested calls push theirs above them.
+    const size_t firstArgument = arguments.size();
+    for (const std::unique_ptr<ASTBase>& funcCallArg : functionCall.arguments) {
+        arguments.push_back(evaluateExpression(funcCallArg.get()));
     }
 
-    env.enterNewBlock(true);
-    for (auto& argPair : functionArgs) {
-        env.declareVariable(argPair.first, std::move(argPair.second));
+    if (jit != nullptr) {
+        Value result;
+        if (jit->call(*func, functionCall.depth, arguments.data() + firstArgument, env, result)) {
+            arguments.resize(firstArgument);
+            return result;
+        }
     }
-    std::string result = "null";
 
-    for (std::unique_ptr<ASTBase>& child : func->body) {
-        if (child == nullptr) continue;
-
-        switch (child->type) {
-            case ASTType::Return: {
-                typeChecker.checkType(func, child.get());
-                result = evaluateExpression(child->clone());
-                env.exitCurrentBlock(true);
-                return result;
-            }
-
-            case ASTType::Condition: {
-                std::unique_ptr<ASTCondition> conditionPtr(
-                    static_cast<ASTCondition*>(child->clone().release())
-                );
-                auto maybeResult = evaluateCondition(std::move(conditionPtr));
-
-                if (maybeResult != nullptr && maybeResult->type == ASTType::Value) {
-                    typeChecker.checkType(func, maybeResult.get());
-                    result = static_cast<ASTValue*>(maybeResult.get())->value;
-                    env.exitCurrentBlock(true);
-                    return result;
-                }
-                break;
-            }
+    env.enterFunction(*func, scope);
+    for (size_t i = 0; i < func->arguments.size(); ++i) {
+        auto funcArg = static_cast<const ASTFunctionArgument*>(func->arguments[i].get());
+        env.bindArgument(funcArg->slot, funcArg->valueType, std::move(arguments[firstArgument + i]));
+    }
+    arguments.resize(firstArgument);
+    // The function body runs directly in the block of the call.
+    Completion completion = executeBody(func->body);
+    env.exitFrame();
 
-            case ASTType::While: {
-                std::unique_ptr<ASTWhile> whilePtr(
-                    static_cast<ASTWhile*>(child->clone().release())
-                );
-                auto maybeResult = evaluateWhile(std::move(whilePtr));
-
-                if (maybeResult != nullptr && maybeResult->type == ASTType::Value) {
-                    typeChecker.checkType(func, maybeResult.get());
-                    result = static_cast<ASTValue*>(maybeResult.get())->value;
-                    env.exitCurrentBlock(true);
-                    return result;
-                }
-                break;
-            }
-            default:
-                evaluate(child->clone());
-                break;
-        }
+    if (completion.kind == Completion::Kind::Break) {
+        throw ZynkError(ZynkErrorType::SyntaxError, "'break' outside of a loop.", completion.line);
+    }
+    if (completion.kind == Completion::Kind::Return) {
+        return std::move(completion.value);
     }
-    env.exitCurrentBlock(true);
 
-    if (result == "null" && func->returnType != ASTValueType::None) {
+    if (func->returnType != ASTValueType::None) {
         throw ZynkError(
             ZynkErrorType::TypeError,
-            "Function '" + functionCall->name + "' does not return a value of type " 
-            + typeChecker.typeToString(func->returnType) + " in all control paths.",
+            "Function '" + functionCall.name + "' does not return a value of type " 
+            + TypeChecker::typeToString(func->returnType) + " in all control paths.",
             func->line
         );
     }
-    return result;
-}
-
-std::string Evaluator::evaluateOrOperation(std::unique_ptr<ASTOrOperation> operation) {
-    const std::string left = evaluateExpression(std::move(operation->left));
-    if (stringToBool(left)) return left;
-    return evaluateExpression(std::move(operation->right));
+    return Value();
 }
 
-std::string Evaluator::evaluateAndOperation(std::unique_ptr<ASTAndOperation> operation) {
-    const std::string left = evaluateExpression(std::move(operation->left));
-    if (!stringToBool(left)) return left;
-    return evaluateExpression(std::move(operation->right));
+Value Evaluator::evaluateOrOperation(const ASTOrOperation& operation) {
+    Value left = evaluateExpression(operation.left.get());
+    if (left.isTruthy()) return left;
+    return evaluateExpression(operation.right.get());
 }
 
-std::string Evaluator::evaluateExpression(const std::string& expression, size_t realLine) {
-    Lexer lexer(expression);
-    const std::vector<Token> tokens = lexer.tokenize();
-
-    Parser parser(tokens);
-    std::unique_ptr<ASTBase> astExpression = parser.parseExpression(0);
-
-    // We set the line number manually here, because the parser doesn't know where
-    // this expression came from. Without this, line in error message would be wrong.
-    astExpression.get()->line = realLine;
-    return evaluateExpression(std::move(astExpression));
+Value Evaluator::evaluateAndOperation(const ASTAndOperation& operation) {
+    Value left = evaluateExpression(operation.left.get());
+    if (!left.isTruthy()) return left;
+    return evaluateExpression(operation.right.get());
 }
 
-std::string Evaluator::evaluateExpression(std::unique_ptr<ASTBase> expression) {
-    if (expression == nullptr) return "null";
+Value Evaluator::evaluateExpression(const ASTBase* expression) {
+    if (expression == nullptr) return Value();
 
     switch (expression->type) {
         case ASTType::Value:
-            return static_cast<ASTValue*>(expression.get())->value;
+            return static_cast<const ASTValue*>(expression)->constant;
         case ASTType::Variable: {
-            const auto var = static_cast<ASTVariable*>(expression.get());
-            return env.getVariable(var->name, var->line, true)->value;
+            const auto var = static_cast<const ASTVariable*>(expression);
+            return env.getVariable(var->name, var->binding, var->line)->value;
         };
-        case ASTType::ReadInput: {
-            std::unique_ptr<ASTReadInput> readPtr(
-                static_cast<ASTReadInput*>(expression.release())
-            );
-            return evaluateReadInput(std::move(readPtr));
-        }
-        case ASTType::TypeCast: {
-            std::unique_ptr<ASTTypeCast> castPtr(
-                static_cast<ASTTypeCast*>(expression.release())
-            );
-            return evaluateTypeCast(std::move(castPtr));
-        }
-        case ASTType::FString: {
-            std::unique_ptr<ASTFString> fStringPtr(
-                static_cast<ASTFString*>(expression.release())
-            );
-            return evaluateFString(std::move(fStringPtr));
-        }
-        case ASTType::BinaryOperation: {
-            std::unique_ptr<ASTBinaryOperation> binaryOpPtr(
-                static_cast<ASTBinaryOperation*>(expression.release())
-            );
-            return evaluateBinaryOperation(std::move(binaryOpPtr));
-        }
-        case ASTType::ComparisonOperation: {
-            std::unique_ptr<ASTComparisonOperation> compOpPtr(
-                static_cast<ASTComparisonOperation*>(expression.release())
-            );
-            return evaluateComparisonOperation(std::move(compOpPtr));
-        }
-        case ASTType::OrOperation: {
-            std::unique_ptr<ASTOrOperation> orOpPtr(
-                static_cast<ASTOrOperation*>(expression.release())
-            );
-            return evaluateOrOperation(std::move(orOpPtr));
-        }
-        case ASTType::AndOperation: {
-            std::unique_ptr<ASTAndOperation> andOpPtr(
-                static_cast<ASTAndOperation*>(expression.release())
-            );
-            return evaluateAndOperation(std::move(andOpPtr));
-        }
-        case ASTType::FunctionCall: {
-            std::unique_ptr<ASTFunctionCall> funcCallPtr(
-                static_cast<ASTFunctionCall*>(expression.release())
-            );
-            return evaluateFunctionCall(std::move(funcCallPtr));
-        }
-        case ASTType::Return: {
-            std::unique_ptr<ASTReturn> returnPtr(
-                static_cast<ASTReturn*>(expression.release())
-            );
-            return evaluateExpression(std::move(returnPtr->value));
-        }
+        case ASTType::ReadInput:
+            return evaluateReadInput(*static_cast<const ASTReadInput*>(expression));
+        case ASTType::TypeCast:
+            return evaluateTypeCast(*static_cast<const ASTTypeCast*>(expression));
+        case ASTType::FString:
+            return evaluateFString(*static_cast<const ASTFString*>(expression));
+        case ASTType::BinaryOperation:
+            return evaluateBinaryOperation(*static_cast<const ASTBinaryOperation*>(expression));
+        case ASTType::ComparisonOperation:
+            return evaluateComparisonOperation(*static_cast<const ASTComparisonOperation*>(expression));
+        case ASTType::OrOperation:
+            return evaluateOrOperation(*static_cast<const ASTOrOperation*>(expression));
+        case ASTType::AndOperation:
+            return evaluateAndOperation(*static_cast<const ASTAndOperation*>(expression));
+        case ASTType::FunctionCall:
+            return evaluateFunctionCall(*static_cast<const ASTFunctionCall*>(expression));
+        case ASTType::Return:
+            return evaluateExpression(static_cast<const ASTReturn*>(expression)->value.get());
         default:
             throw ZynkError(
                 ZynkErrorType::RuntimeError,
@@ -534,35 +310,193 @@ std::string Evaluator::evaluateExpression(std::unique_ptr<ASTBase> expression) {
     }
 }
 
-std::string calculate(const float left, const float right, const std::string& op) {
-    if (op == "*") return std::to_string(left * right);
-    if (op == "-") return std::to_string(left - right);
-    if (op == "+") return std::to_string(left + right);
-    if (op == "/") {
-        if (right == 0) throw ZynkError(ZynkErrorType::RuntimeError, "Division by zero." );
-        return std::to_string(left / right);
-    }
-    throw ZynkError(ZynkErrorType::RuntimeError, "Invalid operator: " + op + ".");
+// Checked int64 arithmetic, every engine goes through calculateInteger. Each stores the
+// wrapped result and returns whether it overflowed.
+#ifdef _MSC_VER
+// MSVC has no overflow builtins. Unsigned arithmetic wraps around without undefined behaviour.
+static bool addOverflows(const int64_t left, const int64_t right, int64_t* result) {
+    *result = static_cast<int64_t>(static_cast<uint64_t>(left) + static_cast<uint64_t>(right));
+    // Overflow flips the sign of the result away from the signs of both operands.
+    return ((left ^ *result) & (right ^ *result)) < 0;
+}
+
+static bool subtractOverflows(const int64_t left, const int64_t right, int64_t* result) {
+    *result = static_cast<int64_t>(static_cast<uint64_t>(left) - static_cast<uint64_t>(right));
+    return ((left ^ right) & (left ^ *result)) < 0;
+}
+
+static bool multiplyOverflows(const int64_t left, const int64_t right, int64_t* result) {
+    *result = static_cast<int64_t>(static_cast<uint64_t>(left) * static_cast<uint64_t>(right));
+    if (left == 0 || right == 0) return false;
+    // INT64_MIN * -1 is the one case where dividing back would itself overflow.
+    if ((left == -1 && right == INT64_MIN) || (right == -1 && left == INT64_MIN)) return true;
+    return *result / right != left;
+}
+#else
+static bool addOverflows(const int64_t left, const int64_t right, int64_t* result) {
+    return __builtin_add_overflow(left, right, result);
 }
 
-std::string calculateString(const std::string& left_value, const std::string& right_value, const std::string& op) {
-    // todo: refactor this crap
-    const bool leftIsFloat = left_value.find('.') != std::string::npos;
-    const bool rightIsFloat = right_value.find('.') != std::string::npos;
+static bool subtractOverflows(const int64_t left, const int64_t right, int64_t* result) {
+    return __builtin_sub_overflow(left, right, result);
+}
 
-    const float left = std::stof(left_value);
-    const float right = std::stof(right_value);
-    std::string result = calculate(left, right, op);
+static bool multiplyOverflows(const int64_t left, const int64_t right, int64_t* result) {
+    return __builtin_mul_overflow(left, right, result);
+}
+#endif
 
-    if (leftIsFloat || rightIsFloat) return result;
+int64_t calculateInteger(const int64_t left, const int64_t right, const ASTBinaryOperator op) {
+    int64_t result = 0;
+    bool overflow = false;
 
-    size_t dotPosition = result.find('.');
-    if (dotPosition != std::string::npos) {
-        result = result.substr(0, dotPosition);
+    switch (op) {
+        case ASTBinaryOperator::Add:
+            overflow = addOverflows(left, right, &result);
+            break;
+        case ASTBinaryOperator::Subtract:
+            overflow = subtractOverflows(left, right, &result);
+            break;
+        case ASTBinaryOperator::Multiply:
+            overflow = multiplyOverflows(left, right, &result);
+            break;
+        case ASTBinaryOperator::Divide:
+            if (right == 0) throw ZynkError(ZynkErrorType::RuntimeError, "Division by zero.");
+            // The only quotient that doesn't fit, INT64_MIN / -1.
+            overflow = left == INT64_MIN && right == -1;
+            if (!overflow) result = left / right; // Truncated towards zero.
+            break;
+    }
+
+    if (overflow) {
+        throw ZynkError(
+            ZynkErrorType::RuntimeError,
+            std::string("Integer overflow in '") + operatorToString(op) + "' operation."
+        );
     }
     return result;
 }
 
-inline bool stringToBool(const std::string& value) {
-    return value != "0" && !value.empty() && value != "null" && value != "false";
-}
\ No newline at end of file
+double calculateFloat(const double left, const double right, const ASTBinaryOperator op) {
+    switch (op) {
+        case ASTBinaryOperator::Add:
+            return left + right;
+        case ASTBinaryOperator::Subtract:
+            return left - right;
+        case ASTBinaryOperator::Multiply:
+            return left * right;
+        case ASTBinaryOperator::Divide:
+            if (right == 0) throw ZynkError(ZynkErrorType::RuntimeError, "Division by zero.");
+            return left / right;
+    }
+    return 0;
+}
+
+Value calculateValue(const Value& left, const Value& right, const ASTBinaryOperator op) {
+    if (left.type() == ASTValueType::Integer && right.type() == ASTValueType::Integer) {
+        return Value::fromInt(calculateInteger(left.asInt(), right.asInt(), op));
+    }
+    // Types are checked ahead of time, but a variable declared without a value still holds null.
+    for (const ASTValueType valueType : { left.type(), right.type() }) {
+        if (valueType != ASTValueType::Integer && valueType != ASTValueType::Float) {
+            throw ZynkError(
+                ZynkErrorType::ExpressionError,
+                "Cannot perform BinaryOperation on '" + TypeChecker::typeToString(valueType) + "' type."
+            );
+        }
+    }
+    return Value::fromFloat(calculateFloat(left.toNumber(), right.toNumber(), op));
+}
+
+template <typename T>
+static Value compareOrdered(const T& left, const T& right, const ASTComparisonOperator op) {
+    switch (op) {
+        case ASTComparisonOperator::Equal:
+            return Value::fromBool(left == right);
+        case ASTComparisonOperator::NotEqual:
+            return Value::fromBool(left != right);
+        case ASTComparisonOperator::Greater:
+            return Value::fromBool(left > right);
+        case ASTComparisonOperator::GreaterOrEqual:
+            return Value::fromBool(left >= right);
+        case ASTComparisonOperator::Less:
+            return Value::fromBool(left < right);
+        case ASTComparisonOperator::LessOrEqual:
+            return Value::fromBool(left <= right);
+    }
+    return Value::fromBool(false);
+}
+
+bool compareIntegers(const int64_t left, const int64_t right, const ASTComparisonOperator op) {
+    switch (op) {
+        case ASTComparisonOperator::Equal: return left == right;
+        case ASTComparisonOperator::NotEqual: return left != right;
+        case ASTComparisonOperator::Greater: return left > right;
+        case ASTComparisonOperator::GreaterOrEqual: return left >= right;
+        case ASTComparisonOperator::Less: return left < right;
+        case ASTComparisonOperator::LessOrEqual: return left <= right;
+    }
+    return false;
+}
+
+Value compareValue(const Value& left, const Value& right, const ASTComparisonOperator op) {
+    const ASTValueType leftType = left.type();
+    const ASTValueType rightType = right.type();
+
+    if (leftType == ASTValueType::Integer && rightType == ASTValueType::Integer) {
+        return compareOrdered(left.asInt(), right.asInt(), op);
+    }
+    if (left.isNumber() && right.isNumber()) {
+        return compareOrdered(left.toNumber(), right.toNumber(), op);
+    }
+    if (leftType == ASTValueType::String && rightType == ASTValueType::String) {
+        return compareOrdered(left.asString(), right.asString(), op);
+    }
+    if (leftType == ASTValueType::Bool && rightType == ASTValueType::Bool) {
+        return compareOrdered(left.asBool(), right.asBool(), op);
+    }
+
+    // Values of different types are compared by their text, numerically if both read as numbers.
+    const std::string leftText = left.toString();
+    const std::string rightText = right.toString();
+    double leftNumber, rightNumber;
+    if (parseFloat(leftText, leftNumber) && parseFloat(rightText, rightNumber)) {
+        return compareOrdered(leftNumber, rightNumber, op);
+    }
+    return compareOrdered(leftText, rightText, op);
+}
+
+Value castValue(const Value& value, const ASTValueType type) {
+    switch (type) {
+        case ASTValueType::Integer:
+            if (value.type() == ASTValueType::Integer) return value;
+            if (value.type() == ASTValueType::Float) {
+                // Converting NaN, infinities or anything else outside of the int64 range is undefined.
+                const double number = value.asFloat();
+                if (number >= -9.2233720368547758e18 && number < 9.2233720368547758e18) {
+                    return Value::fromInt(static_cast<int64_t>(number));
+                }
+            } else if (int64_t result; parseInteger(value.toString(), result)) {
+                return Value::fromInt(result);
+            }
+            throw ZynkError(
+                ZynkErrorType::TypeCastError,
+                "Invalid argument. Unable to convert the provided value to an integer."
+            );
+        case ASTValueType::Float:
+            if (value.isNumber()) return Value::fromFloat(value.toNumber());
+            if (double result; parseFloat(value.toString(), result)) return Value::fromFloat(result);
+            throw ZynkError(
+                ZynkErrorType::TypeCastError,
+                "Invalid argument. Unable to convert the provided value to an float."
+            );
+        case ASTValueType::String:
+            if (value.type() == ASTValueType::String) return value;
+            return Value::fromString(value.toString());
+        case ASTValueType::Bool:
+            return Value::fromBool(value.isTruthy());
+        default:
+            // This should never happen, but whatever
+            throw ZynkError(ZynkErrorType::RuntimeError, "Invalid type cast encountered.");
+    }
+}
@@ -6,39 +6,103 @@
 #include "../../parsing/include/parser.hpp"
 #include "../typechecker/include/checker.hpp"
 #include "runtime.hpp"
+#include "../jit/include/jit.hpp"
+#include "../jit/include/tracer.hpp"
+#include "../../errors/include/errors.hpp"
+#include <memory>
+
+// Outcome of executing a statement. Return and break unwind through the
+// enclosing statements as a plain value, so nothing is allocated for them.
+struct Completion {
+    enum class Kind : uint8_t { Normal, Break, Return };
+
+    Kind kind = Kind::Normal;
+    Value value; // Returned value.
+    size_t line = 0;
+};
 
 class Evaluator {
 public:
-    Evaluator();
+    explicit Evaluator(bool useJit = false);
 
     RuntimeEnvironment env;
-    void evaluate(std::unique_ptr<ASTBase> ast);
+    // Executes the given tree, which must have been resolved and type checked. The tree is never modified and must outlive the evaluation.
+    void evaluate(const ASTBase& ast);
 private:
-    TypeChecker typeChecker;
-
-    std::string evaluateExpression(std::unique_ptr<ASTBase> expression);
-    std::string evaluateExpression(const std::string& expression, size_t line);
-    std::string evaluateReadInput(std::unique_ptr<ASTReadInput> read);
-    std::string evaluateTypeCast(std::unique_ptr<ASTTypeCast> typeCast);
-    std::string evaluateFString(std::unique_ptr<ASTFString> fString);
-    std::string evaluateBinaryOperation(std::unique_ptr<ASTBinaryOperation> operation);
-    std::string evaluateComparisonOperation(std::unique_ptr<ASTComparisonOperation> operation);
-    std::string evaluateAndOperation(std::unique_ptr<ASTAndOperation> operation);
-    std::string evaluateOrOperation(std::unique_ptr<ASTOrOperation> operation);
-    std::string evaluateFunctionCall(std::unique_ptr<ASTFunctionCall> functionCall);
-
-    std::unique_ptr<ASTBase> evaluateCondition(std::unique_ptr<ASTCondition> condition);
-    std::unique_ptr<ASTBase> evaluateWhile(std::unique_ptr<ASTWhile> loop);
-
-    inline void evaluateVariableDeclaration(std::unique_ptr<ASTVariableDeclaration> variable);
-    inline void evaluateVariableModify(std::unique_ptr<ASTVariableModify> variableModify);
-    inline void evaluateProgram(std::unique_ptr<ASTProgram> program);
-    inline void evaluateFunctionDeclaration(std::unique_ptr<ASTFunction> function);
-    inline void evaluatePrint(std::unique_ptr<ASTPrint> print);
+    // Evaluated arguments of the calls in progress, the storage is reused by every call.
+    std::vector<Value> arguments;
+    std::unique_ptr<Jit> jit; // Null unless enabled.
+    std::unique_ptr<Tracer> tracer; // Null unless the JIT is enabled.
+
+    Value evaluateExpression(const ASTBase* expression);
+    Value evaluateReadInput(const ASTReadInput& read);
+    Value evaluateTypeCast(const ASTTypeCast& typeCast);
+    Value evaluateFString(const ASTFString& fString);
+    Value evaluateBinaryOperation(const ASTBinaryOperation& operation);
+    Value evaluateComparisonOperation(const ASTComparisonOperation& operation);
+    Value evaluateAndOperation(const ASTAndOperation& operation);
+    Value evaluateOrOperation(const ASTOrOperation& operation);
+    Value evaluateFunctionCall(const ASTFunctionCall& functionCall);
+
+    Completion execute(const ASTBase& statement);
+    Completion executeBody(const std::vector<std::unique_ptr<ASTBase>>& body);
+    Completion evaluateCondition(const ASTCondition& condition);
+    Completion evaluateWhile(const ASTWhile& loop);
+    Completion evaluateReturn(const ASTReturn& returnStatement);
+
+    inline void evaluateVariableDeclaration(const ASTVariableDeclaration& variable);
+    inline void evaluateVariableModify(const ASTVariableModify& variableModify);
+    inline void evaluateProgram(const ASTProgram& program);
+    inline void evaluateFunctionDeclaration(const ASTFunction& function);
+    inline void evaluatePrint(const ASTPrint& print);
 };
 
-inline bool stringToBool(const std::string& value);
-std::string calculate(const float left, const float right, const std::string& op);
-std::string calculateString(const std::string& left_value, const std::string& right_value, const std::string& op);
+int64_t calculateInteger(const int64_t left, const int64_t right, const ASTBinaryOperator op);
+double calculateFloat(const double left, const double right, const ASTBinaryOperator op);
+Value calculateValue(const Value& left, const Value& right, const ASTBinaryOperator op);
+Value compareValue(const Value& left, const Value& right, const ASTComparisonOperator op);
+bool compareIntegers(const int64_t left, const int64_t right, const ASTComparisonOperator op);
+Value castValue(const Value& value, const ASTValueType type);
+
+// Runs a counted loop with its counter in a native integer, for the engines walking the tree.
+// The body has `statements` statements, the last one stepping the counter, and run(i) executes
+// the i-th one. Returns false, before running anything, if the counter or the bound doesn't hold an int.
+template <typename Run>
+bool runCountedLoop(RuntimeEnvironment& env, const ASTCountedLoop& counted, size_t statements, Completion& completion, Run&& run) {
+    const Variable* counter = env.findVariable(counted.counter);
+    const Value* bound = counted.bound->type == ASTType::Value
+        ? &static_cast<const ASTValue*>(counted.bound)->constant
+        : nullptr;
+    if (bound == nullptr) {
+        const Variable* variable = env.findVariable(static_cast<const ASTVariable*>(counted.bound)->binding);
+        if (variable != nullptr) bound = &variable->value;
+    }
+    if (counter == nullptr || bound == nullptr) return false;
+    if (counter->value.type() != ASTValueType::Integer || bound->type() != ASTValueType::Integer) return false;
+
+    int64_t value = counter->value.asInt();
+    const int64_t limit = bound->asInt();
+    const size_t last = statements - 1; // The statement stepping the counter.
+
+    while (compareIntegers(value, limit, counted.comparison)) {
+        for (size_t i = 0; i < last; i++) {
+            completion = run(i);
+            if (completion.kind == Completion::Kind::Break) {
+                completion = {};
+                return true;
+            }
+            if (completion.kind == Completion::Kind::Return) return true;
+        }
+
+        try {
+            value = calculateInteger(value, counted.amount, counted.step);
+        } catch (const ZynkError& err) {
+            throw ZynkError(err.base_type, err.what(), counted.line);
+        }
+        // The body only reads the counter, but calls in it may have moved the slot stack.
+        env.findVariable(counted.counter)->value = Value::fromInt(value);
+    }
+    return true;
+}
 
 #endif // EVALUATOR_H
\ No newline at end of file
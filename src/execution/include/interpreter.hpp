@@ -1,12 +1,40 @@
 #ifndef INTERPRETER_H
 #define INTERPRETER_H
 
+#include "../optimizer/include/optimizer.hpp"
+#include <memory>
 #include <string>
 
+enum class ExecutionEngine {
+    TreeWalker,
+    VM,
+    Closure,
+};
+
 class ZynkInterpreter {
 public:
+    ZynkInterpreter(
+        ExecutionEngine engine = ExecutionEngine::TreeWalker,
+        bool jit = false,
+        bool diagnostics = false,
+        size_t inlineBudget = DEFAULT_INLINE_BUDGET
+    );
+
     void interpret(const std::string& source);
     void interpretFile(const std::string& file_path);
+    // Compiles the script to a native executable through C++, with the compiler Zynk was built with.
+    void buildFile(const std::string& filePath, const std::string& outputPath);
+    // Returns the script as it is run after optimization, headed by what the optimizer changed.
+    std::string dumpOptimized(const std::string& filePath);
+private:
+    const ExecutionEngine engine;
+    const bool jit; // Compiles hot functions to machine code, see Jit.
+    const bool diagnostics; // Reports what the optimizer changed on stderr before running.
+    const size_t inlineBudget; // Largest function body the optimizer inlines, see Optimizer.
+
+    // Parses, resolves, type checks and optimizes the program.
+    static std::unique_ptr<ASTProgram> analyze(const std::string& source, Optimizer& optimizer);
+    static std::string readFile(const std::string& filePath);
 };
 
-#endif // INTERPRETER_H
\ No newline at end of file
+#endif // INTERPRETER_H
@@ -2,30 +2,68 @@
 #define RUNTIME_H
 
 #include "../block/include/block.hpp"
-#include <memory>
-#include <stack>
+#include <vector>
 
 class RuntimeEnvironment {
 public:
     const size_t MAX_DEPTH = 1000;
 
+    RuntimeEnvironment();
+
     bool isRecursionDepthExceeded() const;
+    // Open frames, the one of the main program code included.
+    size_t frameCount() const;
 
-    void declareVariable(const std::string& name, std::unique_ptr<ASTValue> value) const;
-    ASTValue* getVariable(const std::string& name, const size_t line, bool deepSearch = true) const;
-    bool isVariableDeclared(const std::string& name, bool deepSearch = true) const;
+    void declareVariable(const std::string& name, size_t slot, ASTValueType type, Value value, const size_t line);
+    // Declares an argument in the frame of the function just entered. Argument slots
+    // are always free there, so nothing is checked.
+    void bindArgument(size_t slot, ASTValueType type, Value value);
+    // The pointer is invalidated once a new frame is entered.
+    Variable* getVariable(const std::string& name, const ASTBinding& binding, const size_t line);
+    // Like getVariable, but returns nullptr instead of throwing if the variable isn't declared.
+    Variable* findVariable(const ASTBinding& binding);
 
-    void declareFunction(std::unique_ptr<ASTFunction> func) const;
-    ASTFunction* getFunction(const std::string& name, const size_t line) const;
+    void declareFunction(const ASTFunction* func);
+    const ASTFunction* getFunction(const std::string& name, const size_t line) const;
+    // Like getFunction, but returns nullptr instead of throwing if the function isn't declared.
+    const ASTFunction* findFunction(const std::string& name) const;
     bool isFunctionDeclared(const std::string& name) const;
+    // Block the function is declared in, if it is declared in the frame `depth` function
+    // scopes up from the current one. Looked up by the id of the function, not its name.
+    size_t getFunctionScope(const ASTFunction& function, size_t depth, const size_t line) const;
+    // Like getFunctionScope, but returns Block::None instead of throwing if the function isn't declared.
+    size_t findFunctionScope(const ASTFunction& function, size_t depth) const;
+
+    const Block* currentBlock() const;
+    void enterNewBlock();
+    void exitCurrentBlock();
 
-    Block* currentBlock() const;
-    void enterNewBlock(bool increaseDepth = false);
-    void exitCurrentBlock(bool decreaseDepth = false);
+    // Opens the frame of the main program code.
+    void enterProgram(size_t frameSize);
+    // Opens the frame of a function call, nested in the block the function was declared in.
+    void enterFunction(const ASTFunction& function);
+    void enterFunction(const ASTFunction& function, size_t scope);
+    void exitFrame();
 
 private:
-    std::stack<std::unique_ptr<Block>> blockStack;
-    size_t currentDepth = 0;
+    // Every stack is reserved up front and only grows past that, entering and
+    // exiting frames and blocks reuses the storage left by the previous ones.
+    std::vector<Variable> slots;
+    std::vector<Frame> frames;
+    std::vector<Block> blocks;
+    struct DeclaredFunction {
+        const ASTFunction* function; // Owned by the program tree.
+        size_t shadowedScope; // Scope of the previous declaration of the same function, on recursion.
+    };
+
+    std::vector<DeclaredFunction> functions;
+    // Block the latest declaration of each function is in, indexed by function id.
+    std::vector<size_t> functionScopes;
+
+    void enterFrame(size_t frameSize, size_t scope);
+    void releaseFunctions(size_t firstFunction);
+    // Returns the index of the function in the function stack, and the block it was declared in.
+    size_t lookupFunction(const std::string& name, size_t& scope) const;
 };
 
 #endif // RUNTIME_H
@@ -4,13 +4,28 @@
 #include "../parsing/include/lexer.hpp"
 #include "../parsing/include/parser.hpp"
 #include "../parsing/include/ast.hpp"
+#include "../parsing/include/resolver.hpp"
+#include "../parsing/include/printer.hpp"
 #include "../execution/include/evaluator.hpp"
+#include "../execution/typechecker/include/checker.hpp"
 #include "../execution/include/runtime.hpp"
+#include "../execution/vm/include/compiler.hpp"
+#include "../execution/vm/include/vm.hpp"
+#include "../execution/closure/include/closure.hpp"
+#include "../execution/aot/include/generator.hpp"
+#include "../execution/optimizer/include/optimizer.hpp"
 
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
 #include <fstream>
+#include <iostream>
 #include <sstream>
 
-void ZynkInterpreter::interpret(const std::string& source) {
+ZynkInterpreter::ZynkInterpreter(ExecutionEngine engine, bool jit, bool diagnostics, size_t inlineBudget)
+    : engine(engine), jit(jit), diagnostics(diagnostics), inlineBudget(inlineBudget) {};
+
+std::unique_ptr<ASTProgram> ZynkInterpreter::analyze(const std::string& source, Optimizer& optimizer) {
     // Processing the raw source into tokens.
     Lexer lexer(source);
     const std::vector<Token> tokens = lexer.tokenize();
@@ -18,18 +33,144 @@ void ZynkInterpreter::interpret(const std::string& source) {
     // Parsing the tokens into AST objects.
     Parser parser(tokens);
     std::unique_ptr<ASTProgram> program = parser.parse();
-    
+
+    // Binding variables to their frame slots.
+    Resolver resolver;
+    resolver.resolve(*program);
+
+    // Checking the types once, so type errors surface before anything runs.
+    TypeChecker typeChecker;
+    typeChecker.check(*program);
+
+    // Rewriting the checked program into a cheaper equivalent one.
+    optimizer.optimize(*program);
+    return program;
+}
+
+void ZynkInterpreter::interpret(const std::string& source) {
+    Optimizer optimizer(inlineBudget);
+    const std::unique_ptr<ASTProgram> program = analyze(source, optimizer);
+    if (diagnostics) std::cerr << optimizer.statistics.summary();
+
     // Executing the program.
-    Evaluator evaluator;
-    evaluator.evaluate(std::move(program));
+    switch (engine) {
+        case ExecutionEngine::TreeWalker: {
+            Evaluator evaluator(jit);
+            evaluator.evaluate(*program);
+            break;
+        }
+        case ExecutionEngine::VM: {
+            Compiler compiler;
+            VirtualMachine vm(jit);
+            vm.run(*compiler.compile(*program));
+            break;
+        }
+        case ExecutionEngine::Closure: {
+            ClosureEngine closureEngine(jit);
+            closureEngine.run(*program);
+            break;
+        }
+    }
 }
 
 void ZynkInterpreter::interpretFile(const std::string& filePath) {
+    interpret(readFile(filePath));
+}
+
+#if defined(ZYNK_CXX_COMPILER) && defined(ZYNK_LIBRARY)
+// Quotes an argument of the compiler command for the shell.
+static std::string shellQuote(const std::string& argument) {
+    std::string quoted = "'";
+    for (const char character : argument) {
+        if (character == '\'') quoted += "'\\''";
+        else quoted += character;
+    }
+    return quoted + "'";
+}
+
+// Directory of the running executable, empty where it can't be found.
+static std::filesystem::path executableDirectory() {
+    std::error_code error;
+    const std::filesystem::path executable = std::filesystem::read_symlink("/proc/self/exe", error);
+    return error ? std::filesystem::path() : executable.parent_path();
+}
+
+// A setting of the native build: the environment variable if it is set, the path relative to an
+// installed executable if it exists there, or the default of the build tree.
+static std::string buildSetting(const char* variable, const std::filesystem::path& installed, const std::string& fallback) {
+    const char* value = std::getenv(variable);
+    if (value != nullptr && *value != '\0') return value;
+
+    const std::filesystem::path directory = executableDirectory();
+    std::error_code error;
+    if (!installed.empty() && !directory.empty() && std::filesystem::exists(directory / installed, error)) {
+        return (directory / installed).string();
+    }
+    return fallback;
+}
+#endif
+
+void ZynkInterpreter::buildFile(const std::string& filePath, const std::string& outputPath) {
+    // Errors found before the program runs are reported now, run-time ones by the executable.
+    Optimizer optimizer(inlineBudget);
+    const std::unique_ptr<ASTProgram> program = analyze(readFile(filePath), optimizer);
+#if defined(ZYNK_CXX_COMPILER) && defined(ZYNK_LIBRARY)
+    CppGenerator generator;
+    const std::string sourcePath = outputPath + ".cpp";
+    {
+        std::ofstream source(sourcePath);
+        if (!source.is_open()) {
+            throw ZynkError(ZynkErrorType::FileOpenError, "Failed to create '" + sourcePath + "'.");
+        }
+        source << generator.generate(*program, filePath);
+    }
+
+    const std::string compiler = buildSetting("ZYNK_CXX", {}, ZYNK_CXX_COMPILER);
+    const std::string includeDir = buildSetting("ZYNK_INCLUDE_DIR", "../include/zynk", ZYNK_INCLUDE_DIR);
+    const std::string library = buildSetting(
+        "ZYNK_LIBRARY", std::filesystem::path("../lib/zynk") / ZYNK_LIBRARY_NAME, ZYNK_LIBRARY
+    );
+    if (!std::filesystem::exists(library)) {
+        throw ZynkError(
+            ZynkErrorType::BuildError,
+            "The Zynk library '" + library + "' doesn't exist. Set ZYNK_LIBRARY and ZYNK_INCLUDE_DIR to build scripts."
+        );
+    }
+
+    // Only what the library needs, the executables don't depend on the machine that built them.
+    const std::string command = shellQuote(compiler) + " -O2 -std=c++17 -I" + shellQuote(includeDir) + " "
+        + shellQuote(sourcePath) + " " + shellQuote(library) + " -o " + shellQuote(outputPath);
+    if (std::system(command.c_str()) != 0) {
+        throw ZynkError(
+            ZynkErrorType::BuildError,
+            "Failed to compile '" + sourcePath + "' to '" + outputPath + "' with: " + command
+        );
+    }
+    std::remove(sourcePath.c_str());
+#else
+    (void) outputPath;
+    throw ZynkError(ZynkErrorType::BuildError, "This build of Zynk can't compile scripts.");
+#endif
+}
+
+std::string ZynkInterpreter::dumpOptimized(const std::string& filePath) {
+    Optimizer optimizer(inlineBudget);
+    const std::unique_ptr<ASTProgram> program = analyze(readFile(filePath), optimizer);
+
+    std::string dump;
+    std::istringstream summary(optimizer.statistics.summary());
+    for (std::string line; std::getline(summary, line);) {
+        dump += "// " + line + "\n";
+    }
+    return dump + "\n" + ASTPrinter().print(*program);
+}
+
+std::string ZynkInterpreter::readFile(const std::string& filePath) {
     std::ifstream file(filePath);
     if (!file.is_open()) {
         throw ZynkError(ZynkErrorType::FileOpenError, "Failed to open a file.");
     }
     std::stringstream buffer;
     buffer << file.rdbuf();
-    interpret(buffer.str());
+    return buffer.str();
 }
\ No newline at end of file
@@ -0,0 +1,248 @@
+#include "include/assembler.hpp"
+
+#include <cassert>
+
+Assembler::Label Assembler::newLabel() {
+    labels.push_back(SIZE_MAX);
+    return labels.size() - 1;
+}
+
+void Assembler::bind(Label label) {
+    labels[label] = code.size();
+}
+
+void Assembler::jump(Label label) {
+    emit({ 0xE9 });
+    emitTarget(label);
+}
+
+void Assembler::jumpIf(Condition condition, Label label) {
+    emit({ 0x0F, static_cast<uint8_t>(0x80 | static_cast<uint8_t>(condition)) });
+    emitTarget(label);
+}
+
+const std::vector<uint8_t>& Assembler::finish() {
+    for (const Patch& patch : patches) {
+        assert(labels[patch.label] != SIZE_MAX && "Label should be bound");
+        // Relative to the end of the rel32 operand.
+        const auto offset = static_cast<uint32_t>(labels[patch.label] - (patch.position + 4));
+        for (size_t i = 0; i < 4; i++) {
+            code[patch.position + i] = static_cast<uint8_t>(offset >> (i * 8));
+        }
+    }
+    patches.clear();
+    return code;
+}
+
+void Assembler::prologue() {
+    emit({ 0x53 });             // push rbx
+    emit({ 0x41, 0x54 });       // push r12
+    emit({ 0x55 });             // push rbp
+    emit({ 0x48, 0x89, 0xE5 }); // mov rbp, rsp
+    emit({ 0x48, 0x89, 0xFB }); // mov rbx, rdi
+    emit({ 0x49, 0x89, 0xF4 }); // mov r12, rsi
+}
+
+void Assembler::epilogue() {
+    // Restoring rsp drops the temporaries of an expression that bailed out.
+    emit({ 0x48, 0x89, 0xEC }); // mov rsp, rbp
+    emit({ 0x5D });             // pop rbp
+    emit({ 0x41, 0x5C });       // pop r12
+    emit({ 0x5B });             // pop rbx
+    emit({ 0xC3 });             // ret
+}
+
+void Assembler::loadImmediate(uint64_t value) {
+    emit({ 0x48, 0xB8 });
+    emit64(value);
+}
+
+void Assembler::loadSlot(int32_t offset) {
+    emit({ 0x48, 0x8B, 0x83 });
+    emit32(static_cast<uint32_t>(offset));
+}
+
+void Assembler::storeSlot(int32_t offset) {
+    emit({ 0x48, 0x89, 0x83 });
+    emit32(static_cast<uint32_t>(offset));
+}
+
+void Assembler::loadSecond(int32_t offset) {
+    emit({ 0x48, 0x8B, 0x8B });
+    emit32(static_cast<uint32_t>(offset));
+}
+
+void Assembler::incrementSlot(int32_t offset) {
+    emit({ 0x48, 0xFF, 0x83 });
+    emit32(static_cast<uint32_t>(offset));
+}
+
+void Assembler::push() {
+    emit({ 0x50 });
+}
+
+void Assembler::pop() {
+    emit({ 0x58 });
+}
+
+void Assembler::popSecond() {
+    emit({ 0x59 });
+}
+
+void Assembler::moveToSecond() {
+    emit({ 0x48, 0x89, 0xC1 });
+}
+
+void Assembler::status(uint32_t value) {
+    emit({ 0xB8 });
+    emit32(value);
+}
+
+void Assembler::addIntegers() {
+    emit({ 0x48, 0x01, 0xC8 });
+}
+
+void Assembler::subtractIntegers() {
+    emit({ 0x48, 0x29, 0xC8 });
+}
+
+void Assembler::multiplyIntegers() {
+    emit({ 0x48, 0x0F, 0xAF, 0xC1 });
+}
+
+void Assembler::divideIntegers() {
+    emit({ 0x48, 0x99 });       // cqo
+    emit({ 0x48, 0xF7, 0xF9 }); // idiv rcx
+}
+
+void Assembler::compareIntegers() {
+    emit({ 0x48, 0x39, 0xC8 });
+}
+
+void Assembler::compareSecondWith(int8_t value) {
+    emit({ 0x48, 0x83, 0xF9, static_cast<uint8_t>(value) });
+}
+
+void Assembler::compareWithMinimum() {
+    emit({ 0x48, 0xBA });       // mov rdx, INT64_MIN
+    emit64(static_cast<uint64_t>(INT64_MIN));
+    emit({ 0x48, 0x39, 0xD0 }); // cmp rax, rdx
+}
+
+void Assembler::testSecond() {
+    emit({ 0x48, 0x85, 0xC9 });
+}
+
+void Assembler::testSecondFloatZero() {
+    emit({ 0x48, 0x89, 0xCA }); // mov rdx, rcx
+    emit({ 0x48, 0xD1, 0xE2 }); // shl rdx, 1, drops the sign
+}
+
+void Assembler::testValue() {
+    emit({ 0x48, 0x85, 0xC0 });
+}
+
+void Assembler::setIf(Condition condition) {
+    emit({ 0x0F, static_cast<uint8_t>(0x90 | static_cast<uint8_t>(condition)), 0xC0 }); // setcc al
+    emit({ 0x0F, 0xB6, 0xC0 }); // movzx eax, al
+}
+
+void Assembler::integerToFloat() {
+    emit({ 0xF2, 0x48, 0x0F, 0x2A, 0xC0 });
+}
+
+void Assembler::secondIntegerToFloat() {
+    emit({ 0xF2, 0x48, 0x0F, 0x2A, 0xC9 });
+}
+
+void Assembler::valueToFloat() {
+    emit({ 0x66, 0x48, 0x0F, 0x6E, 0xC0 });
+}
+
+void Assembler::secondToFloat() {
+    emit({ 0x66, 0x48, 0x0F, 0x6E, 0xC9 });
+}
+
+void Assembler::floatToValue() {
+    emit({ 0x66, 0x48, 0x0F, 0x7E, 0xC0 });
+}
+
+void Assembler::floatToInteger() {
+    emit({ 0xF2, 0x48, 0x0F, 0x2C, 0xC0 });
+}
+
+void Assembler::addFloats() {
+    emit({ 0xF2, 0x0F, 0x58, 0xC1 });
+}
+
+void Assembler::subtractFloats() {
+    emit({ 0xF2, 0x0F, 0x5C, 0xC1 });
+}
+
+void Assembler::multiplyFloats() {
+    emit({ 0xF2, 0x0F, 0x59, 0xC1 });
+}
+
+void Assembler::divideFloats() {
+    emit({ 0xF2, 0x0F, 0x5E, 0xC1 });
+}
+
+void Assembler::compareFloats() {
+    emit({ 0x66, 0x0F, 0x2E, 0xC1 });
+}
+
+void Assembler::compareFloatsSwapped() {
+    emit({ 0x66, 0x0F, 0x2E, 0xC8 });
+}
+
+void Assembler::clearSecondFloat() {
+    emit({ 0x66, 0x0F, 0x57, 0xC9 });
+}
+
+void Assembler::floatIsTruthy() {
+    clearSecondFloat();
+    compareFloats();
+    emit({ 0x0F, 0x95, 0xC1 }); // setne cl
+    emit({ 0x0F, 0x9A, 0xC2 }); // setp dl
+    emit({ 0x08, 0xD1 });       // or cl, dl
+    emit({ 0x0F, 0xB6, 0xC9 }); // movzx ecx, cl
+    emit({ 0x85, 0xC9 });       // test ecx, ecx
+}
+
+void Assembler::decrementDepth() {
+    emit({ 0x49, 0xFF, 0x0C, 0x24 }); // dec qword [r12]
+}
+
+void Assembler::incrementDepth() {
+    emit({ 0x49, 0xFF, 0x04, 0x24 }); // inc qword [r12]
+}
+
+void Assembler::callFunction(int32_t frameOffset, int32_t entryOffset) {
+    emit({ 0x48, 0x8D, 0xBB });             // lea rdi, [rbx + frameOffset]
+    emit32(static_cast<uint32_t>(frameOffset));
+    emit({ 0x4C, 0x89, 0xE6 });             // mov rsi, r12
+    emit({ 0x49, 0x8B, 0x44, 0x24, 0x08 }); // mov rax, [r12 + 8]
+    emit({ 0xFF, 0x90 });                   // call [rax + entryOffset]
+    emit32(static_cast<uint32_t>(entryOffset));
+}
+
+void Assembler::emit(std::initializer_list<uint8_t> bytes) {
+    code.insert(code.end(), bytes);
+}
+
+void Assembler::emit32(uint32_t value) {
+    for (size_t i = 0; i < 4; i++) {
+        code.push_back(static_cast<uint8_t>(value >> (i * 8)));
+    }
+}
+
+void Assembler::emit64(uint64_t value) {
+    for (size_t i = 0; i < 8; i++) {
+        code.push_back(static_cast<uint8_t>(value >> (i * 8)));
+    }
+}
+
+void Assembler::emitTarget(Label label) {
+    patches.push_back({ code.size(), label });
+    emit32(0);
+}
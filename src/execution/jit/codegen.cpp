@@ -0,0 +1,442 @@
+#include "include/codegen.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+bool CodeGenerator::generate(const ASTFunction& function, std::vector<uint8_t>& code, std::vector<const ASTFunction*>& called) {
+    if (!isSupported(function.returnType)) return false;
+    for (const std::unique_ptr<ASTBase>& argument : function.arguments) {
+        if (!isSupported(static_cast<const ASTFunctionArgument*>(argument.get())->valueType)) return false;
+    }
+
+    assembler = Assembler();
+    bailout = assembler.newLabel();
+    returned = assembler.newLabel();
+    // The first slot holds the returned value, even if the function has no variables.
+    frameBytes = slotOffset(std::max<size_t>(function.frameSize, 1));
+    blocks.clear();
+    loopEnds.clear();
+    callees = &called;
+
+    assembler.prologue();
+    assembler.decrementDepth();
+    assembler.jumpIf(Condition::Sign, bailout);
+
+    // Arguments and the body share the block of the call.
+    std::vector<std::string> arguments;
+    for (const std::unique_ptr<ASTBase>& argument : function.arguments) {
+        arguments.push_back(static_cast<const ASTFunctionArgument*>(argument.get())->name);
+    }
+    if (!generateBody(function.body, false, std::move(arguments))) return false;
+    // Reaching the end means that no value was returned.
+    assembler.jump(bailout);
+
+    assembler.bind(returned);
+    assembler.storeSlot(0);
+    assembler.incrementDepth();
+    assembler.status(0);
+    assembler.epilogue();
+
+    assembler.bind(bailout);
+    assembler.status(1);
+    assembler.epilogue();
+
+    code = assembler.finish();
+    return true;
+}
+
+bool CodeGenerator::isSupported(ASTValueType type) {
+    return type == ASTValueType::Integer || type == ASTValueType::Float || type == ASTValueType::Bool;
+}
+
+bool CodeGenerator::generateBody(const std::vector<std::unique_ptr<ASTBase>>& body, bool loopBody, std::vector<std::string> declared) {
+    blocks.push_back({ loopBody, std::move(declared) });
+    for (const std::unique_ptr<ASTBase>& statement : body) {
+        if (statement != nullptr && !generateStatement(*statement)) return false;
+    }
+    blocks.pop_back();
+    return true;
+}
+
+bool CodeGenerator::generateStatement(const ASTBase& statement) {
+    switch (statement.type) {
+        case ASTType::VariableDeclaration:
+            return generateDeclaration(static_cast<const ASTVariableDeclaration&>(statement));
+        case ASTType::VariableModify: {
+            const auto& modify = static_cast<const ASTVariableModify&>(statement);
+            if (modify.binding.depth != 0 || !generateExpression(modify.value.get())) return false;
+            assembler.storeSlot(slotOffset(modify.binding.slot));
+            return true;
+        }
+        case ASTType::Condition:
+            return generateCondition(static_cast<const ASTCondition&>(statement));
+        case ASTType::While:
+            return generateWhile(static_cast<const ASTWhile&>(statement));
+        case ASTType::Break:
+            if (loopEnds.empty()) return false;
+            assembler.jump(loopEnds.back());
+            return true;
+        case ASTType::Return: {
+            const auto& returnStatement = static_cast<const ASTReturn&>(statement);
+            if (returnStatement.value == nullptr || !generateExpression(returnStatement.value.get())) return false;
+            assembler.jump(returned);
+            return true;
+        }
+        case ASTType::FunctionCall:
+        case ASTType::Variable:
+        case ASTType::Value:
+            return generateExpression(&statement);
+        default:
+            return false;
+    }
+}
+
+bool CodeGenerator::generateDeclaration(const ASTVariableDeclaration& declaration) {
+    Block& block = blocks.back();
+    // Declarations the interpreter would reject, or leave `null`, stay with the interpreter.
+    if (block.loopBody || declaration.value == nullptr || !isSupported(declaration.varType)) return false;
+    if (std::find(block.declared.begin(), block.declared.end(), declaration.name) != block.declared.end()) return false;
+    block.declared.push_back(declaration.name);
+
+    if (!generateExpression(declaration.value.get())) return false;
+    assembler.storeSlot(slotOffset(declaration.slot));
+    return true;
+}
+
+bool CodeGenerator::generateCondition(const ASTCondition& condition) {
+    const Assembler::Label elseLabel = assembler.newLabel();
+    const Assembler::Label end = assembler.newLabel();
+
+    if (!generateExpression(condition.expression.get())) return false;
+    emitTruthyTest(assembler, condition.expression->staticType);
+    assembler.jumpIf(Condition::Equal, elseLabel);
+
+    if (!generateBody(condition.body, false)) return false;
+    assembler.jump(end);
+    assembler.bind(elseLabel);
+    if (!generateBody(condition.elseBody, false)) return false;
+    assembler.bind(end);
+    return true;
+}
+
+bool CodeGenerator::generateWhile(const ASTWhile& loop) {
+    const Assembler::Label start = assembler.newLabel();
+    const Assembler::Label end = assembler.newLabel();
+
+    assembler.bind(start);
+    if (!generateExpression(loop.value.get())) return false;
+    emitTruthyTest(assembler, loop.value->staticType);
+    assembler.jumpIf(Condition::Equal, end);
+
+    loopEnds.push_back(end);
+    if (!generateBody(loop.body, true)) return false;
+    loopEnds.pop_back();
+
+    assembler.jump(start);
+    assembler.bind(end);
+    return true;
+}
+
+bool CodeGenerator::generateExpression(const ASTBase* expression) {
+    if (expression == nullptr || !isSupported(expression->staticType)) return false;
+
+    switch (expression->type) {
+        case ASTType::Value:
+            return generateValue(*static_cast<const ASTValue*>(expression));
+        case ASTType::Variable: {
+            const auto variable = static_cast<const ASTVariable*>(expression);
+            // Variables of enclosing functions can be changed by the caller, so only locals are supported.
+            if (variable->binding.depth != 0) return false;
+            assembler.loadSlot(slotOffset(variable->binding.slot));
+            return true;
+        }
+        case ASTType::BinaryOperation:
+            return generateBinaryOperation(*static_cast<const ASTBinaryOperation*>(expression));
+        case ASTType::ComparisonOperation:
+            return generateComparison(*static_cast<const ASTComparisonOperation*>(expression));
+        case ASTType::AndOperation: {
+            const auto operation = static_cast<const ASTAndOperation*>(expression);
+            return generateLogical(operation->left.get(), operation->right.get(), false);
+        }
+        case ASTType::OrOperation: {
+            const auto operation = static_cast<const ASTOrOperation*>(expression);
+            return generateLogical(operation->left.get(), operation->right.get(), true);
+        }
+        case ASTType::TypeCast:
+            return generateTypeCast(*static_cast<const ASTTypeCast*>(expression));
+        case ASTType::FunctionCall:
+            return generateCall(*static_cast<const ASTFunctionCall*>(expression));
+        default:
+            return false;
+    }
+}
+
+bool CodeGenerator::generateValue(const ASTValue& value) {
+    if (!isSupported(value.constant.type())) return false;
+    assembler.loadImmediate(encodeValue(value.constant));
+    return true;
+}
+
+bool CodeGenerator::generateBinaryOperation(const ASTBinaryOperation& operation) {
+    if (!generateExpression(operation.left.get())) return false;
+    assembler.push();
+    if (!generateExpression(operation.right.get())) return false;
+    assembler.moveToSecond();
+    assembler.pop();
+
+    emitBinaryOperation(assembler, operation.op, operation.left->staticType, operation.right->staticType, bailout);
+    return true;
+}
+
+bool CodeGenerator::generateComparison(const ASTComparisonOperation& operation) {
+    const ASTValueType leftType = operation.left->staticType;
+    const ASTValueType rightType = operation.right->staticType;
+    // A boolean compared with a number is compared by its text.
+    if ((leftType == ASTValueType::Bool) != (rightType == ASTValueType::Bool)) return false;
+
+    if (!generateExpression(operation.left.get())) return false;
+    assembler.push();
+    if (!generateExpression(operation.right.get())) return false;
+    assembler.moveToSecond();
+    assembler.pop();
+
+    emitComparison(assembler, operation.op, leftType, rightType);
+    return true;
+}
+
+bool CodeGenerator::generateLogical(const ASTBase* left, const ASTBase* right, bool isOr) {
+    // The result is the operand that decided it, both have the same type.
+    const Assembler::Label end = assembler.newLabel();
+    if (!generateExpression(left)) return false;
+    emitTruthyTest(assembler, left->staticType);
+    assembler.jumpIf(isOr ? Condition::NotEqual : Condition::Equal, end);
+    if (!generateExpression(right)) return false;
+    assembler.bind(end);
+    return true;
+}
+
+bool CodeGenerator::generateTypeCast(const ASTTypeCast& typeCast) {
+    const ASTValueType from = typeCast.value->staticType;
+    // Booleans read as text when cast to a number, which always fails.
+    if (typeCast.castType != ASTValueType::Bool && from == ASTValueType::Bool) return false;
+    if (!generateExpression(typeCast.value.get())) return false;
+
+    emitTypeCast(assembler, from, typeCast.castType, bailout);
+    return true;
+}
+
+bool CodeGenerator::generateCall(const ASTFunctionCall& functionCall) {
+    const ASTFunction* function = functionCall.function;
+    // Functions declared next to this one are declared in the same frame, which is
+    // checked before entering the compiled code. Anything else stays with the interpreter.
+    if (function == nullptr || functionCall.depth != 1 || !isSupported(function->returnType)) return false;
+
+    for (const std::unique_ptr<ASTBase>& argument : functionCall.arguments) {
+        if (!generateExpression(argument.get())) return false;
+        assembler.push();
+    }
+    // Arguments are stored once all of them are evaluated, nested calls use the same frame.
+    for (size_t i = function->arguments.size(); i-- > 0;) {
+        const auto argument = static_cast<const ASTFunctionArgument*>(function->arguments[i].get());
+        assembler.pop();
+        assembler.storeSlot(frameBytes + slotOffset(argument->slot));
+    }
+
+    assembler.callFunction(frameBytes, slotOffset(function->id));
+    assembler.testValue();
+    assembler.jumpIf(Condition::NotEqual, bailout);
+    assembler.loadSlot(frameBytes);
+
+    if (std::find(callees->begin(), callees->end(), function) == callees->end()) callees->push_back(function);
+    return true;
+}
+
+void CodeGenerator::emitTruthyTest(Assembler& assembler, ASTValueType type) {
+    if (type == ASTValueType::Float) {
+        assembler.valueToFloat();
+        assembler.floatIsTruthy();
+        return;
+    }
+    assembler.testValue();
+}
+
+void CodeGenerator::emitBinaryOperation(Assembler& assembler, ASTBinaryOperator op, ASTValueType leftType, ASTValueType rightType, Assembler::Label bailout) {
+    if (op == ASTBinaryOperator::Divide) {
+        // Both +0.0 and -0.0 are zero for the interpreter.
+        if (rightType == ASTValueType::Integer) assembler.testSecond();
+        else assembler.testSecondFloatZero();
+        assembler.jumpIf(Condition::Equal, bailout);
+    }
+
+    if (leftType == ASTValueType::Integer && rightType == ASTValueType::Integer) {
+        switch (op) {
+            case ASTBinaryOperator::Add:
+                assembler.addIntegers();
+                break;
+            case ASTBinaryOperator::Subtract:
+                assembler.subtractIntegers();
+                break;
+            case ASTBinaryOperator::Multiply:
+                assembler.multiplyIntegers();
+                break;
+            case ASTBinaryOperator::Divide: {
+                // INT64_MIN / -1 overflows, and would fault in idiv.
+                const Assembler::Label divide = assembler.newLabel();
+                assembler.compareSecondWith(-1);
+                assembler.jumpIf(Condition::NotEqual, divide);
+                assembler.compareWithMinimum();
+                assembler.jumpIf(Condition::Equal, bailout);
+                assembler.bind(divide);
+                assembler.divideIntegers();
+                return;
+            }
+        }
+        assembler.jumpIf(Condition::Overflow, bailout);
+        return;
+    }
+
+    if (leftType == ASTValueType::Integer) assembler.integerToFloat();
+    else assembler.valueToFloat();
+    if (rightType == ASTValueType::Integer) assembler.secondIntegerToFloat();
+    else assembler.secondToFloat();
+
+    switch (op) {
+        case ASTBinaryOperator::Add:
+            assembler.addFloats();
+            break;
+        case ASTBinaryOperator::Subtract:
+            assembler.subtractFloats();
+            break;
+        case ASTBinaryOperator::Multiply:
+            assembler.multiplyFloats();
+            break;
+        case ASTBinaryOperator::Divide:
+            assembler.divideFloats();
+            break;
+    }
+    assembler.floatToValue();
+}
+
+void CodeGenerator::emitComparison(Assembler& assembler, ASTComparisonOperator op, ASTValueType leftType, ASTValueType rightType) {
+    if (leftType == rightType && leftType != ASTValueType::Float) {
+        assembler.compareIntegers();
+        switch (op) {
+            case ASTComparisonOperator::Equal:
+                assembler.setIf(Condition::Equal);
+                break;
+            case ASTComparisonOperator::NotEqual:
+                assembler.setIf(Condition::NotEqual);
+                break;
+            case ASTComparisonOperator::Greater:
+                assembler.setIf(Condition::Greater);
+                break;
+            case ASTComparisonOperator::GreaterOrEqual:
+                assembler.setIf(Condition::GreaterOrEqual);
+                break;
+            case ASTComparisonOperator::Less:
+                assembler.setIf(Condition::Less);
+                break;
+            case ASTComparisonOperator::LessOrEqual:
+                assembler.setIf(Condition::LessOrEqual);
+                break;
+        }
+        return;
+    }
+
+    if (leftType == ASTValueType::Integer) assembler.integerToFloat();
+    else assembler.valueToFloat();
+    if (rightType == ASTValueType::Integer) assembler.secondIntegerToFloat();
+    else assembler.secondToFloat();
+
+    // An unordered compare (NaN) sets the parity flag, and is only true for '!='.
+    switch (op) {
+        case ASTComparisonOperator::Equal:
+        case ASTComparisonOperator::NotEqual: {
+            const bool equal = op == ASTComparisonOperator::Equal;
+            const Assembler::Label unordered = assembler.newLabel();
+            const Assembler::Label end = assembler.newLabel();
+            assembler.compareFloats();
+            assembler.jumpIf(Condition::Parity, unordered);
+            assembler.setIf(equal ? Condition::Equal : Condition::NotEqual);
+            assembler.jump(end);
+            assembler.bind(unordered);
+            assembler.loadImmediate(equal ? 0 : 1);
+            assembler.bind(end);
+            break;
+        }
+        case ASTComparisonOperator::Greater:
+            assembler.compareFloats();
+            assembler.setIf(Condition::Above);
+            break;
+        case ASTComparisonOperator::GreaterOrEqual:
+            assembler.compareFloats();
+            assembler.setIf(Condition::AboveOrEqual);
+            break;
+        case ASTComparisonOperator::Less:
+            assembler.compareFloatsSwapped();
+            assembler.setIf(Condition::Above);
+            break;
+        case ASTComparisonOperator::LessOrEqual:
+            assembler.compareFloatsSwapped();
+            assembler.setIf(Condition::AboveOrEqual);
+            break;
+    }
+}
+
+void CodeGenerator::emitTypeCast(Assembler& assembler, ASTValueType from, ASTValueType to, Assembler::Label bailout) {
+    switch (to) {
+        case ASTValueType::Integer:
+            if (from == ASTValueType::Float) {
+                assembler.valueToFloat();
+                assembler.floatToInteger();
+                // The conversion gives INT64_MIN for NaN and anything out of range, which the
+                // interpreter reports. INT64_MIN itself is converted there too.
+                assembler.compareWithMinimum();
+                assembler.jumpIf(Condition::Equal, bailout);
+            }
+            return;
+        case ASTValueType::Float:
+            if (from == ASTValueType::Integer) {
+                assembler.integerToFloat();
+                assembler.floatToValue();
+            }
+            return;
+        default:
+            emitTruthyTest(assembler, from);
+            assembler.setIf(Condition::NotEqual);
+            return;
+    }
+}
+
+int32_t CodeGenerator::slotOffset(size_t slot) {
+    return static_cast<int32_t>(slot * sizeof(uint64_t));
+}
+
+uint64_t encodeValue(const Value& value) {
+    switch (value.type()) {
+        case ASTValueType::Integer:
+            return static_cast<uint64_t>(value.asInt());
+        case ASTValueType::Float: {
+            const double number = value.asFloat();
+            uint64_t bits;
+            std::memcpy(&bits, &number, sizeof(bits));
+            return bits;
+        }
+        default:
+            return value.asBool() ? 1 : 0;
+    }
+}
+
+Value decodeValue(uint64_t bits, ASTValueType type) {
+    switch (type) {
+        case ASTValueType::Integer:
+            return Value::fromInt(static_cast<int64_t>(bits));
+        case ASTValueType::Float: {
+            double number;
+            std::memcpy(&number, &bits, sizeof(number));
+            return Value::fromFloat(number);
+        }
+        default:
+            return Value::fromBool(bits != 0);
+    }
+}
@@ -0,0 +1,100 @@
+#ifndef ASSEMBLER_H
+#define ASSEMBLER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+// Condition codes of x86-64 jumps and sets.
+enum class Condition : uint8_t {
+    Overflow = 0x0,
+    Below = 0x2,
+    AboveOrEqual = 0x3,
+    Equal = 0x4,
+    NotEqual = 0x5,
+    Above = 0x7,
+    Sign = 0x8,
+    Parity = 0xA,
+    NotParity = 0xB,
+    Less = 0xC,
+    GreaterOrEqual = 0xD,
+    LessOrEqual = 0xE,
+    Greater = 0xF,
+};
+
+// Minimal x86-64 encoder for the baseline JIT. Generated code keeps the current value
+// in rax and the second operand in rcx, the frame of the function in rbx and the
+// JitContext in r12. Floats are moved through xmm0 and xmm1 as raw bits.
+class Assembler {
+public:
+    using Label = size_t;
+
+    Label newLabel();
+    void bind(Label label);
+    void jump(Label label);
+    void jumpIf(Condition condition, Label label);
+    // Resolves every jump, must be called once all labels are bound.
+    const std::vector<uint8_t>& finish();
+
+    void prologue();
+    void epilogue();
+
+    void loadImmediate(uint64_t value); // rax = value
+    void loadSlot(int32_t offset);      // rax = [rbx + offset]
+    void storeSlot(int32_t offset);     // [rbx + offset] = rax
+    void loadSecond(int32_t offset);    // rcx = [rbx + offset]
+    void incrementSlot(int32_t offset); // ++[rbx + offset]
+    void push();                        // push rax
+    void pop();                         // pop rax
+    void popSecond();                   // pop rcx
+    void moveToSecond();                // rcx = rax
+    void status(uint32_t value);        // eax = value
+
+    void addIntegers();         // rax += rcx
+    void subtractIntegers();    // rax -= rcx
+    void multiplyIntegers();    // rax *= rcx
+    void divideIntegers();      // rax /= rcx, truncated
+    void compareIntegers();     // flags of rax - rcx
+    void compareSecondWith(int8_t value); // flags of rcx - value
+    void compareWithMinimum();  // flags of rax - INT64_MIN
+    void testSecond();          // flags of rcx & rcx
+    void testSecondFloatZero(); // zero flag set if rcx holds the bits of 0.0 or -0.0
+    void testValue();           // flags of rax & rax
+    void setIf(Condition condition); // rax = condition ? 1 : 0
+
+    void integerToFloat();      // xmm0 = (double) rax
+    void secondIntegerToFloat(); // xmm1 = (double) rcx
+    void valueToFloat();        // xmm0 = bits of rax
+    void secondToFloat();       // xmm1 = bits of rcx
+    void floatToValue();        // rax = bits of xmm0
+    void floatToInteger();      // rax = (int64_t) xmm0, truncated
+    void addFloats();           // xmm0 += xmm1
+    void subtractFloats();      // xmm0 -= xmm1
+    void multiplyFloats();      // xmm0 *= xmm1
+    void divideFloats();        // xmm0 /= xmm1
+    void compareFloats();       // unordered compare of xmm0 with xmm1
+    void compareFloatsSwapped(); // unordered compare of xmm1 with xmm0
+    void clearSecondFloat();    // xmm1 = 0.0
+    void floatIsTruthy();       // rcx = xmm0 != 0.0 (NaN is truthy), flags of rcx
+
+    void decrementDepth();      // --context->remainingDepth, sets the sign flag
+    void incrementDepth();      // ++context->remainingDepth
+    void callFunction(int32_t frameOffset, int32_t entryOffset); // calls context->entries[id] on rbx + frameOffset
+private:
+    struct Patch {
+        size_t position; // Position of the rel32 operand.
+        Label label;
+    };
+
+    std::vector<uint8_t> code;
+    std::vector<size_t> labels;
+    std::vector<Patch> patches;
+
+    void emit(std::initializer_list<uint8_t> bytes);
+    void emit32(uint32_t value);
+    void emit64(uint64_t value);
+    void emitTarget(Label label);
+};
+
+#endif // ASSEMBLER_H
@@ -0,0 +1,69 @@
+#ifndef CODEGEN_H
+#define CODEGEN_H
+
+#include "assembler.hpp"
+#include "../../../parsing/include/ast.hpp"
+#include <string>
+#include <vector>
+
+// Translates the body of a type checked function to x86-64, one template per node.
+//
+// Compiled code is called as `int function(uint64_t* frame, JitContext* context)`. Variables
+// live in the frame at the slots assigned by the resolver, as raw integers, float bits or
+// 0/1 for booleans. The callee frame starts right after the frame of the caller, and the
+// returned value is left in its first slot. A non-zero status means the call bailed out.
+//
+// Only functions without side effects are supported, so a call that bails out can be run
+// again by the interpreter, which then reports the error (overflow, division by zero,
+// recursion depth or a missing return).
+class CodeGenerator {
+public:
+    // Returns false if the function uses anything the JIT doesn't support.
+    // `callees` gets the functions called from the body.
+    bool generate(const ASTFunction& function, std::vector<uint8_t>& code, std::vector<const ASTFunction*>& callees);
+
+    static bool isSupported(ASTValueType type);
+
+    // Templates shared with the trace compiler. Operands are taken from rax and rcx,
+    // and the result is left in rax. Failed checks jump to `bailout`.
+    static void emitBinaryOperation(Assembler& assembler, ASTBinaryOperator op, ASTValueType leftType, ASTValueType rightType, Assembler::Label bailout);
+    static void emitComparison(Assembler& assembler, ASTComparisonOperator op, ASTValueType leftType, ASTValueType rightType);
+    static void emitTypeCast(Assembler& assembler, ASTValueType from, ASTValueType to, Assembler::Label bailout);
+    // Sets the zero flag if the value in rax is falsy, keeping the value.
+    static void emitTruthyTest(Assembler& assembler, ASTValueType type);
+private:
+    struct Block {
+        bool loopBody; // The whole loop shares one block, so nothing can be declared in it.
+        std::vector<std::string> declared;
+    };
+
+    Assembler assembler;
+    Assembler::Label bailout = 0;
+    Assembler::Label returned = 0;
+    int32_t frameBytes = 0;
+    std::vector<Block> blocks;
+    std::vector<Assembler::Label> loopEnds;
+    std::vector<const ASTFunction*>* callees = nullptr;
+
+    bool generateBody(const std::vector<std::unique_ptr<ASTBase>>& body, bool loopBody, std::vector<std::string> declared = {});
+    bool generateStatement(const ASTBase& statement);
+    bool generateDeclaration(const ASTVariableDeclaration& declaration);
+    bool generateCondition(const ASTCondition& condition);
+    bool generateWhile(const ASTWhile& loop);
+
+    bool generateExpression(const ASTBase* expression);
+    bool generateValue(const ASTValue& value);
+    bool generateBinaryOperation(const ASTBinaryOperation& operation);
+    bool generateComparison(const ASTComparisonOperation& operation);
+    bool generateLogical(const ASTBase* left, const ASTBase* right, bool isOr);
+    bool generateTypeCast(const ASTTypeCast& typeCast);
+    bool generateCall(const ASTFunctionCall& functionCall);
+
+    static int32_t slotOffset(size_t slot);
+};
+
+// Frame representation of a supported value, and back.
+uint64_t encodeValue(const Value& value);
+Value decodeValue(uint64_t bits, ASTValueType type);
+
+#endif // CODEGEN_H
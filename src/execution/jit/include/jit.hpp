@@ -0,0 +1,51 @@
+#ifndef JIT_H
+#define JIT_H
+
+#include "../../include/runtime.hpp"
+#include "memory.hpp"
+#include <cstdint>
+#include <vector>
+
+// State shared by the compiled functions of a call, see CodeGenerator.
+struct JitContext {
+    int64_t remainingDepth; // Calls left before the recursion limit of the interpreter is reached.
+    void* const* entries;   // Machine code of the compiled functions, indexed by function id.
+};
+
+// Baseline JIT. Functions are compiled to machine code once they were called `threshold`
+// times, unless they use something the CodeGenerator doesn't support.
+class Jit {
+public:
+    static constexpr uint32_t DEFAULT_THRESHOLD = 10;
+
+    explicit Jit(uint32_t threshold = DEFAULT_THRESHOLD);
+
+    // Runs the call in machine code if the function is hot. `depth` is the depth of the call site,
+    // as set by the type checker. Returns false if the interpreter has to run the call itself.
+    bool call(const ASTFunction& function, size_t depth, const Value* arguments, const RuntimeEnvironment& env, Value& result);
+    bool isCompiled(const ASTFunction& function) const;
+private:
+    enum class State : uint8_t { Cold, Compiled, Unsupported };
+
+    struct Function {
+        State state = State::Cold;
+        uint32_t calls = 0;
+        // Functions the compiled code can call, all of them have to be declared to run it.
+        std::vector<const ASTFunction*> callees;
+    };
+
+    const uint32_t threshold;
+    // Cleared once compiled code bails out. The interpreter reports an error for the
+    // same call, so the rest of the run isn't worth compiling.
+    bool enabled = true;
+    std::vector<Function> functions; // Indexed by function id.
+    std::vector<void*> entries;      // Indexed by function id.
+    ExecutableMemory memory;
+    std::vector<uint64_t> stack;     // Frames of the compiled functions.
+    size_t maxFrameSize = 1;
+
+    Function& getFunction(size_t id);
+    bool compile(const ASTFunction& function);
+};
+
+#endif // JIT_H
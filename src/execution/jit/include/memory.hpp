@@ -0,0 +1,32 @@
+#ifndef MEMORY_H
+#define MEMORY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#if defined(__x86_64__) && (defined(__linux__) || defined(__APPLE__))
+#define ZYNK_JIT_SUPPORTED 1
+#endif
+
+// Pages holding generated machine code, released together.
+class ExecutableMemory {
+public:
+    ExecutableMemory() = default;
+    ~ExecutableMemory();
+    ExecutableMemory(const ExecutableMemory&) = delete;
+    ExecutableMemory& operator=(const ExecutableMemory&) = delete;
+
+    // Copies the code to new pages and makes them executable.
+    // Returns nullptr if that isn't possible on this platform.
+    void* install(const std::vector<uint8_t>& code);
+private:
+    struct Mapping {
+        void* address;
+        size_t size;
+    };
+
+    std::vector<Mapping> mappings;
+};
+
+#endif // MEMORY_H
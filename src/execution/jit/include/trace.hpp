@@ -0,0 +1,111 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include "../../include/runtime.hpp"
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+enum class TraceOp : uint8_t {
+    Move,            // target = left
+    BinaryOperation, // target = left op right
+    Comparison,      // target = left op right
+    TypeCast,        // target = left cast to rightType
+    Guard,           // leaves the trace unless the truthiness of left is `expected`
+};
+
+// One step of a trace. Operands are slots of the trace frame, their types are known when recording.
+struct TraceInstruction {
+    TraceOp op;
+    uint32_t target = 0;
+    uint32_t left = 0;
+    uint32_t right = 0;
+    ASTValueType leftType = ASTValueType::None;
+    ASTValueType rightType = ASTValueType::None;
+    ASTBinaryOperator binaryOperator = ASTBinaryOperator::Add;
+    ASTComparisonOperator comparisonOperator = ASTComparisonOperator::Equal;
+    bool expected = false;
+    bool loopExit = false; // Failing the guard of the loop condition ends the loop.
+    bool condition = false; // Guards the path taken through the loop condition.
+};
+
+// One iteration of a loop, as it ran when it was recorded: the loop condition and the statements
+// taken through the body, with the called functions inlined and every branch replaced by a guard.
+// Slots hold values as in the frames of compiled functions, see CodeGenerator.
+struct Trace {
+    // Variable declared before the loop, loaded when the trace is entered.
+    struct Import {
+        ASTBinding binding; // Relative to the frame of the loop, the type is the one of the value.
+        uint32_t slot;
+        bool written = false;
+    };
+    struct Constant {
+        uint32_t slot;
+        uint64_t bits;
+    };
+    // Inlined function, it has to be declared `depth` frames up from the loop to run the trace.
+    struct Callee {
+        const ASTFunction* function;
+        size_t depth;
+    };
+
+    std::vector<TraceInstruction> instructions;
+    std::vector<Import> imports;
+    std::vector<Constant> constants;
+    std::vector<Callee> callees;
+    uint32_t slotCount = 0;
+    size_t inlineDepth = 0; // Deepest nesting of inlined calls.
+};
+
+// Records a trace by running the next iteration of a loop on a copy of the variables it uses.
+class TraceRecorder {
+public:
+    static constexpr size_t MAX_INSTRUCTIONS = 1000;
+    static constexpr size_t MAX_INLINE_DEPTH = 8;
+
+    // The loop condition must hold in `env`, which isn't changed. Returns false if the
+    // iteration does anything a trace can't, like printing or leaving the loop.
+    bool record(const ASTWhile& loop, RuntimeEnvironment& env, Trace& trace);
+private:
+    enum class Flow : uint8_t { Normal, Returned, Abort };
+
+    static constexpr uint32_t NoSlot = UINT32_MAX;
+
+    struct Inlined {
+        size_t depth; // Frames from the loop up to the frame the function is declared in.
+        std::unordered_map<size_t, uint32_t> locals; // Frame slot to trace slot.
+        uint32_t result = NoSlot;
+    };
+
+    RuntimeEnvironment* env = nullptr;
+    Trace* trace = nullptr;
+    // Value and number of writes of every trace slot in the recorded iteration.
+    std::vector<Value> values;
+    std::vector<uint32_t> versions;
+    // Variables of the loop frame and the frames enclosing it, by depth and slot.
+    std::map<std::pair<size_t, size_t>, uint32_t> variables;
+    std::vector<Inlined> inlined;
+    // Variables declared in the open blocks, by inlining level and frame slot.
+    std::vector<std::pair<size_t, size_t>> declared;
+    // Blocks open inside the loop body or the inlined function. Declarations directly
+    // in the loop body would be repeated in the same block, which the interpreter rejects.
+    size_t blockDepth = 0;
+
+    Flow recordBody(const std::vector<std::unique_ptr<ASTBase>>& body);
+    Flow recordStatement(const ASTBase& statement);
+    bool recordDeclaration(const ASTVariableDeclaration& declaration);
+    bool recordExpression(const ASTBase* expression, uint32_t& slot);
+    // `slot` gets the returned value, or NoSlot if the function doesn't return one.
+    bool recordCall(const ASTFunctionCall& functionCall, uint32_t& slot);
+
+    bool findVariable(const ASTBinding& binding, uint32_t& slot);
+    uint32_t newSlot(Value value);
+    uint32_t copy(uint32_t source);
+    void move(uint32_t target, uint32_t source);
+    // Forgets the variables declared since `mark`, once their block is exited.
+    void release(size_t mark);
+    void guard(uint32_t slot, bool loopExit);
+};
+
+#endif // TRACE_H
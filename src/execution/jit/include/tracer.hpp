@@ -0,0 +1,62 @@
+#ifndef TRACER_H
+#define TRACER_H
+
+#include "memory.hpp"
+#include "trace.hpp"
+#include <unordered_map>
+
+// Tracing JIT for while loops. Once a loop ran `threshold` iterations, the next one is recorded
+// and compiled to machine code that repeats it for as long as every guard holds.
+//
+// The trace only changes its own frame while running. At the end of every iteration it
+// commits the variables it wrote, and those are stored back into the runtime once it exits.
+// An iteration that fails a guard is dropped and run again by the interpreter.
+class Tracer {
+public:
+    static constexpr uint32_t DEFAULT_THRESHOLD = 10;
+
+    // What the interpreter continues with after run.
+    enum class Result : uint8_t {
+        RunIteration,   // The iteration the condition held for.
+        CheckCondition, // The trace left the loop condition on another path, it has to be evaluated again.
+        LoopEnded,      // Nothing, the trace ran the loop to its end.
+    };
+
+    explicit Tracer(uint32_t threshold = DEFAULT_THRESHOLD);
+
+    // Called once the loop condition held.
+    Result run(const ASTWhile& loop, RuntimeEnvironment& env);
+    bool isTraced(const ASTWhile& loop) const;
+private:
+    enum class State : uint8_t { Cold, Traced, Unsupported };
+
+    struct Loop {
+        State state = State::Cold;
+        uint32_t iterations = 0; // Counted until the loop is hot.
+        uint32_t recordings = 0;
+        uint32_t sideExits = 0;
+        uint64_t tracedIterations = 0;
+        Trace trace;
+        void* entry = nullptr;
+    };
+
+    // Loops that keep failing to record, or that leave their trace every few iterations even
+    // after being recorded again, stay with the interpreter.
+    static constexpr uint32_t MAX_RECORDINGS = 3;
+    static constexpr uint32_t MAX_SIDE_EXITS = 16;
+    static constexpr uint32_t MIN_ITERATIONS_PER_EXIT = 4;
+
+    const uint32_t threshold;
+    std::unordered_map<const ASTWhile*, Loop> loops;
+    ExecutableMemory memory;
+    std::vector<uint64_t> frame;
+    std::vector<Variable*> imports; // Variables of the running trace.
+
+    Result enter(Loop& loop, RuntimeEnvironment& env);
+    void* compile(const Trace& trace);
+    // The frame holds the trace slots, then the committed value of every written
+    // import, then the number of iterations run.
+    static uint32_t frameSize(const Trace& trace);
+};
+
+#endif // TRACER_H
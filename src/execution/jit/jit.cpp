@@ -0,0 +1,111 @@
+#include "include/jit.hpp"
+#include "include/codegen.hpp"
+
+#include <algorithm>
+
+using JitEntry = int (*)(uint64_t* frame, JitContext* context);
+
+Jit::Jit(uint32_t threshold) : threshold(threshold) {};
+
+bool Jit::call(const ASTFunction& function, size_t depth, const Value* arguments, const RuntimeEnvironment& env, Value& result) {
+#ifdef ZYNK_JIT_SUPPORTED
+    if (!enabled) return false;
+
+    Function& entry = getFunction(function.id);
+    if (entry.state == State::Unsupported) return false;
+    if (entry.state == State::Cold) {
+        if (++entry.calls < threshold || !compile(function)) return false;
+    }
+
+    // Compiled code doesn't check that the functions it calls are in scope.
+    for (const ASTFunction* callee : functions[function.id].callees) {
+        if (env.findFunctionScope(*callee, depth) == Block::None) return false;
+    }
+    // A variable declared without a value is passed as null.
+    for (size_t i = 0; i < function.arguments.size(); i++) {
+        if (arguments[i].type() != static_cast<const ASTFunctionArgument*>(function.arguments[i].get())->valueType) {
+            return false;
+        }
+    }
+
+    // The interpreter allows a call while at most MAX_DEPTH frames are open, this call included.
+    const int64_t remainingDepth = static_cast<int64_t>(env.MAX_DEPTH) - static_cast<int64_t>(env.frameCount()) + 1;
+    const size_t stackSize = static_cast<size_t>(remainingDepth + 1) * maxFrameSize;
+    if (stack.size() < stackSize) stack.resize(stackSize);
+
+    for (size_t i = 0; i < function.arguments.size(); i++) {
+        stack[static_cast<const ASTFunctionArgument*>(function.arguments[i].get())->slot] = encodeValue(arguments[i]);
+    }
+
+    JitContext context{ remainingDepth, entries.data() };
+    if (reinterpret_cast<JitEntry>(entries[function.id])(stack.data(), &context) != 0) {
+        enabled = false;
+        return false;
+    }
+    result = decodeValue(stack[0], function.returnType);
+    return true;
+#else
+    (void) function;
+    (void) depth;
+    (void) arguments;
+    (void) env;
+    (void) result;
+    return false;
+#endif
+}
+
+bool Jit::isCompiled(const ASTFunction& function) const {
+    return function.id < functions.size() && functions[function.id].state == State::Compiled;
+}
+
+Jit::Function& Jit::getFunction(size_t id) {
+    if (id >= functions.size()) {
+        functions.resize(id + 1);
+        entries.resize(id + 1, nullptr);
+    }
+    return functions[id];
+}
+
+bool Jit::compile(const ASTFunction& function) {
+    // Everything the function can call is compiled with it, so compiled code only calls compiled code.
+    std::vector<const ASTFunction*> pending{ &function };
+    std::vector<const ASTFunction*> reachable;
+    std::vector<std::pair<const ASTFunction*, std::vector<uint8_t>>> generated;
+
+    while (!pending.empty()) {
+        const ASTFunction* next = pending.back();
+        pending.pop_back();
+        if (std::find(reachable.begin(), reachable.end(), next) != reachable.end()) continue;
+        reachable.push_back(next);
+
+        Function& state = getFunction(next->id);
+        if (state.state == State::Compiled) {
+            pending.insert(pending.end(), state.callees.begin(), state.callees.end());
+            continue;
+        }
+
+        std::vector<uint8_t> code;
+        std::vector<const ASTFunction*> callees;
+        if (state.state == State::Unsupported || !CodeGenerator().generate(*next, code, callees)) {
+            state.state = State::Unsupported;
+            getFunction(function.id).state = State::Unsupported;
+            return false;
+        }
+        generated.emplace_back(next, std::move(code));
+        pending.insert(pending.end(), callees.begin(), callees.end());
+    }
+
+    for (const auto& [compiled, code] : generated) {
+        void* address = memory.install(code);
+        if (address == nullptr) {
+            enabled = false;
+            return false;
+        }
+        entries[compiled->id] = address;
+        Function& state = functions[compiled->id];
+        state.state = State::Compiled;
+        state.callees = reachable;
+        maxFrameSize = std::max({ maxFrameSize, compiled->frameSize, size_t(1) });
+    }
+    return true;
+}
@@ -0,0 +1,37 @@
+#include "include/memory.hpp"
+
+#include <cstring>
+
+#ifdef ZYNK_JIT_SUPPORTED
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+ExecutableMemory::~ExecutableMemory() {
+#ifdef ZYNK_JIT_SUPPORTED
+    for (const Mapping& mapping : mappings) {
+        munmap(mapping.address, mapping.size);
+    }
+#endif
+}
+
+void* ExecutableMemory::install(const std::vector<uint8_t>& code) {
+#ifdef ZYNK_JIT_SUPPORTED
+    const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    const size_t size = (code.size() + pageSize - 1) / pageSize * pageSize;
+
+    void* address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (address == MAP_FAILED) return nullptr;
+    std::memcpy(address, code.data(), code.size());
+    // Never writable and executable at the same time.
+    if (mprotect(address, size, PROT_READ | PROT_EXEC) != 0) {
+        munmap(address, size);
+        return nullptr;
+    }
+    mappings.push_back({ address, size });
+    return address;
+#else
+    (void) code;
+    return nullptr;
+#endif
+}
@@ -0,0 +1,344 @@
+#include "include/trace.hpp"
+#include "include/codegen.hpp"
+#include "../include/evaluator.hpp"
+#include "../../errors/include/errors.hpp"
+
+#include <algorithm>
+
+bool TraceRecorder::record(const ASTWhile& loop, RuntimeEnvironment& environment, Trace& recorded) {
+    env = &environment;
+    trace = &recorded;
+    values.clear();
+    versions.clear();
+    variables.clear();
+    inlined.clear();
+    declared.clear();
+    blockDepth = 0;
+
+    uint32_t condition;
+    if (!recordExpression(loop.value.get(), condition) || !values[condition].isTruthy()) return false;
+    for (TraceInstruction& instruction : trace->instructions) {
+        instruction.condition = instruction.op == TraceOp::Guard;
+    }
+    guard(condition, true);
+    return recordBody(loop.body) == Flow::Normal;
+}
+
+TraceRecorder::Flow TraceRecorder::recordBody(const std::vector<std::unique_ptr<ASTBase>>& body) {
+    for (const std::unique_ptr<ASTBase>& statement : body) {
+        if (statement == nullptr) continue;
+
+        const Flow flow = recordStatement(*statement);
+        if (flow != Flow::Normal) return flow;
+        if (trace->instructions.size() > MAX_INSTRUCTIONS) return Flow::Abort;
+    }
+    return Flow::Normal;
+}
+
+TraceRecorder::Flow TraceRecorder::recordStatement(const ASTBase& statement) {
+    switch (statement.type) {
+        case ASTType::VariableDeclaration:
+            return recordDeclaration(static_cast<const ASTVariableDeclaration&>(statement)) ? Flow::Normal : Flow::Abort;
+        case ASTType::VariableModify: {
+            const auto& modify = static_cast<const ASTVariableModify&>(statement);
+            uint32_t variable, value;
+            if (!findVariable(modify.binding, variable) || !recordExpression(modify.value.get(), value)) return Flow::Abort;
+            if (values[value].type() != values[variable].type()) return Flow::Abort;
+
+            move(variable, value);
+            for (Trace::Import& import : trace->imports) {
+                if (import.slot == variable) import.written = true;
+            }
+            return Flow::Normal;
+        }
+        case ASTType::Condition: {
+            const auto& condition = static_cast<const ASTCondition&>(statement);
+            uint32_t value;
+            if (!recordExpression(condition.expression.get(), value)) return Flow::Abort;
+            guard(value, false);
+
+            blockDepth++;
+            const size_t mark = declared.size();
+            const Flow flow = recordBody(values[value].isTruthy() ? condition.body : condition.elseBody);
+            release(mark);
+            blockDepth--;
+            return flow;
+        }
+        case ASTType::Return: {
+            // Returning from the function running the loop ends the loop.
+            if (inlined.empty()) return Flow::Abort;
+            const auto& returnStatement = static_cast<const ASTReturn&>(statement);
+            if (returnStatement.value != nullptr) {
+                uint32_t value;
+                if (!recordExpression(returnStatement.value.get(), value)) return Flow::Abort;
+                inlined.back().result = copy(value);
+            }
+            return Flow::Returned;
+        }
+        case ASTType::FunctionCall: {
+            uint32_t result;
+            return recordCall(static_cast<const ASTFunctionCall&>(statement), result) ? Flow::Normal : Flow::Abort;
+        }
+        case ASTType::Variable:
+        case ASTType::Value: {
+            uint32_t value;
+            return recordExpression(&statement, value) ? Flow::Normal : Flow::Abort;
+        }
+        default:
+            // Nested loops get traces of their own, anything else has side effects.
+            return Flow::Abort;
+    }
+}
+
+bool TraceRecorder::recordDeclaration(const ASTVariableDeclaration& declaration) {
+    if (blockDepth == 0 || declaration.value == nullptr || !CodeGenerator::isSupported(declaration.varType)) return false;
+
+    uint32_t value;
+    if (!recordExpression(declaration.value.get(), value) || values[value].type() != declaration.varType) return false;
+
+    const uint32_t slot = copy(value);
+    const size_t level = inlined.size();
+    if (level == 0) {
+        if (!variables.emplace(std::make_pair(size_t(0), declaration.slot), slot).second) return false;
+    } else if (!inlined.back().locals.emplace(declaration.slot, slot).second) {
+        return false;
+    }
+    declared.emplace_back(level, declaration.slot);
+    return true;
+}
+
+bool TraceRecorder::recordExpression(const ASTBase* expression, uint32_t& slot) {
+    if (expression == nullptr) return false;
+
+    switch (expression->type) {
+        case ASTType::Value: {
+            const Value& constant = static_cast<const ASTValue*>(expression)->constant;
+            if (!CodeGenerator::isSupported(constant.type())) return false;
+            slot = newSlot(constant);
+            trace->constants.push_back({ slot, encodeValue(constant) });
+            return true;
+        }
+        case ASTType::Variable:
+            return findVariable(static_cast<const ASTVariable*>(expression)->binding, slot);
+        case ASTType::BinaryOperation: {
+            const auto operation = static_cast<const ASTBinaryOperation*>(expression);
+            uint32_t left, right;
+            if (!recordExpression(operation->left.get(), left)) return false;
+            // Operands are read when the instruction runs, so the right one must not change the left one.
+            const uint32_t version = versions[left];
+            if (!recordExpression(operation->right.get(), right) || versions[left] != version) return false;
+            if (!values[left].isNumber() || !values[right].isNumber()) return false;
+
+            Value result;
+            try {
+                result = calculateValue(values[left], values[right], operation->op);
+            } catch (const ZynkError&) {
+                return false;
+            }
+            slot = newSlot(std::move(result));
+            TraceInstruction instruction{ TraceOp::BinaryOperation };
+            instruction.target = slot;
+            instruction.left = left;
+            instruction.right = right;
+            instruction.leftType = values[left].type();
+            instruction.rightType = values[right].type();
+            instruction.binaryOperator = operation->op;
+            trace->instructions.push_back(instruction);
+            return true;
+        }
+        case ASTType::ComparisonOperation: {
+            const auto operation = static_cast<const ASTComparisonOperation*>(expression);
+            uint32_t left, right;
+            if (!recordExpression(operation->left.get(), left)) return false;
+            const uint32_t version = versions[left];
+            if (!recordExpression(operation->right.get(), right) || versions[left] != version) return false;
+            // A boolean compared with a number is compared by its text.
+            if ((values[left].type() == ASTValueType::Bool) != (values[right].type() == ASTValueType::Bool)) return false;
+
+            slot = newSlot(compareValue(values[left], values[right], operation->op));
+            TraceInstruction instruction{ TraceOp::Comparison };
+            instruction.target = slot;
+            instruction.left = left;
+            instruction.right = right;
+            instruction.leftType = values[left].type();
+            instruction.rightType = values[right].type();
+            instruction.comparisonOperator = operation->op;
+            trace->instructions.push_back(instruction);
+            return true;
+        }
+        case ASTType::AndOperation:
+        case ASTType::OrOperation: {
+            const bool isOr = expression->type == ASTType::OrOperation;
+            const ASTBase* left = isOr ? static_cast<const ASTOrOperation*>(expression)->left.get()
+                                       : static_cast<const ASTAndOperation*>(expression)->left.get();
+            const ASTBase* right = isOr ? static_cast<const ASTOrOperation*>(expression)->right.get()
+                                        : static_cast<const ASTAndOperation*>(expression)->right.get();
+            // The operand deciding the result in this iteration is guarded, so only one of them is evaluated.
+            if (!recordExpression(left, slot)) return false;
+            guard(slot, false);
+            if (values[slot].isTruthy() == isOr) return true;
+            return recordExpression(right, slot);
+        }
+        case ASTType::TypeCast: {
+            const auto typeCast = static_cast<const ASTTypeCast*>(expression);
+            uint32_t value;
+            if (!recordExpression(typeCast->value.get(), value)) return false;
+            const ASTValueType from = values[value].type();
+            // Booleans read as text when cast to a number, which always fails.
+            if (!CodeGenerator::isSupported(typeCast->castType)) return false;
+            if (typeCast->castType != ASTValueType::Bool && from == ASTValueType::Bool) return false;
+
+            Value result;
+            try {
+                result = castValue(values[value], typeCast->castType);
+            } catch (const ZynkError&) {
+                return false;
+            }
+            slot = newSlot(std::move(result));
+            TraceInstruction instruction{ TraceOp::TypeCast };
+            instruction.target = slot;
+            instruction.left = value;
+            instruction.leftType = from;
+            instruction.rightType = typeCast->castType;
+            trace->instructions.push_back(instruction);
+            return true;
+        }
+        case ASTType::FunctionCall:
+            return recordCall(*static_cast<const ASTFunctionCall*>(expression), slot) && slot != NoSlot;
+        default:
+            return false;
+    }
+}
+
+bool TraceRecorder::recordCall(const ASTFunctionCall& functionCall, uint32_t& slot) {
+    const ASTFunction* function = functionCall.function;
+    if (function == nullptr || inlined.size() >= MAX_INLINE_DEPTH) return false;
+    if (function->arguments.size() != functionCall.arguments.size()) return false;
+
+    // Counted from the loop frame, the interpreter counts from the frame of the caller.
+    size_t depth = functionCall.depth;
+    if (!inlined.empty()) {
+        // Functions declared inside the inlined one would be declared on every call.
+        if (depth == 0) return false;
+        depth += inlined.back().depth - 1;
+    }
+    if (env->findFunctionScope(*function, depth) == Block::None) return false;
+    const auto known = std::find_if(trace->callees.begin(), trace->callees.end(), [&](const Trace::Callee& callee) {
+        return callee.function == function && callee.depth == depth;
+    });
+    if (known == trace->callees.end()) trace->callees.push_back({ function, depth });
+
+    std::vector<uint32_t> arguments;
+    std::vector<uint32_t> argumentVersions;
+    for (const std::unique_ptr<ASTBase>& argument : functionCall.arguments) {
+        uint32_t value;
+        if (!recordExpression(argument.get(), value)) return false;
+        arguments.push_back(value);
+        argumentVersions.push_back(versions[value]);
+    }
+
+    Inlined callee{ depth, {}, NoSlot };
+    for (size_t i = 0; i < arguments.size(); i++) {
+        const auto argument = static_cast<const ASTFunctionArgument*>(function->arguments[i].get());
+        if (versions[arguments[i]] != argumentVersions[i] || values[arguments[i]].type() != argument->valueType) return false;
+        callee.locals.emplace(argument->slot, copy(arguments[i]));
+    }
+    inlined.push_back(std::move(callee));
+    trace->inlineDepth = std::max(trace->inlineDepth, inlined.size());
+
+    // The body of a function is a block of its own.
+    const size_t enclosingBlockDepth = blockDepth;
+    const size_t mark = declared.size();
+    blockDepth = 1;
+    const Flow flow = recordBody(function->body);
+    declared.resize(mark);
+    blockDepth = enclosingBlockDepth;
+    slot = inlined.back().result;
+    inlined.pop_back();
+
+    if (flow == Flow::Abort) return false;
+    if (function->returnType == ASTValueType::None) {
+        slot = NoSlot;
+        return true;
+    }
+    // Reaching the end of the function without a value is an error for the interpreter.
+    return slot != NoSlot && values[slot].type() == function->returnType;
+}
+
+bool TraceRecorder::findVariable(const ASTBinding& binding, uint32_t& slot) {
+    if (binding.slot == ASTBinding::Unresolved) return false;
+
+    size_t depth = binding.depth;
+    if (!inlined.empty()) {
+        const Inlined& function = inlined.back();
+        if (depth == 0) {
+            const auto local = function.locals.find(binding.slot);
+            if (local == function.locals.end()) return false;
+            slot = local->second;
+            return true;
+        }
+        depth += function.depth - 1;
+    }
+
+    const auto key = std::make_pair(depth, binding.slot);
+    if (const auto known = variables.find(key); known != variables.end()) {
+        slot = known->second;
+        return true;
+    }
+
+    // Declared before the loop, the trace loads it when entered.
+    ASTBinding outer;
+    outer.depth = depth;
+    outer.slot = binding.slot;
+    const Variable* variable = env->findVariable(outer);
+    if (variable == nullptr || !CodeGenerator::isSupported(variable->value.type())) return false;
+    outer.type = variable->value.type();
+
+    slot = newSlot(variable->value);
+    variables.emplace(key, slot);
+    trace->imports.push_back({ outer, slot });
+    return true;
+}
+
+uint32_t TraceRecorder::newSlot(Value value) {
+    values.push_back(std::move(value));
+    versions.push_back(0);
+    trace->slotCount = static_cast<uint32_t>(values.size());
+    return trace->slotCount - 1;
+}
+
+uint32_t TraceRecorder::copy(uint32_t source) {
+    const uint32_t slot = newSlot(values[source]);
+    TraceInstruction instruction{ TraceOp::Move };
+    instruction.target = slot;
+    instruction.left = source;
+    trace->instructions.push_back(instruction);
+    return slot;
+}
+
+void TraceRecorder::move(uint32_t target, uint32_t source) {
+    values[target] = values[source];
+    versions[target]++;
+    TraceInstruction instruction{ TraceOp::Move };
+    instruction.target = target;
+    instruction.left = source;
+    trace->instructions.push_back(instruction);
+}
+
+void TraceRecorder::release(size_t mark) {
+    for (size_t i = mark; i < declared.size(); i++) {
+        const auto [level, frameSlot] = declared[i];
+        if (level == 0) variables.erase(std::make_pair(size_t(0), frameSlot));
+        else inlined[level - 1].locals.erase(frameSlot);
+    }
+    declared.resize(mark);
+}
+
+void TraceRecorder::guard(uint32_t slot, bool loopExit) {
+    TraceInstruction instruction{ TraceOp::Guard };
+    instruction.left = slot;
+    instruction.leftType = values[slot].type();
+    instruction.expected = values[slot].isTruthy();
+    instruction.loopExit = loopExit;
+    trace->instructions.push_back(instruction);
+}
@@ -0,0 +1,165 @@
+#include "include/tracer.hpp"
+#include "include/codegen.hpp"
+
+#include <algorithm>
+
+using TraceEntry = int (*)(uint64_t* frame);
+
+static int32_t slotOffset(uint32_t slot) {
+    return static_cast<int32_t>(slot * sizeof(uint64_t));
+}
+
+Tracer::Tracer(uint32_t threshold) : threshold(threshold) {};
+
+Tracer::Result Tracer::run(const ASTWhile& node, RuntimeEnvironment& env) {
+#ifdef ZYNK_JIT_SUPPORTED
+    Loop& loop = loops[&node];
+    switch (loop.state) {
+        case State::Cold:
+            if (++loop.iterations < threshold) return Result::RunIteration;
+            // Recording doesn't change anything, the interpreter still runs this iteration.
+            loop.iterations = 0;
+            loop.recordings++;
+            loop.trace = Trace();
+            if (TraceRecorder().record(node, env, loop.trace) && (loop.entry = compile(loop.trace)) != nullptr) {
+                loop.state = State::Traced;
+                loop.sideExits = 0;
+                loop.tracedIterations = 0;
+            } else if (loop.recordings >= MAX_RECORDINGS) {
+                loop.state = State::Unsupported;
+            }
+            return Result::RunIteration;
+        case State::Traced:
+            return enter(loop, env);
+        default:
+            return Result::RunIteration;
+    }
+#else
+    (void) node;
+    (void) env;
+    return Result::RunIteration;
+#endif
+}
+
+bool Tracer::isTraced(const ASTWhile& loop) const {
+    const auto found = loops.find(&loop);
+    return found != loops.end() && found->second.state == State::Traced;
+}
+
+Tracer::Result Tracer::enter(Loop& loop, RuntimeEnvironment& env) {
+    const Trace& trace = loop.trace;
+    // Inlined calls count towards the recursion limit, as if the interpreter made them.
+    if (env.frameCount() + trace.inlineDepth > env.MAX_DEPTH + 1) return Result::RunIteration;
+    for (const Trace::Callee& callee : trace.callees) {
+        if (env.findFunctionScope(*callee.function, callee.depth) == Block::None) return Result::RunIteration;
+    }
+    imports.clear();
+    for (const Trace::Import& import : trace.imports) {
+        Variable* variable = env.findVariable(import.binding);
+        if (variable == nullptr || variable->value.type() != import.binding.type) return Result::RunIteration;
+        imports.push_back(variable);
+    }
+
+    frame.resize(std::max<size_t>(frame.size(), frameSize(trace)));
+    for (const Trace::Constant& constant : trace.constants) {
+        frame[constant.slot] = constant.bits;
+    }
+    uint32_t committed = trace.slotCount;
+    for (size_t i = 0; i < trace.imports.size(); i++) {
+        frame[trace.imports[i].slot] = encodeValue(imports[i]->value);
+        if (trace.imports[i].written) frame[committed++] = frame[trace.imports[i].slot];
+    }
+    frame[committed] = 0;
+
+    const int status = reinterpret_cast<TraceEntry>(loop.entry)(frame.data());
+
+    committed = trace.slotCount;
+    for (size_t i = 0; i < trace.imports.size(); i++) {
+        if (trace.imports[i].written) imports[i]->value = decodeValue(frame[committed++], trace.imports[i].binding.type);
+    }
+    const uint64_t iterations = frame[committed];
+    loop.tracedIterations += iterations;
+    if (status == 0) return Result::LoopEnded;
+
+    // The recorded path may have been the rare one, so the loop is recorded again.
+    loop.sideExits++;
+    if (loop.sideExits >= MAX_SIDE_EXITS && loop.tracedIterations < uint64_t(loop.sideExits) * MIN_ITERATIONS_PER_EXIT) {
+        loop.state = loop.recordings < MAX_RECORDINGS ? State::Cold : State::Unsupported;
+    }
+    // Leaving the condition of the first iteration is fine, the interpreter already evaluated it.
+    return status == 2 && iterations > 0 ? Result::CheckCondition : Result::RunIteration;
+}
+
+void* Tracer::compile(const Trace& trace) {
+    Assembler assembler;
+    const Assembler::Label header = assembler.newLabel();
+    const Assembler::Label loopExit = assembler.newLabel();
+    const Assembler::Label sideExit = assembler.newLabel();
+    const Assembler::Label conditionExit = assembler.newLabel();
+
+    assembler.prologue();
+    assembler.bind(header);
+    for (const TraceInstruction& instruction : trace.instructions) {
+        switch (instruction.op) {
+            case TraceOp::Move:
+                assembler.loadSlot(slotOffset(instruction.left));
+                break;
+            case TraceOp::BinaryOperation:
+                assembler.loadSlot(slotOffset(instruction.left));
+                assembler.loadSecond(slotOffset(instruction.right));
+                CodeGenerator::emitBinaryOperation(
+                    assembler, instruction.binaryOperator, instruction.leftType, instruction.rightType, sideExit
+                );
+                break;
+            case TraceOp::Comparison:
+                assembler.loadSlot(slotOffset(instruction.left));
+                assembler.loadSecond(slotOffset(instruction.right));
+                CodeGenerator::emitComparison(assembler, instruction.comparisonOperator, instruction.leftType, instruction.rightType);
+                break;
+            case TraceOp::TypeCast:
+                assembler.loadSlot(slotOffset(instruction.left));
+                CodeGenerator::emitTypeCast(assembler, instruction.leftType, instruction.rightType, sideExit);
+                break;
+            case TraceOp::Guard:
+                assembler.loadSlot(slotOffset(instruction.left));
+                CodeGenerator::emitTruthyTest(assembler, instruction.leftType);
+                assembler.jumpIf(
+                    instruction.expected ? Condition::Equal : Condition::NotEqual,
+                    instruction.loopExit ? loopExit : instruction.condition ? conditionExit : sideExit
+                );
+                continue;
+        }
+        assembler.storeSlot(slotOffset(instruction.target));
+    }
+
+    // The iteration is complete, a guard failing from here on drops only the next one.
+    uint32_t committed = trace.slotCount;
+    for (const Trace::Import& import : trace.imports) {
+        if (!import.written) continue;
+        assembler.loadSlot(slotOffset(import.slot));
+        assembler.storeSlot(slotOffset(committed++));
+    }
+    assembler.incrementSlot(slotOffset(committed));
+    assembler.jump(header);
+
+    assembler.bind(loopExit);
+    assembler.status(0);
+    assembler.epilogue();
+
+    assembler.bind(sideExit);
+    assembler.status(1);
+    assembler.epilogue();
+
+    assembler.bind(conditionExit);
+    assembler.status(2);
+    assembler.epilogue();
+
+    return memory.install(assembler.finish());
+}
+
+uint32_t Tracer::frameSize(const Trace& trace) {
+    const auto written = std::count_if(trace.imports.begin(), trace.imports.end(), [](const Trace::Import& import) {
+        return import.written;
+    });
+    return trace.slotCount + static_cast<uint32_t>(written) + 1;
+}
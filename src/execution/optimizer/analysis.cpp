@@ -0,0 +1,160 @@
+#include "include/analysis.hpp"
+
+#include <unordered_set>
+#include <vector>
+
+static bool isNumber(ASTValueType type) {
+    return type == ASTValueType::Integer || type == ASTValueType::Float;
+}
+
+// Whether a safe expression never gives null, which arithmetic and conversions to numbers reject.
+static bool holdsValue(const ASTBase* expression) {
+    switch (expression->type) {
+        case ASTType::Variable:
+            return static_cast<const ASTVariable*>(expression)->binding.initialized;
+        case ASTType::AndOperation: {
+            const auto operation = static_cast<const ASTAndOperation*>(expression);
+            return holdsValue(operation->left.get()) && holdsValue(operation->right.get());
+        }
+        case ASTType::OrOperation: {
+            const auto operation = static_cast<const ASTOrOperation*>(expression);
+            return holdsValue(operation->left.get()) && holdsValue(operation->right.get());
+        }
+        default:
+            return true;
+    }
+}
+
+bool isSafe(const ASTBase* expression) {
+    if (expression == nullptr) return true;
+
+    switch (expression->type) {
+        case ASTType::Value:
+            return true;
+        case ASTType::Variable:
+            // Variables of enclosing functions may not be declared yet when the function runs.
+            return static_cast<const ASTVariable*>(expression)->binding.depth == 0;
+        case ASTType::TypeCast: {
+            const auto typeCast = static_cast<const ASTTypeCast*>(expression);
+            // Text can fail to convert to a number, and floats outside of the int64 range to an int.
+            const ASTValueType from = typeCast->value->staticType;
+            const bool converts = typeCast->castType == ASTValueType::String || typeCast->castType == ASTValueType::Bool
+                || (typeCast->castType == ASTValueType::Float && isNumber(from))
+                || (typeCast->castType == ASTValueType::Integer && from == ASTValueType::Integer);
+            const bool numeric = typeCast->castType == ASTValueType::Integer || typeCast->castType == ASTValueType::Float;
+            return converts && isSafe(typeCast->value.get()) && (!numeric || holdsValue(typeCast->value.get()));
+        }
+        case ASTType::FString:
+            for (const std::unique_ptr<ASTBase>& part : static_cast<const ASTFString*>(expression)->parts) {
+                if (!isSafe(part.get())) return false;
+            }
+            return true;
+        case ASTType::BinaryOperation: {
+            // Integers can overflow and anything can be divided by zero, floats otherwise never fail.
+            const auto operation = static_cast<const ASTBinaryOperation*>(expression);
+            return operation->staticType == ASTValueType::Float && operation->op != ASTBinaryOperator::Divide
+                && isSafe(operation->left.get()) && isSafe(operation->right.get())
+                && holdsValue(operation->left.get()) && holdsValue(operation->right.get());
+        }
+        case ASTType::ComparisonOperation: {
+            const auto operation = static_cast<const ASTComparisonOperation*>(expression);
+            return isSafe(operation->left.get()) && isSafe(operation->right.get());
+        }
+        case ASTType::AndOperation: {
+            const auto operation = static_cast<const ASTAndOperation*>(expression);
+            return isSafe(operation->left.get()) && isSafe(operation->right.get());
+        }
+        case ASTType::OrOperation: {
+            const auto operation = static_cast<const ASTOrOperation*>(expression);
+            return isSafe(operation->left.get()) && isSafe(operation->right.get());
+        }
+        default:
+            return false;
+    }
+}
+
+// Whether a node of the function, or of a function it calls, matches.
+template <typename Match>
+static bool reaches(const ASTFunction& function, Match match) {
+    std::unordered_set<const ASTFunction*> visited;
+    std::vector<const ASTBase*> pending = { &function };
+
+    while (!pending.empty()) {
+        const ASTBase* node = pending.back();
+        pending.pop_back();
+        if (node == nullptr) continue;
+        if (match(*node)) return true;
+
+        if (node->type == ASTType::FunctionDeclaration && !visited.insert(static_cast<const ASTFunction*>(node)).second) continue;
+        if (node->type == ASTType::FunctionCall) pending.push_back(static_cast<const ASTFunctionCall*>(node)->function);
+        forEachChild(*node, [&pending](const ASTBase* child) { pending.push_back(child); });
+    }
+    return false;
+}
+
+bool isPure(const ASTFunction& function) {
+    return !reaches(function, [](const ASTBase& node) {
+        switch (node.type) {
+            case ASTType::Print:
+            case ASTType::ReadInput:
+                return true;
+            case ASTType::Variable:
+                return static_cast<const ASTVariable&>(node).binding.depth != 0;
+            case ASTType::VariableModify:
+                return static_cast<const ASTVariableModify&>(node).binding.depth != 0;
+            case ASTType::FunctionCall:
+                // The declaration is only known once the program is type checked.
+                return static_cast<const ASTFunctionCall&>(node).function == nullptr;
+            default:
+                return false;
+        }
+    });
+}
+
+bool assignsEnclosing(const ASTFunction& function) {
+    return reaches(function, [](const ASTBase& node) {
+        if (node.type == ASTType::FunctionCall) return static_cast<const ASTFunctionCall&>(node).function == nullptr;
+        return node.type == ASTType::VariableModify && static_cast<const ASTVariableModify&>(node).binding.depth != 0;
+    });
+}
+
+bool isRecursive(const ASTFunction& function) {
+    return reaches(function, [&function](const ASTBase& node) {
+        if (node.type != ASTType::FunctionCall) return false;
+        const ASTFunction* called = static_cast<const ASTFunctionCall&>(node).function;
+        return called == nullptr || called == &function;
+    });
+}
+
+static void copyChecked(ASTBase& expression, ASTBase& copy) {
+    copy.staticType = expression.staticType;
+    if (expression.type == ASTType::FunctionCall) {
+        const auto& call = static_cast<const ASTFunctionCall&>(expression);
+        auto& callCopy = static_cast<ASTFunctionCall&>(copy);
+        callCopy.function = call.function;
+        callCopy.depth = call.depth;
+    }
+
+    std::vector<ASTBase*> operands;
+    forEachOperand(expression, [&operands](std::unique_ptr<ASTBase>& operand) { operands.push_back(operand.get()); });
+
+    size_t index = 0;
+    forEachOperand(copy, [&](std::unique_ptr<ASTBase>& operand) {
+        if (operand != nullptr) copyChecked(*operands[index], *operand);
+        index++;
+    });
+}
+
+std::unique_ptr<ASTBase> copyExpression(ASTBase& expression) {
+    std::unique_ptr<ASTBase> copy = expression.clone();
+    copyChecked(expression, *copy);
+    return copy;
+}
+
+size_t countNodes(const ASTBase* node) {
+    if (node == nullptr) return 0;
+
+    size_t count = 1;
+    forEachChild(*node, [&count](const ASTBase* child) { count += countNodes(child); });
+    return count;
+}
@@ -0,0 +1,193 @@
+#include "include/eliminator.hpp"
+#include "include/analysis.hpp"
+
+static bool terminates(const ASTBase& statement);
+
+// Whether the body always ends in a return or a break.
+static bool terminates(const std::vector<std::unique_ptr<ASTBase>>& body) {
+    for (const std::unique_ptr<ASTBase>& statement : body) {
+        if (statement != nullptr && terminates(*statement)) return true;
+    }
+    return false;
+}
+
+static bool terminates(const ASTBase& statement) {
+    switch (statement.type) {
+        case ASTType::Return:
+        case ASTType::Break:
+            return true;
+        case ASTType::Condition: {
+            const auto& condition = static_cast<const ASTCondition&>(statement);
+            return terminates(condition.body) && terminates(condition.elseBody);
+        }
+        default:
+            return false;
+    }
+}
+
+void DeadCodeEliminator::eliminate(ASTProgram& program) {
+    // Removing a declaration can leave the variables its value read unused in turn.
+    do {
+        changed = false;
+        uses.clear();
+        declarations.clear();
+        countBody(program.body);
+        eliminateBody(program.body, false);
+    } while (changed);
+}
+
+void DeadCodeEliminator::countBody(const std::vector<std::unique_ptr<ASTBase>>& body) {
+    for (const std::unique_ptr<ASTBase>& node : body) {
+        countNode(node.get());
+    }
+}
+
+void DeadCodeEliminator::countNode(const ASTBase* node) {
+    if (node == nullptr) return;
+
+    switch (node->type) {
+        case ASTType::FunctionDeclaration: {
+            const auto function = static_cast<const ASTFunction*>(node);
+            for (const std::unique_ptr<ASTBase>& argument : function->arguments) {
+                declarations[static_cast<const ASTFunctionArgument*>(argument.get())->name]++;
+            }
+            countBody(function->body);
+            break;
+        }
+        case ASTType::FunctionCall:
+            countBody(static_cast<const ASTFunctionCall*>(node)->arguments);
+            break;
+        case ASTType::VariableDeclaration: {
+            const auto declaration = static_cast<const ASTVariableDeclaration*>(node);
+            declarations[declaration->name]++;
+            countNode(declaration->value.get());
+            break;
+        }
+        case ASTType::VariableModify: {
+            const auto variableModify = static_cast<const ASTVariableModify*>(node);
+            uses[variableModify->name]++;
+            countNode(variableModify->value.get());
+            break;
+        }
+        case ASTType::Variable:
+            uses[static_cast<const ASTVariable*>(node)->name]++;
+            break;
+        case ASTType::Print:
+            countNode(static_cast<const ASTPrint*>(node)->expression.get());
+            break;
+        case ASTType::ReadInput:
+            countNode(static_cast<const ASTReadInput*>(node)->out.get());
+            break;
+        case ASTType::FString:
+            countBody(static_cast<const ASTFString*>(node)->parts);
+            break;
+        case ASTType::BinaryOperation: {
+            const auto operation = static_cast<const ASTBinaryOperation*>(node);
+            countNode(operation->left.get());
+            countNode(operation->right.get());
+            break;
+        }
+        case ASTType::ComparisonOperation: {
+            const auto operation = static_cast<const ASTComparisonOperation*>(node);
+            countNode(operation->left.get());
+            countNode(operation->right.get());
+            break;
+        }
+        case ASTType::AndOperation: {
+            const auto operation = static_cast<const ASTAndOperation*>(node);
+            countNode(operation->left.get());
+            countNode(operation->right.get());
+            break;
+        }
+        case ASTType::OrOperation: {
+            const auto operation = static_cast<const ASTOrOperation*>(node);
+            countNode(operation->left.get());
+            countNode(operation->right.get());
+            break;
+        }
+        case ASTType::Condition: {
+            const auto condition = static_cast<const ASTCondition*>(node);
+            countNode(condition->expression.get());
+            countBody(condition->body);
+            countBody(condition->elseBody);
+            break;
+        }
+        case ASTType::While: {
+            const auto loop = static_cast<const ASTWhile*>(node);
+            countNode(loop->value.get());
+            countBody(loop->body);
+            break;
+        }
+        case ASTType::TypeCast:
+            countNode(static_cast<const ASTTypeCast*>(node)->value.get());
+            break;
+        case ASTType::Return:
+            countNode(static_cast<const ASTReturn*>(node)->value.get());
+            break;
+        default:
+            break;
+    }
+}
+
+void DeadCodeEliminator::eliminateBody(std::vector<std::unique_ptr<ASTBase>>& body, bool insideLoop) {
+    std::vector<std::unique_ptr<ASTBase>> result;
+    result.reserve(body.size());
+    bool terminated = false;
+
+    for (std::unique_ptr<ASTBase>& statement : body) {
+        if (statement == nullptr) continue;
+
+        if (terminated) {
+            // Declarations of functions are kept, calls made before the end can refer to them.
+            if (statement->type == ASTType::FunctionDeclaration) {
+                result.push_back(std::move(statement));
+                continue;
+            }
+            statistics.unreachableStatements++;
+            removed(*statement);
+            continue;
+        }
+
+        switch (statement->type) {
+            case ASTType::FunctionDeclaration:
+                eliminateBody(static_cast<ASTFunction&>(*statement).body, false);
+                break;
+            case ASTType::VariableDeclaration:
+                if (isUnused(static_cast<const ASTVariableDeclaration&>(*statement), insideLoop)) {
+                    statistics.unusedDeclarations++;
+                    removed(*statement);
+                    continue;
+                }
+                break;
+            case ASTType::Condition: {
+                auto& condition = static_cast<ASTCondition&>(*statement);
+                eliminateBody(condition.body, insideLoop);
+                eliminateBody(condition.elseBody, insideLoop);
+                if (condition.body.empty() && condition.elseBody.empty() && isSafe(condition.expression.get())) {
+                    statistics.emptyBranches++;
+                    removed(*statement);
+                    continue;
+                }
+                break;
+            }
+            case ASTType::While:
+                eliminateBody(static_cast<ASTWhile&>(*statement).body, true);
+                break;
+            default:
+                break;
+        }
+        terminated = terminates(*statement);
+        result.push_back(std::move(statement));
+    }
+    body = std::move(result);
+}
+
+bool DeadCodeEliminator::isUnused(const ASTVariableDeclaration& declaration, bool insideLoop) {
+    return !insideLoop && uses[declaration.name] == 0 && declarations[declaration.name] == 1
+        && isSafe(declaration.value.get());
+}
+
+void DeadCodeEliminator::removed(const ASTBase& statement) {
+    statistics.removedNodes += countNodes(&statement);
+    changed = true;
+}
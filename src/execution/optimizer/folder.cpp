@@ -0,0 +1,308 @@
+#include "include/folder.hpp"
+#include "include/analysis.hpp"
+#include "../include/evaluator.hpp"
+#include "../../errors/include/errors.hpp"
+
+static bool isConstant(const std::unique_ptr<ASTBase>& expression) {
+    return expression != nullptr && expression->type == ASTType::Value;
+}
+
+static const Value& constantOf(const std::unique_ptr<ASTBase>& expression) {
+    return static_cast<const ASTValue*>(expression.get())->constant;
+}
+
+// Whether moving the body into the enclosing one would change what its names refer to.
+static bool declaresNames(const std::vector<std::unique_ptr<ASTBase>>& body) {
+    for (const std::unique_ptr<ASTBase>& statement : body) {
+        if (statement == nullptr) continue;
+        if (statement->type == ASTType::VariableDeclaration || statement->type == ASTType::FunctionDeclaration) return true;
+    }
+    return false;
+}
+
+void ConstantFolder::fold(ASTProgram& program) {
+    variables.clear();
+    std::unordered_set<std::string> declared;
+    collectVariables(program.body, declared);
+
+    scopes.assign(1, Scope());
+    evaluator.callable.clear();
+    inFunction = false;
+    program.body = foldBody(program.body);
+    scopes.clear();
+}
+
+void ConstantFolder::collectVariables(const std::vector<std::unique_ptr<ASTBase>>& body, std::unordered_set<std::string>& declared) {
+    for (const std::unique_ptr<ASTBase>& statement : body) {
+        if (statement == nullptr) continue;
+
+        switch (statement->type) {
+            case ASTType::FunctionDeclaration: {
+                const auto& function = static_cast<const ASTFunction&>(*statement);
+                for (const std::unique_ptr<ASTBase>& argument : function.arguments) {
+                    variables.insert(static_cast<const ASTFunctionArgument*>(argument.get())->name);
+                }
+                collectVariables(function.body, declared);
+                break;
+            }
+            case ASTType::VariableDeclaration: {
+                const std::string& name = static_cast<const ASTVariableDeclaration&>(*statement).name;
+                if (!declared.insert(name).second) variables.insert(name);
+                break;
+            }
+            case ASTType::VariableModify:
+                variables.insert(static_cast<const ASTVariableModify&>(*statement).name);
+                break;
+            case ASTType::Condition: {
+                const auto& condition = static_cast<const ASTCondition&>(*statement);
+                collectVariables(condition.body, declared);
+                collectVariables(condition.elseBody, declared);
+                break;
+            }
+            case ASTType::While:
+                collectVariables(static_cast<const ASTWhile&>(*statement).body, declared);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+std::vector<std::unique_ptr<ASTBase>> ConstantFolder::foldBody(std::vector<std::unique_ptr<ASTBase>>& body) {
+    std::vector<std::unique_ptr<ASTBase>> result;
+    result.reserve(body.size());
+    for (std::unique_ptr<ASTBase>& statement : body) {
+        if (statement != nullptr) foldStatement(statement, result);
+    }
+    return result;
+}
+
+void ConstantFolder::foldStatement(std::unique_ptr<ASTBase>& statement, std::vector<std::unique_ptr<ASTBase>>& result) {
+    switch (statement->type) {
+        case ASTType::FunctionDeclaration:
+            foldFunction(static_cast<ASTFunction&>(*statement));
+            break;
+        case ASTType::VariableDeclaration: {
+            auto& declaration = static_cast<ASTVariableDeclaration&>(*statement);
+            foldExpression(declaration.value);
+            if (isConstant(declaration.value) && variables.count(declaration.name) == 0
+                && constantOf(declaration.value).type() == declaration.varType) {
+                scopes.back()[declaration.name] = { declaration.slot, constantOf(declaration.value) };
+            }
+            break;
+        }
+        case ASTType::VariableModify:
+            foldExpression(static_cast<ASTVariableModify&>(*statement).value);
+            break;
+        case ASTType::Print:
+            foldExpression(static_cast<ASTPrint&>(*statement).expression);
+            break;
+        case ASTType::Condition:
+            foldCondition(statement, result);
+            return;
+        case ASTType::While: {
+            // The condition and the body share a single scope, like in the resolver.
+            auto& loop = static_cast<ASTWhile&>(*statement);
+            scopes.emplace_back();
+            foldExpression(loop.value);
+            loop.body = foldBody(loop.body);
+            scopes.pop_back();
+            if (isConstant(loop.value) && !constantOf(loop.value).isTruthy()) {
+                statistics.prunedBranches++;
+                return;
+            }
+            break;
+        }
+        default:
+            // Expression statements are kept as they are, only their operands are folded.
+            foldOperands(*statement);
+            break;
+    }
+    result.push_back(std::move(statement));
+}
+
+void ConstantFolder::foldCondition(std::unique_ptr<ASTBase>& statement, std::vector<std::unique_ptr<ASTBase>>& result) {
+    auto& condition = static_cast<ASTCondition&>(*statement);
+    foldExpression(condition.expression);
+    scopes.emplace_back();
+    condition.body = foldBody(condition.body);
+    scopes.pop_back();
+    scopes.emplace_back();
+    condition.elseBody = foldBody(condition.elseBody);
+    scopes.pop_back();
+
+    if (!isConstant(condition.expression)) {
+        result.push_back(std::move(statement));
+        return;
+    }
+
+    const bool status = constantOf(condition.expression).isTruthy();
+    std::vector<std::unique_ptr<ASTBase>>& taken = status ? condition.body : condition.elseBody;
+    std::vector<std::unique_ptr<ASTBase>>& skipped = status ? condition.elseBody : condition.body;
+    if (!declaresNames(taken)) {
+        // Without declarations the block of the branch makes no difference.
+        statistics.prunedBranches++;
+        for (std::unique_ptr<ASTBase>& child : taken) {
+            result.push_back(std::move(child));
+        }
+        return;
+    }
+    if (!skipped.empty()) {
+        statistics.prunedBranches++;
+        skipped.clear();
+    }
+    result.push_back(std::move(statement));
+}
+
+void ConstantFolder::foldFunction(ASTFunction& function) {
+    function.pure = isPure(function);
+    if (function.pure) statistics.pureFunctions++;
+    // Declarations at the top level run before everything after them, the function's own body included.
+    if (!inFunction && scopes.size() == 1) evaluator.callable.insert(&function);
+
+    // Reads from the enclosing functions are never propagated, so the body starts without constants.
+    std::vector<Scope> enclosing = std::move(scopes);
+    const bool enclosingFunction = inFunction;
+    scopes.assign(1, Scope());
+    inFunction = true;
+    function.body = foldBody(function.body);
+    scopes = std::move(enclosing);
+    inFunction = enclosingFunction;
+}
+
+void ConstantFolder::foldOperands(ASTBase& expression) {
+    switch (expression.type) {
+        case ASTType::ReadInput:
+            foldExpression(static_cast<ASTReadInput&>(expression).out);
+            break;
+        case ASTType::TypeCast:
+            foldExpression(static_cast<ASTTypeCast&>(expression).value);
+            break;
+        case ASTType::FString:
+            for (std::unique_ptr<ASTBase>& part : static_cast<ASTFString&>(expression).parts) {
+                foldExpression(part);
+            }
+            break;
+        case ASTType::BinaryOperation: {
+            auto& operation = static_cast<ASTBinaryOperation&>(expression);
+            foldExpression(operation.left);
+            foldExpression(operation.right);
+            break;
+        }
+        case ASTType::ComparisonOperation: {
+            auto& operation = static_cast<ASTComparisonOperation&>(expression);
+            foldExpression(operation.left);
+            foldExpression(operation.right);
+            break;
+        }
+        case ASTType::AndOperation: {
+            auto& operation = static_cast<ASTAndOperation&>(expression);
+            foldExpression(operation.left);
+            foldExpression(operation.right);
+            break;
+        }
+        case ASTType::OrOperation: {
+            auto& operation = static_cast<ASTOrOperation&>(expression);
+            foldExpression(operation.left);
+            foldExpression(operation.right);
+            break;
+        }
+        case ASTType::FunctionCall:
+            for (std::unique_ptr<ASTBase>& argument : static_cast<ASTFunctionCall&>(expression).arguments) {
+                foldExpression(argument);
+            }
+            break;
+        case ASTType::Return:
+            foldExpression(static_cast<ASTReturn&>(expression).value);
+            break;
+        default:
+            break;
+    }
+}
+
+void ConstantFolder::foldExpression(std::unique_ptr<ASTBase>& expression) {
+    if (expression == nullptr) return;
+    foldOperands(*expression);
+
+    try {
+        switch (expression->type) {
+            case ASTType::Variable: {
+                // Only reads within the function of the declaration are known to run after it.
+                const auto variable = static_cast<const ASTVariable*>(expression.get());
+                if (variable->binding.depth != 0) return;
+                const Constant* constant = lookup(variable->name);
+                if (constant == nullptr || constant->slot != variable->binding.slot) return;
+                statistics.propagatedConstants++;
+                replace(expression, constant->value);
+                return;
+            }
+            case ASTType::TypeCast: {
+                const auto typeCast = static_cast<const ASTTypeCast*>(expression.get());
+                if (!isConstant(typeCast->value)) return;
+                replace(expression, castValue(constantOf(typeCast->value), typeCast->castType));
+                break;
+            }
+            case ASTType::BinaryOperation: {
+                const auto operation = static_cast<const ASTBinaryOperation*>(expression.get());
+                if (!isConstant(operation->left) || !isConstant(operation->right)) return;
+                replace(expression, calculateValue(constantOf(operation->left), constantOf(operation->right), operation->op));
+                break;
+            }
+            case ASTType::ComparisonOperation: {
+                const auto operation = static_cast<const ASTComparisonOperation*>(expression.get());
+                if (!isConstant(operation->left) || !isConstant(operation->right)) return;
+                replace(expression, compareValue(constantOf(operation->left), constantOf(operation->right), operation->op));
+                break;
+            }
+            case ASTType::AndOperation: {
+                // The result is the left operand when it is falsy and the right one otherwise.
+                const auto operation = static_cast<ASTAndOperation*>(expression.get());
+                if (!isConstant(operation->left)) return;
+                std::unique_ptr<ASTBase> result = std::move(constantOf(operation->left).isTruthy() ? operation->right : operation->left);
+                expression = std::move(result);
+                break;
+            }
+            case ASTType::OrOperation: {
+                const auto operation = static_cast<ASTOrOperation*>(expression.get());
+                if (!isConstant(operation->left)) return;
+                std::unique_ptr<ASTBase> result = std::move(constantOf(operation->left).isTruthy() ? operation->left : operation->right);
+                expression = std::move(result);
+                break;
+            }
+            case ASTType::FunctionCall: {
+                const auto call = static_cast<const ASTFunctionCall*>(expression.get());
+                if (call->function == nullptr) return;
+                std::vector<Value> arguments;
+                for (const std::unique_ptr<ASTBase>& argument : call->arguments) {
+                    if (!isConstant(argument)) return;
+                    arguments.push_back(constantOf(argument));
+                }
+                Value result;
+                if (!evaluator.evaluate(*call->function, std::move(arguments), result)) return;
+                statistics.evaluatedCalls++;
+                replace(expression, result);
+                return;
+            }
+            default:
+                return;
+        }
+    } catch (const ZynkError&) {
+        // The operation fails whenever it runs, which is left for the runtime to report.
+        return;
+    }
+    statistics.foldedExpressions++;
+}
+
+void ConstantFolder::replace(std::unique_ptr<ASTBase>& expression, const Value& value) {
+    auto constant = std::make_unique<ASTValue>(value, value.type(), expression->line);
+    constant->staticType = value.type();
+    expression = std::move(constant);
+}
+
+const ConstantFolder::Constant* ConstantFolder::lookup(const std::string& name) const {
+    for (auto scope = scopes.rbegin(); scope != scopes.rend(); ++scope) {
+        auto found = scope->find(name);
+        if (found != scope->end()) return &found->second;
+    }
+    return nullptr;
+}
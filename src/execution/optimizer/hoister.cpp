@@ -0,0 +1,287 @@
+#include "include/hoister.hpp"
+#include "include/analysis.hpp"
+
+static void collectNames(const ASTBase* node, std::unordered_set<std::string>& names) {
+    if (node == nullptr) return;
+
+    switch (node->type) {
+        case ASTType::VariableDeclaration:
+            names.insert(static_cast<const ASTVariableDeclaration*>(node)->name);
+            break;
+        case ASTType::FunctionArgument:
+            names.insert(static_cast<const ASTFunctionArgument*>(node)->name);
+            break;
+        case ASTType::Variable:
+            names.insert(static_cast<const ASTVariable*>(node)->name);
+            break;
+        default:
+            break;
+    }
+    forEachChild(*node, [&names](const ASTBase* child) { collectNames(child, names); });
+}
+
+void InvariantHoister::hoist(ASTProgram& program) {
+    names.clear();
+    pure.clear();
+    collectNames(&program, names);
+
+    frameSize = &program.frameSize;
+    loopDepth = 0;
+    hoistBody(program.body);
+}
+
+void InvariantHoister::hoistBody(std::vector<std::unique_ptr<ASTBase>>& body) {
+    std::vector<std::unique_ptr<ASTBase>> result;
+    result.reserve(body.size());
+
+    for (std::unique_ptr<ASTBase>& statement : body) {
+        if (statement == nullptr) continue;
+
+        switch (statement->type) {
+            case ASTType::FunctionDeclaration: {
+                auto& function = static_cast<ASTFunction&>(*statement);
+                size_t* enclosingFrameSize = frameSize;
+                const size_t enclosingLoopDepth = loopDepth;
+                frameSize = &function.frameSize;
+                loopDepth = 0;
+                hoistBody(function.body);
+                frameSize = enclosingFrameSize;
+                loopDepth = enclosingLoopDepth;
+                break;
+            }
+            case ASTType::Condition: {
+                auto& condition = static_cast<ASTCondition&>(*statement);
+                hoistBody(condition.body);
+                hoistBody(condition.elseBody);
+                break;
+            }
+            case ASTType::While:
+                hoistLoop(statement, result);
+                continue;
+            default:
+                break;
+        }
+        result.push_back(std::move(statement));
+    }
+    body = std::move(result);
+}
+
+void InvariantHoister::hoistLoop(std::unique_ptr<ASTBase>& statement, std::vector<std::unique_ptr<ASTBase>>& result) {
+    auto& whileStatement = static_cast<ASTWhile&>(*statement);
+
+    // Inner loops go first, what they hoist can then move further out.
+    loopDepth++;
+    hoistBody(whileStatement.body);
+    loopDepth--;
+
+    Loop loop;
+    collectAssigned(&whileStatement, loop);
+    if (loop.callsAssigning) {
+        result.push_back(std::move(statement));
+        return;
+    }
+
+    bool clean = true;
+    hoistExpression(whileStatement.value, loop, true, clean, false);
+    clean = isSafe(whileStatement.value.get());
+    hoistStatements(whileStatement.body, loop, true, clean);
+    if (loop.preheader.empty() && loop.guarded.empty()) {
+        result.push_back(std::move(statement));
+        return;
+    }
+    statistics.hoistedLoops++;
+    statistics.hoistedExpressions += loop.preheader.size() + loop.guarded.size();
+
+    const size_t line = whileStatement.line;
+    if (!loop.guarded.empty()) {
+        auto guard = std::make_unique<ASTCondition>(copyExpression(*whileStatement.value), line);
+        guard->body = std::move(loop.guarded);
+        guard->body.push_back(std::move(statement));
+        statement = std::move(guard);
+    }
+    if (loopDepth == 0) {
+        for (std::unique_ptr<ASTBase>& declaration : loop.preheader) {
+            result.push_back(std::move(declaration));
+        }
+        result.push_back(std::move(statement));
+        return;
+    }
+    // In a loop the temporaries need a block of their own, declaring them again would fail.
+    auto block = std::make_unique<ASTCondition>(std::make_unique<ASTValue>(Value::fromBool(true), ASTValueType::Bool, line), line);
+    block->expression->staticType = ASTValueType::Bool;
+    block->body = std::move(loop.preheader);
+    block->body.push_back(std::move(statement));
+    result.push_back(std::move(block));
+}
+
+void InvariantHoister::collectAssigned(const ASTBase* node, Loop& loop) {
+    if (node == nullptr) return;
+
+    switch (node->type) {
+        case ASTType::FunctionDeclaration:
+            // Runs only when called, which is checked at the calls.
+            return;
+        case ASTType::VariableDeclaration:
+            loop.assigned.insert(static_cast<const ASTVariableDeclaration*>(node)->slot);
+            break;
+        case ASTType::VariableModify: {
+            const ASTBinding& binding = static_cast<const ASTVariableModify*>(node)->binding;
+            if (binding.depth == 0) loop.assigned.insert(binding.slot);
+            break;
+        }
+        case ASTType::FunctionCall: {
+            const ASTFunction* function = static_cast<const ASTFunctionCall*>(node)->function;
+            if (function == nullptr || assignsEnclosing(*function)) loop.callsAssigning = true;
+            break;
+        }
+        default:
+            break;
+    }
+    forEachChild(*node, [this, &loop](const ASTBase* child) { collectAssigned(child, loop); });
+}
+
+void InvariantHoister::hoistStatements(std::vector<std::unique_ptr<ASTBase>>& body, Loop& loop, bool unconditional, bool& clean) {
+    for (std::unique_ptr<ASTBase>& statement : body) {
+        if (statement == nullptr) continue;
+
+        switch (statement->type) {
+            case ASTType::VariableDeclaration:
+                hoistExpression(static_cast<ASTVariableDeclaration&>(*statement).value, loop, unconditional, clean, true);
+                // Declaring can fail as a duplicate.
+                clean = false;
+                break;
+            case ASTType::VariableModify: {
+                auto& variableModify = static_cast<ASTVariableModify&>(*statement);
+                hoistExpression(variableModify.value, loop, unconditional, clean, true);
+                // Assigning isn't observable, unless the variable of an enclosing function isn't declared yet.
+                if (variableModify.binding.depth != 0) clean = false;
+                break;
+            }
+            case ASTType::Print:
+                hoistExpression(static_cast<ASTPrint&>(*statement).expression, loop, unconditional, clean, true);
+                clean = false;
+                break;
+            case ASTType::Condition: {
+                auto& condition = static_cast<ASTCondition&>(*statement);
+                hoistExpression(condition.expression, loop, unconditional, clean, true);
+                bool branch = false;
+                hoistStatements(condition.body, loop, false, branch);
+                hoistStatements(condition.elseBody, loop, false, branch);
+                clean = false;
+                break;
+            }
+            case ASTType::While: {
+                auto& inner = static_cast<ASTWhile&>(*statement);
+                hoistExpression(inner.value, loop, unconditional, clean, true);
+                bool iteration = false;
+                hoistStatements(inner.body, loop, false, iteration);
+                clean = false;
+                break;
+            }
+            case ASTType::FunctionDeclaration:
+            case ASTType::Break:
+                clean = false;
+                break;
+            default:
+                // Expression statements stay, their operands can move.
+                forEachOperand(*statement, [&](std::unique_ptr<ASTBase>& operand) {
+                    hoistExpression(operand, loop, unconditional, clean, true);
+                });
+                clean = false;
+                break;
+        }
+    }
+}
+
+void InvariantHoister::hoistExpression(std::unique_ptr<ASTBase>& expression, Loop& loop, bool unconditional, bool& clean, bool guarded) {
+    if (expression == nullptr) return;
+
+    if (isHoistable(*expression, loop)) {
+        if (isSafe(expression.get())) {
+            moveOut(expression, loop.preheader);
+            return;
+        }
+        if (unconditional && clean) {
+            moveOut(expression, guarded ? loop.guarded : loop.preheader);
+            return;
+        }
+    }
+
+    if (expression->type == ASTType::AndOperation || expression->type == ASTType::OrOperation) {
+        // The right operand is only evaluated depending on the left one.
+        bool right = false;
+        forEachOperand(*expression, [&](std::unique_ptr<ASTBase>& operand) {
+            hoistExpression(operand, loop, unconditional && !right, clean, guarded);
+            right = true;
+        });
+    } else {
+        forEachOperand(*expression, [&](std::unique_ptr<ASTBase>& operand) {
+            hoistExpression(operand, loop, unconditional, clean, guarded);
+        });
+    }
+    // Whatever follows could be skipped by an error here, or see its effects.
+    if (!isSafe(expression.get())) clean = false;
+}
+
+bool InvariantHoister::isInvariant(ASTBase& expression, const Loop& loop) {
+    switch (expression.type) {
+        case ASTType::Value:
+            return true;
+        case ASTType::Variable: {
+            const ASTBinding& binding = static_cast<const ASTVariable&>(expression).binding;
+            return binding.depth == 0 && loop.assigned.count(binding.slot) == 0;
+        }
+        case ASTType::ReadInput:
+            return false;
+        case ASTType::FunctionCall:
+            if (!isPureFunction(static_cast<const ASTFunctionCall&>(expression).function)) return false;
+            break;
+        case ASTType::TypeCast:
+        case ASTType::FString:
+        case ASTType::BinaryOperation:
+        case ASTType::ComparisonOperation:
+        case ASTType::AndOperation:
+        case ASTType::OrOperation:
+            break;
+        default:
+            return false;
+    }
+
+    bool invariant = true;
+    forEachOperand(expression, [&](std::unique_ptr<ASTBase>& operand) {
+        invariant = invariant && operand != nullptr && isInvariant(*operand, loop);
+    });
+    return invariant;
+}
+
+bool InvariantHoister::isHoistable(ASTBase& expression, const Loop& loop) {
+    return expression.type != ASTType::Value && expression.type != ASTType::Variable && isInvariant(expression, loop);
+}
+
+bool InvariantHoister::isPureFunction(const ASTFunction* function) {
+    if (function == nullptr) return false;
+
+    auto found = pure.find(function);
+    if (found == pure.end()) found = pure.emplace(function, isPure(*function)).first;
+    return found->second;
+}
+
+void InvariantHoister::moveOut(std::unique_ptr<ASTBase>& expression, std::vector<std::unique_ptr<ASTBase>>& preheader) {
+    std::string name;
+    do {
+        name = "__invariant" + std::to_string(temporaries++);
+    } while (names.count(name) != 0);
+
+    const size_t line = expression->line;
+    const ASTValueType type = expression->staticType;
+    const size_t slot = (*frameSize)++;
+
+    auto declaration = std::make_unique<ASTVariableDeclaration>(name, type, std::move(expression), line);
+    declaration->slot = slot;
+    preheader.push_back(std::move(declaration));
+
+    auto variable = std::make_unique<ASTVariable>(name, line);
+    variable->binding = { 0, slot, type, true };
+    variable->staticType = type;
+    expression = std::move(variable);
+}
@@ -0,0 +1,119 @@
+#ifndef ANALYSIS_H
+#define ANALYSIS_H
+
+#include "../../../parsing/include/ast.hpp"
+
+// Calls visit with every operand of the expression, in the order they are evaluated.
+template <typename Visit>
+void forEachOperand(ASTBase& expression, Visit&& visit) {
+    switch (expression.type) {
+        case ASTType::ReadInput:
+            visit(static_cast<ASTReadInput&>(expression).out);
+            break;
+        case ASTType::TypeCast:
+            visit(static_cast<ASTTypeCast&>(expression).value);
+            break;
+        case ASTType::FString:
+            for (std::unique_ptr<ASTBase>& part : static_cast<ASTFString&>(expression).parts) visit(part);
+            break;
+        case ASTType::BinaryOperation: {
+            auto& operation = static_cast<ASTBinaryOperation&>(expression);
+            visit(operation.left);
+            visit(operation.right);
+            break;
+        }
+        case ASTType::ComparisonOperation: {
+            auto& operation = static_cast<ASTComparisonOperation&>(expression);
+            visit(operation.left);
+            visit(operation.right);
+            break;
+        }
+        case ASTType::AndOperation: {
+            auto& operation = static_cast<ASTAndOperation&>(expression);
+            visit(operation.left);
+            visit(operation.right);
+            break;
+        }
+        case ASTType::OrOperation: {
+            auto& operation = static_cast<ASTOrOperation&>(expression);
+            visit(operation.left);
+            visit(operation.right);
+            break;
+        }
+        case ASTType::FunctionCall:
+            for (std::unique_ptr<ASTBase>& argument : static_cast<ASTFunctionCall&>(expression).arguments) visit(argument);
+            break;
+        case ASTType::Return:
+            visit(static_cast<ASTReturn&>(expression).value);
+            break;
+        default:
+            break;
+    }
+}
+
+// Calls visit with every child of the node, statements of bodies included.
+template <typename Visit>
+void forEachChild(const ASTBase& node, Visit&& visit) {
+    const auto visitAll = [&visit](const std::vector<std::unique_ptr<ASTBase>>& nodes) {
+        for (const std::unique_ptr<ASTBase>& child : nodes) visit(child.get());
+    };
+
+    switch (node.type) {
+        case ASTType::Program:
+            visitAll(static_cast<const ASTProgram&>(node).body);
+            break;
+        case ASTType::FunctionDeclaration:
+            visitAll(static_cast<const ASTFunction&>(node).arguments);
+            visitAll(static_cast<const ASTFunction&>(node).body);
+            break;
+        case ASTType::VariableDeclaration:
+            visit(static_cast<const ASTVariableDeclaration&>(node).value.get());
+            break;
+        case ASTType::VariableModify:
+            visit(static_cast<const ASTVariableModify&>(node).value.get());
+            break;
+        case ASTType::Print:
+            visit(static_cast<const ASTPrint&>(node).expression.get());
+            break;
+        case ASTType::Condition: {
+            const auto& condition = static_cast<const ASTCondition&>(node);
+            visit(condition.expression.get());
+            visitAll(condition.body);
+            visitAll(condition.elseBody);
+            break;
+        }
+        case ASTType::While:
+            visit(static_cast<const ASTWhile&>(node).value.get());
+            visitAll(static_cast<const ASTWhile&>(node).body);
+            break;
+        default:
+            // Expressions don't change through visiting their operands.
+            forEachOperand(const_cast<ASTBase&>(node), [&visit](const std::unique_ptr<ASTBase>& operand) {
+                visit(operand.get());
+            });
+            break;
+    }
+}
+
+// Whether evaluating the expression has no effects and can't raise an error, so the
+// optimizer may drop it or evaluate it at another point of the program.
+bool isSafe(const ASTBase* expression);
+
+// Whether the function computes its result from its arguments alone: neither it nor the functions
+// it calls print, read input or use variables of enclosing functions. It can still fail.
+bool isPure(const ASTFunction& function);
+
+// Whether the function, or a function it calls, assigns variables of enclosing functions.
+bool assignsEnclosing(const ASTFunction& function);
+
+// Whether the function calls itself, directly or through the functions it calls.
+bool isRecursive(const ASTFunction& function);
+
+// Clones a checked expression, keeping the types and the called declarations the checker
+// cached in its nodes, which clone() leaves out.
+std::unique_ptr<ASTBase> copyExpression(ASTBase& expression);
+
+// Number of nodes in the tree, the node itself included.
+size_t countNodes(const ASTBase* node);
+
+#endif // ANALYSIS_H
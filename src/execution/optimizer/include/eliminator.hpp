@@ -0,0 +1,30 @@
+#ifndef ELIMINATOR_H
+#define ELIMINATOR_H
+
+#include "optimizer.hpp"
+#include <unordered_map>
+
+// Removes statements that can never run, because they follow a return or a break, declarations
+// of variables that are never used and whose value is safe to skip, and empty branches.
+class DeadCodeEliminator {
+public:
+    explicit DeadCodeEliminator(OptimizerStatistics& statistics) : statistics(statistics) {}
+
+    void eliminate(ASTProgram& program);
+private:
+    OptimizerStatistics& statistics;
+    // Reads and assignments, and declarations of every name in the program.
+    std::unordered_map<std::string, size_t> uses;
+    std::unordered_map<std::string, size_t> declarations;
+    bool changed = false;
+
+    void countBody(const std::vector<std::unique_ptr<ASTBase>>& body);
+    void countNode(const ASTBase* node);
+
+    void eliminateBody(std::vector<std::unique_ptr<ASTBase>>& body, bool insideLoop);
+    // Whether the declaration can be dropped. In a loop it fails as a duplicate on the second iteration.
+    bool isUnused(const ASTVariableDeclaration& declaration, bool insideLoop);
+    void removed(const ASTBase& statement);
+};
+
+#endif // ELIMINATOR_H
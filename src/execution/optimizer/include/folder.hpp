@@ -0,0 +1,48 @@
+#ifndef FOLDER_H
+#define FOLDER_H
+
+#include "optimizer.hpp"
+#include "partial.hpp"
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// Evaluates operations on constants ahead of time, replaces reads of variables that are
+// never reassigned with their constant initializers, and drops branches that can't be taken.
+// Calls of pure functions declared at the top level, with constant arguments, are run ahead of time.
+// Operations that would raise an error are left for the runtime to report.
+class ConstantFolder {
+public:
+    explicit ConstantFolder(OptimizerStatistics& statistics) : statistics(statistics) {}
+
+    void fold(ASTProgram& program);
+private:
+    struct Constant {
+        size_t slot;
+        Value value;
+    };
+    using Scope = std::unordered_map<std::string, Constant>;
+
+    OptimizerStatistics& statistics;
+    // Names that are assigned, declared more than once or taken as arguments anywhere.
+    // Reads of them are never propagated.
+    std::unordered_set<std::string> variables;
+    // Constants visible in the function being folded, in the scopes of the resolver.
+    std::vector<Scope> scopes;
+    PartialEvaluator evaluator;
+    bool inFunction = false; // Whether the body being folded belongs to a function.
+
+    void collectVariables(const std::vector<std::unique_ptr<ASTBase>>& body, std::unordered_set<std::string>& declared);
+
+    std::vector<std::unique_ptr<ASTBase>> foldBody(std::vector<std::unique_ptr<ASTBase>>& body);
+    void foldStatement(std::unique_ptr<ASTBase>& statement, std::vector<std::unique_ptr<ASTBase>>& result);
+    void foldCondition(std::unique_ptr<ASTBase>& statement, std::vector<std::unique_ptr<ASTBase>>& result);
+    void foldFunction(ASTFunction& function);
+    void foldOperands(ASTBase& expression);
+    // Folds the operands, then replaces the expression with its value if it is known.
+    void foldExpression(std::unique_ptr<ASTBase>& expression);
+    void replace(std::unique_ptr<ASTBase>& expression, const Value& value);
+    const Constant* lookup(const std::string& name) const;
+};
+
+#endif // FOLDER_H
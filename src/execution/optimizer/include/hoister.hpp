@@ -0,0 +1,51 @@
+#ifndef HOISTER_H
+#define HOISTER_H
+
+#include "optimizer.hpp"
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// Moves expressions that give the same value on every iteration of a while loop into
+// temporaries declared before it. Expressions that can fail move only if nothing observable
+// happens before they are evaluated in an iteration: from the condition, which runs at least
+// once, or from the start of the body, behind a copy of the condition when it is safe.
+class InvariantHoister {
+public:
+    explicit InvariantHoister(OptimizerStatistics& statistics) : statistics(statistics) {}
+
+    void hoist(ASTProgram& program);
+private:
+    struct Loop {
+        // Slots the loop assigns or declares in the function it is in.
+        std::unordered_set<size_t> assigned;
+        bool callsAssigning = false; // Calls a function assigning variables of enclosing functions.
+        std::vector<std::unique_ptr<ASTBase>> preheader;
+        // Temporaries evaluated only when the loop runs at least once.
+        std::vector<std::unique_ptr<ASTBase>> guarded;
+    };
+
+    OptimizerStatistics& statistics;
+    std::unordered_set<std::string> names; // Names in the program, temporaries don't reuse them.
+    std::unordered_map<const ASTFunction*, bool> pure;
+    size_t* frameSize = nullptr; // Of the function being optimized, temporaries get new slots.
+    size_t loopDepth = 0; // Loops around the body being optimized, within its function.
+    size_t temporaries = 0;
+
+    void hoistBody(std::vector<std::unique_ptr<ASTBase>>& body);
+    void hoistLoop(std::unique_ptr<ASTBase>& statement, std::vector<std::unique_ptr<ASTBase>>& result);
+    void collectAssigned(const ASTBase* node, Loop& loop);
+
+    // Hoists from the statements, and from the expression. While `clean` holds, nothing observable
+    // was evaluated yet in the iteration, `unconditional` tells if the code runs in every iteration.
+    void hoistStatements(std::vector<std::unique_ptr<ASTBase>>& body, Loop& loop, bool unconditional, bool& clean);
+    void hoistExpression(std::unique_ptr<ASTBase>& expression, Loop& loop, bool unconditional, bool& clean, bool guarded);
+
+    bool isInvariant(ASTBase& expression, const Loop& loop);
+    // Invariant, and worth a temporary.
+    bool isHoistable(ASTBase& expression, const Loop& loop);
+    bool isPureFunction(const ASTFunction* function);
+    void moveOut(std::unique_ptr<ASTBase>& expression, std::vector<std::unique_ptr<ASTBase>>& preheader);
+};
+
+#endif // HOISTER_H
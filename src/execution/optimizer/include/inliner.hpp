@@ -0,0 +1,40 @@
+#ifndef INLINER_H
+#define INLINER_H
+
+#include "optimizer.hpp"
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// Replaces calls of small non-recursive functions, whose body is a single `return` of an
+// expression, with that expression, the arguments taking the place of the parameters.
+// The inlined nodes keep the lines of the function, so errors point where they did before.
+class FunctionInliner {
+public:
+    FunctionInliner(OptimizerStatistics& statistics, size_t budget) : statistics(statistics), budget(budget) {}
+
+    void inlineCalls(ASTProgram& program);
+private:
+    OptimizerStatistics& statistics;
+    const size_t budget; // Largest inlined expression, in nodes.
+    // Functions whose declaration runs before the code being optimized, so calls can't fail to find them.
+    std::vector<const ASTFunction*> declared;
+    // Returned expression of every function seen, null if the function can't be inlined.
+    std::unordered_map<const ASTFunction*, ASTBase*> inlinable;
+    std::unordered_set<const ASTFunction*> inlined;
+
+    void inlineBody(std::vector<std::unique_ptr<ASTBase>>& body);
+    // Inlines the calls in the operands of the expression, then the expression itself if it is a call.
+    void inlineExpression(std::unique_ptr<ASTBase>& expression);
+    void inlineOperands(ASTBase& expression);
+    bool inlineCall(std::unique_ptr<ASTBase>& expression);
+
+    ASTBase* returnedExpression(const ASTFunction& function);
+    bool isInlinable(const ASTBase* node, const ASTFunction& function) const;
+    // Whether the arguments can take the place of the parameters: each one is evaluated once and
+    // before anything in the body that could fail or be observed, unless it is safe to evaluate anyway.
+    // Counts the reads of every parameter into `uses`.
+    bool canSubstitute(ASTBase& body, const ASTFunction& function, const ASTFunctionCall& call, std::vector<size_t>& uses) const;
+};
+
+#endif // INLINER_H
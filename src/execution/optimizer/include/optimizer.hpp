@@ -0,0 +1,44 @@
+#ifndef OPTIMIZER_H
+#define OPTIMIZER_H
+
+#include "../../../parsing/include/ast.hpp"
+#include <string>
+
+// What the passes of the optimizer changed in a program.
+struct OptimizerStatistics {
+    size_t foldedExpressions = 0;
+    size_t propagatedConstants = 0;
+    size_t prunedBranches = 0;
+    size_t unreachableStatements = 0;
+    size_t unusedDeclarations = 0;
+    size_t emptyBranches = 0;
+    size_t removedNodes = 0; // In total, by dead code elimination.
+    size_t hoistedExpressions = 0;
+    size_t hoistedLoops = 0;
+    size_t countedLoops = 0;
+    size_t inlinedCalls = 0;
+    size_t inlinedFunctions = 0;
+    size_t pureFunctions = 0;
+    size_t evaluatedCalls = 0; // Calls of pure functions evaluated ahead of time.
+
+    // One line per pass, as printed by --dump-optimized and --diagnostics.
+    std::string summary() const;
+};
+
+// Largest function body, in nodes, the optimizer inlines unless told otherwise.
+constexpr size_t DEFAULT_INLINE_BUDGET = 16;
+
+// Rewrites a resolved and type checked program into a cheaper one that behaves the same,
+// including the errors it raises and their lines. Runs before the program is executed.
+class Optimizer {
+public:
+    // Functions with larger bodies than the budget are never inlined, 0 disables inlining.
+    explicit Optimizer(size_t inlineBudget = DEFAULT_INLINE_BUDGET) : inlineBudget(inlineBudget) {}
+
+    OptimizerStatistics statistics;
+    const size_t inlineBudget;
+
+    void optimize(ASTProgram& program);
+};
+
+#endif // OPTIMIZER_H
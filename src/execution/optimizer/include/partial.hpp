@@ -0,0 +1,50 @@
+#ifndef PARTIAL_H
+#define PARTIAL_H
+
+#include "optimizer.hpp"
+#include "../../include/evaluator.hpp"
+#include <unordered_set>
+#include <vector>
+
+// Most statements and expressions evaluated for a single call ahead of time.
+constexpr size_t DEFAULT_EVALUATION_BUDGET = 10000;
+
+// Runs calls of pure functions with constant arguments while the program is optimized,
+// with the semantics of the evaluator. Gives up on anything whose outcome only the runtime
+// can report faithfully: errors, running out of steps, and constructs it doesn't model.
+class PartialEvaluator {
+public:
+    explicit PartialEvaluator(size_t budget = DEFAULT_EVALUATION_BUDGET) : budget(budget) {}
+
+    // Functions whose declaration runs before the calls being evaluated. Only these are called.
+    std::unordered_set<const ASTFunction*> callable;
+
+    // Calls the function with the arguments. Returns false, leaving the result alone, if the call
+    // can't be evaluated ahead of time.
+    bool evaluate(const ASTFunction& function, std::vector<Value> arguments, Value& result);
+private:
+    // Thrown to give up on the call being evaluated.
+    struct Unsupported {};
+
+    struct Frame {
+        std::vector<Value> values;
+        std::vector<bool> declared;
+        std::vector<std::vector<size_t>> blocks; // Slots declared in every block in progress.
+    };
+
+    const size_t budget;
+    size_t steps = 0;
+    std::vector<Frame> frames;
+
+    void step();
+    Value callFunction(const ASTFunction& function, std::vector<Value> arguments);
+    Completion execute(const ASTBase& statement);
+    Completion executeBlock(const std::vector<std::unique_ptr<ASTBase>>& body);
+    Completion executeBody(const std::vector<std::unique_ptr<ASTBase>>& body);
+    // Undeclares the variables of the innermost block of the current frame.
+    void exitBlock();
+    Value evaluateExpression(const ASTBase* expression);
+    Value evaluateCall(const ASTFunctionCall& call);
+};
+
+#endif // PARTIAL_H
@@ -0,0 +1,23 @@
+#ifndef RECOGNIZER_H
+#define RECOGNIZER_H
+
+#include "optimizer.hpp"
+#include <unordered_map>
+
+// Marks while loops that step an int counter up or down to a bound, so the engines can run
+// them as counted loops. See ASTCountedLoop for the shape they have to be in.
+class CountedLoopRecognizer {
+public:
+    explicit CountedLoopRecognizer(OptimizerStatistics& statistics) : statistics(statistics) {}
+
+    void recognize(ASTProgram& program);
+private:
+    OptimizerStatistics& statistics;
+
+    void recognizeBody(std::vector<std::unique_ptr<ASTBase>>& body);
+    void recognizeLoop(ASTWhile& loop);
+    // Counts the statements assigning or declaring each slot of the function the node is in.
+    void countAssignments(const ASTBase* node, std::unordered_map<size_t, size_t>& assignments, bool& callsAssigning);
+};
+
+#endif // RECOGNIZER_H
@@ -0,0 +1,218 @@
+#include "include/inliner.hpp"
+#include "include/analysis.hpp"
+
+#include <algorithm>
+
+// Index of the parameter the slot belongs to, or SIZE_MAX if it belongs to none.
+static size_t parameterIndex(const ASTFunction& function, size_t slot) {
+    for (size_t i = 0; i < function.arguments.size(); i++) {
+        if (static_cast<const ASTFunctionArgument*>(function.arguments[i].get())->slot == slot) return i;
+    }
+    return SIZE_MAX;
+}
+
+// Calls in the body of the function are one function scope further from their declarations
+// than the call being inlined, which is `depth` scopes from the declaration of the function.
+static void relocateCalls(ASTBase& expression, size_t depth) {
+    if (expression.type == ASTType::FunctionCall) {
+        auto& call = static_cast<ASTFunctionCall&>(expression);
+        call.depth = call.depth + depth - 1;
+    }
+    forEachOperand(expression, [depth](std::unique_ptr<ASTBase>& operand) {
+        if (operand != nullptr) relocateCalls(*operand, depth);
+    });
+}
+
+// Replaces the reads of the parameters with the arguments, moving each one in place of its last read.
+static void substitute(std::unique_ptr<ASTBase>& expression, const ASTFunction& function,
+    std::vector<std::unique_ptr<ASTBase>>& arguments, std::vector<size_t>& uses) {
+    if (expression == nullptr) return;
+
+    if (expression->type == ASTType::Variable) {
+        const size_t index = parameterIndex(function, static_cast<const ASTVariable&>(*expression).binding.slot);
+        if (--uses[index] == 0) expression = std::move(arguments[index]);
+        else expression = copyExpression(*arguments[index]);
+        return;
+    }
+    forEachOperand(*expression, [&](std::unique_ptr<ASTBase>& operand) {
+        substitute(operand, function, arguments, uses);
+    });
+}
+
+void FunctionInliner::inlineCalls(ASTProgram& program) {
+    declared.clear();
+    inlinable.clear();
+    inlined.clear();
+    inlineBody(program.body);
+}
+
+void FunctionInliner::inlineBody(std::vector<std::unique_ptr<ASTBase>>& body) {
+    const size_t visible = declared.size();
+
+    for (std::unique_ptr<ASTBase>& statement : body) {
+        if (statement == nullptr) continue;
+
+        switch (statement->type) {
+            case ASTType::FunctionDeclaration: {
+                // Calls of the function in its own body are left alone, it isn't declared there yet.
+                auto& function = static_cast<ASTFunction&>(*statement);
+                inlineBody(function.body);
+                declared.push_back(&function);
+                break;
+            }
+            case ASTType::VariableDeclaration:
+                inlineExpression(static_cast<ASTVariableDeclaration&>(*statement).value);
+                break;
+            case ASTType::VariableModify:
+                inlineExpression(static_cast<ASTVariableModify&>(*statement).value);
+                break;
+            case ASTType::Print:
+                inlineExpression(static_cast<ASTPrint&>(*statement).expression);
+                break;
+            case ASTType::Condition: {
+                auto& condition = static_cast<ASTCondition&>(*statement);
+                inlineExpression(condition.expression);
+                inlineBody(condition.body);
+                inlineBody(condition.elseBody);
+                break;
+            }
+            case ASTType::While: {
+                auto& loop = static_cast<ASTWhile&>(*statement);
+                inlineExpression(loop.value);
+                inlineBody(loop.body);
+                break;
+            }
+            default:
+                // A call used as a statement stays a call, only its arguments are inlined.
+                inlineOperands(*statement);
+                break;
+        }
+    }
+    // Declarations of the body go out of scope with it.
+    declared.resize(visible);
+}
+
+void FunctionInliner::inlineExpression(std::unique_ptr<ASTBase>& expression) {
+    if (expression == nullptr) return;
+
+    inlineOperands(*expression);
+    if (expression->type == ASTType::FunctionCall) inlineCall(expression);
+}
+
+void FunctionInliner::inlineOperands(ASTBase& expression) {
+    forEachOperand(expression, [this](std::unique_ptr<ASTBase>& operand) { inlineExpression(operand); });
+}
+
+bool FunctionInliner::inlineCall(std::unique_ptr<ASTBase>& expression) {
+    auto& call = static_cast<ASTFunctionCall&>(*expression);
+    const ASTFunction* function = call.function;
+    if (function == nullptr || std::find(declared.begin(), declared.end(), function) == declared.end()) return false;
+
+    ASTBase* body = returnedExpression(*function);
+    std::vector<size_t> uses;
+    if (body == nullptr || !canSubstitute(*body, *function, call, uses)) return false;
+
+    std::unique_ptr<ASTBase> result = copyExpression(*body);
+    relocateCalls(*result, call.depth);
+    substitute(result, *function, call.arguments, uses);
+
+    statistics.inlinedCalls++;
+    if (inlined.insert(function).second) statistics.inlinedFunctions++;
+    expression = std::move(result);
+    return true;
+}
+
+ASTBase* FunctionInliner::returnedExpression(const ASTFunction& function) {
+    auto found = inlinable.find(&function);
+    if (found != inlinable.end()) return found->second;
+
+    ASTBase* expression = nullptr;
+    if (function.body.size() == 1 && function.body[0] != nullptr && function.body[0]->type == ASTType::Return) {
+        expression = static_cast<ASTReturn&>(*function.body[0]).value.get();
+    }
+    if (expression != nullptr
+        && (countNodes(expression) > budget || isRecursive(function) || !isInlinable(expression, function))) {
+        expression = nullptr;
+    }
+    inlinable.emplace(&function, expression);
+    return expression;
+}
+
+bool FunctionInliner::isInlinable(const ASTBase* node, const ASTFunction& function) const {
+    if (node == nullptr) return true;
+
+    switch (node->type) {
+        case ASTType::Variable: {
+            // The body declares nothing, so its variables are parameters or belong to enclosing functions.
+            const ASTBinding& binding = static_cast<const ASTVariable*>(node)->binding;
+            return binding.depth == 0 && parameterIndex(function, binding.slot) != SIZE_MAX;
+        }
+        case ASTType::FunctionCall: {
+            // Calls must not assign variables the arguments read, once they are evaluated after them.
+            const ASTFunction* called = static_cast<const ASTFunctionCall*>(node)->function;
+            if (called == nullptr || assignsEnclosing(*called)) return false;
+            break;
+        }
+        case ASTType::Value:
+        case ASTType::ReadInput:
+        case ASTType::TypeCast:
+        case ASTType::FString:
+        case ASTType::BinaryOperation:
+        case ASTType::ComparisonOperation:
+        case ASTType::AndOperation:
+        case ASTType::OrOperation:
+            break;
+        default:
+            return false;
+    }
+
+    bool inlinable = true;
+    forEachChild(*node, [&](const ASTBase* child) { inlinable = inlinable && isInlinable(child, function); });
+    return inlinable;
+}
+
+bool FunctionInliner::canSubstitute(ASTBase& body, const ASTFunction& function, const ASTFunctionCall& call,
+    std::vector<size_t>& uses) const {
+    const size_t count = function.arguments.size();
+    if (call.arguments.size() != count) return false;
+
+    // Arguments that may fail or have effects, in the order the call evaluates them.
+    std::vector<size_t> unsafe;
+    for (size_t i = 0; i < count; i++) {
+        if (!isSafe(call.arguments[i].get())) unsafe.push_back(i);
+    }
+
+    uses.assign(count, 0);
+    size_t next = 0; // Next unsafe argument to be read.
+    bool ordered = true;
+    // Walks the body in the order it is evaluated. `conditional` tells if the node may be skipped.
+    const auto walk = [&](const auto& self, ASTBase& node, bool conditional) -> void {
+        if (node.type == ASTType::Value) return;
+        if (node.type == ASTType::Variable) {
+            const size_t index = parameterIndex(function, static_cast<const ASTVariable&>(node).binding.slot);
+            uses[index]++;
+            if (std::find(unsafe.begin(), unsafe.end(), index) == unsafe.end()) return;
+            if (conditional || next == unsafe.size() || unsafe[next] != index) ordered = false;
+            else next++;
+            return;
+        }
+
+        const bool shortCircuits = node.type == ASTType::AndOperation || node.type == ASTType::OrOperation;
+        bool first = true;
+        forEachOperand(node, [&](std::unique_ptr<ASTBase>& operand) {
+            if (operand != nullptr) self(self, *operand, conditional || (shortCircuits && !first));
+            first = false;
+        });
+        // The node itself is evaluated now, after every unsafe argument.
+        if (next != unsafe.size()) ordered = false;
+    };
+    walk(walk, body, false);
+
+    if (!ordered || next != unsafe.size()) return false;
+    for (size_t i = 0; i < count; i++) {
+        // Only plain reads are worth evaluating more than once.
+        const ASTType type = call.arguments[i]->type;
+        if (uses[i] > 1 && type != ASTType::Value && type != ASTType::Variable) return false;
+    }
+    return true;
+}
@@ -0,0 +1,30 @@
+#include "include/optimizer.hpp"
+#include "include/inliner.hpp"
+#include "include/folder.hpp"
+#include "include/eliminator.hpp"
+#include "include/hoister.hpp"
+#include "include/recognizer.hpp"
+
+std::string OptimizerStatistics::summary() const {
+    return "Constant folding: " + std::to_string(foldedExpressions) + " expressions folded, "
+        + std::to_string(propagatedConstants) + " constants propagated, "
+        + std::to_string(prunedBranches) + " branches pruned.\n"
+        + "Dead code elimination: " + std::to_string(unreachableStatements) + " unreachable statements, "
+        + std::to_string(unusedDeclarations) + " unused declarations, "
+        + std::to_string(emptyBranches) + " empty branches removed (" + std::to_string(removedNodes) + " nodes).\n"
+        + "Loop-invariant code motion: " + std::to_string(hoistedExpressions) + " expressions hoisted out of "
+        + std::to_string(hoistedLoops) + " loops.\n"
+        + "Counted loops: " + std::to_string(countedLoops) + " while loops run with a native counter.\n"
+        + "Inlining: " + std::to_string(inlinedCalls) + " calls to " + std::to_string(inlinedFunctions) + " functions inlined.\n"
+        + "Partial evaluation: " + std::to_string(pureFunctions) + " pure functions, "
+        + std::to_string(evaluatedCalls) + " calls evaluated ahead of time.\n";
+}
+
+void Optimizer::optimize(ASTProgram& program) {
+    // Inlined bodies are folded, cleaned up and hoisted from loops along with the code around them.
+    if (inlineBudget > 0) FunctionInliner(statistics, inlineBudget).inlineCalls(program);
+    ConstantFolder(statistics).fold(program);
+    DeadCodeEliminator(statistics).eliminate(program);
+    InvariantHoister(statistics).hoist(program);
+    CountedLoopRecognizer(statistics).recognize(program);
+}
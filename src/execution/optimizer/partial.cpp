@@ -0,0 +1,214 @@
+#include "include/partial.hpp"
+#include "../../errors/include/errors.hpp"
+
+// Deepest nesting of calls evaluated ahead of time, well within the recursion limit of the runtime.
+static constexpr size_t MAX_NESTING = 64;
+
+bool PartialEvaluator::evaluate(const ASTFunction& function, std::vector<Value> arguments, Value& result) {
+    if (!function.pure || callable.count(&function) == 0) return false;
+
+    steps = 0;
+    frames.clear();
+    try {
+        Value value = callFunction(function, std::move(arguments));
+        // A value of another type would change the type the checker gave the call.
+        if (value.type() != function.returnType) return false;
+        result = std::move(value);
+        return true;
+    } catch (const Unsupported&) {
+        return false;
+    } catch (const ZynkError&) {
+        // The call fails whenever it runs, which is left for the runtime to report.
+        return false;
+    }
+}
+
+void PartialEvaluator::step() {
+    if (++steps > budget) throw Unsupported();
+}
+
+Value PartialEvaluator::callFunction(const ASTFunction& function, std::vector<Value> arguments) {
+    if (frames.size() >= MAX_NESTING) throw Unsupported();
+
+    Frame& frame = frames.emplace_back();
+    frame.values.resize(function.frameSize);
+    frame.declared.assign(function.frameSize, false);
+    frame.blocks.emplace_back();
+    for (size_t i = 0; i < function.arguments.size(); i++) {
+        const size_t slot = static_cast<const ASTFunctionArgument*>(function.arguments[i].get())->slot;
+        frame.values[slot] = std::move(arguments[i]);
+        frame.declared[slot] = true;
+        frame.blocks.back().push_back(slot);
+    }
+
+    // The function body runs directly in the block of the call.
+    Completion completion = executeBody(function.body);
+    frames.pop_back();
+
+    if (completion.kind == Completion::Kind::Return) return std::move(completion.value);
+    // Break outside of a loop and missing returns are errors of the runtime.
+    if (completion.kind == Completion::Kind::Break || function.returnType != ASTValueType::None) throw Unsupported();
+    return Value();
+}
+
+Completion PartialEvaluator::execute(const ASTBase& statement) {
+    step();
+
+    switch (statement.type) {
+        case ASTType::VariableDeclaration: {
+            const auto& declaration = static_cast<const ASTVariableDeclaration&>(statement);
+            Value value = declaration.value != nullptr ? evaluateExpression(declaration.value.get()) : Value();
+            // Evaluating the value can call a function, which may move the frames.
+            Frame& frame = frames.back();
+            if (frame.declared[declaration.slot]) throw Unsupported();
+            frame.values[declaration.slot] = std::move(value);
+            frame.declared[declaration.slot] = true;
+            frame.blocks.back().push_back(declaration.slot);
+            break;
+        }
+        case ASTType::VariableModify: {
+            const auto& modify = static_cast<const ASTVariableModify&>(statement);
+            if (modify.binding.depth != 0 || !frames.back().declared[modify.binding.slot]) throw Unsupported();
+            Value value = evaluateExpression(modify.value.get());
+            frames.back().values[modify.binding.slot] = std::move(value);
+            break;
+        }
+        case ASTType::Condition: {
+            const auto& condition = static_cast<const ASTCondition&>(statement);
+            const bool status = evaluateExpression(condition.expression.get()).isTruthy();
+            return executeBlock(status ? condition.body : condition.elseBody);
+        }
+        case ASTType::While: {
+            // The condition and the body share a single block for the whole loop.
+            const auto& loop = static_cast<const ASTWhile&>(statement);
+            frames.back().blocks.emplace_back();
+            Completion completion;
+            while (evaluateExpression(loop.value.get()).isTruthy()) {
+                completion = executeBody(loop.body);
+                if (completion.kind == Completion::Kind::Break) {
+                    completion = {};
+                    break;
+                }
+                if (completion.kind == Completion::Kind::Return) break;
+            }
+            exitBlock();
+            return completion;
+        }
+        case ASTType::Return:
+            return { Completion::Kind::Return, evaluateExpression(&statement), statement.line };
+        case ASTType::Break:
+            return { Completion::Kind::Break, Value(), statement.line };
+        case ASTType::FunctionCall:
+            evaluateCall(static_cast<const ASTFunctionCall&>(statement));
+            break;
+        case ASTType::Variable:
+        case ASTType::Value:
+            evaluateExpression(&statement);
+            break;
+        default:
+            // Declarations of functions, prints and reads.
+            throw Unsupported();
+    }
+    return {};
+}
+
+Completion PartialEvaluator::executeBlock(const std::vector<std::unique_ptr<ASTBase>>& body) {
+    frames.back().blocks.emplace_back();
+    Completion completion = executeBody(body);
+    exitBlock();
+    return completion;
+}
+
+void PartialEvaluator::exitBlock() {
+    Frame& frame = frames.back();
+    for (size_t slot : frame.blocks.back()) frame.declared[slot] = false;
+    frame.blocks.pop_back();
+}
+
+Completion PartialEvaluator::executeBody(const std::vector<std::unique_ptr<ASTBase>>& body) {
+    for (const std::unique_ptr<ASTBase>& child : body) {
+        if (child == nullptr) continue;
+
+        Completion completion = execute(*child);
+        if (completion.kind != Completion::Kind::Normal) return completion;
+    }
+    return {};
+}
+
+Value PartialEvaluator::evaluateExpression(const ASTBase* expression) {
+    if (expression == nullptr) return Value();
+    step();
+
+    switch (expression->type) {
+        case ASTType::Value:
+            return static_cast<const ASTValue*>(expression)->constant;
+        case ASTType::Variable: {
+            const auto variable = static_cast<const ASTVariable*>(expression);
+            const Frame& frame = frames.back();
+            if (variable->binding.depth != 0 || !frame.declared[variable->binding.slot]) throw Unsupported();
+            // Only uninitialized variables hold null, their uses are left for the runtime to report.
+            const Value& value = frame.values[variable->binding.slot];
+            if (value.type() == ASTValueType::None) throw Unsupported();
+            return value;
+        }
+        case ASTType::TypeCast: {
+            const auto typeCast = static_cast<const ASTTypeCast*>(expression);
+            return castValue(evaluateExpression(typeCast->value.get()), typeCast->castType);
+        }
+        case ASTType::FString: {
+            std::string result;
+            for (const std::unique_ptr<ASTBase>& part : static_cast<const ASTFString*>(expression)->parts) {
+                evaluateExpression(part.get()).appendTo(result);
+            }
+            return Value::fromString(std::move(result));
+        }
+        case ASTType::BinaryOperation: {
+            const auto operation = static_cast<const ASTBinaryOperation*>(expression);
+            const Value left = evaluateExpression(operation->left.get());
+            const Value right = evaluateExpression(operation->right.get());
+            if (!left.isNumber() || !right.isNumber()) throw Unsupported();
+            return calculateValue(left, right, operation->op);
+        }
+        case ASTType::ComparisonOperation: {
+            const auto operation = static_cast<const ASTComparisonOperation*>(expression);
+            const Value left = evaluateExpression(operation->left.get());
+            const Value right = evaluateExpression(operation->right.get());
+            return compareValue(left, right, operation->op);
+        }
+        case ASTType::AndOperation: {
+            const auto operation = static_cast<const ASTAndOperation*>(expression);
+            Value left = evaluateExpression(operation->left.get());
+            if (!left.isTruthy()) return left;
+            return evaluateExpression(operation->right.get());
+        }
+        case ASTType::OrOperation: {
+            const auto operation = static_cast<const ASTOrOperation*>(expression);
+            Value left = evaluateExpression(operation->left.get());
+            if (left.isTruthy()) return left;
+            return evaluateExpression(operation->right.get());
+        }
+        case ASTType::FunctionCall: {
+            Value result = evaluateCall(*static_cast<const ASTFunctionCall*>(expression));
+            if (result.type() == ASTValueType::None) throw Unsupported();
+            return result;
+        }
+        case ASTType::Return:
+            return evaluateExpression(static_cast<const ASTReturn*>(expression)->value.get());
+        default:
+            // Reads of input.
+            throw Unsupported();
+    }
+}
+
+Value PartialEvaluator::evaluateCall(const ASTFunctionCall& call) {
+    // Only functions declared before the evaluated call are certain to be found by the runtime.
+    const ASTFunction* function = call.function;
+    if (function == nullptr || !function->pure || callable.count(function) == 0) throw Unsupported();
+
+    std::vector<Value> arguments;
+    arguments.reserve(call.arguments.size());
+    for (const std::unique_ptr<ASTBase>& argument : call.arguments) {
+        arguments.push_back(evaluateExpression(argument.get()));
+    }
+    return callFunction(*function, std::move(arguments));
+}
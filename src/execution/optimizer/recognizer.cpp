@@ -0,0 +1,126 @@
+#include "include/recognizer.hpp"
+#include "include/analysis.hpp"
+
+// Int variable of the function the loop is in.
+static const ASTVariable* asCounter(const ASTBase* expression) {
+    if (expression == nullptr || expression->type != ASTType::Variable) return nullptr;
+
+    const auto variable = static_cast<const ASTVariable*>(expression);
+    const ASTBinding& binding = variable->binding;
+    if (binding.depth != 0 || binding.slot == ASTBinding::Unresolved || binding.type != ASTValueType::Integer) return nullptr;
+    return variable;
+}
+
+static bool isIntegerConstant(const ASTBase* expression) {
+    return expression != nullptr && expression->type == ASTType::Value
+        && static_cast<const ASTValue*>(expression)->constant.type() == ASTValueType::Integer;
+}
+
+static bool isCounter(const ASTBase* expression, size_t slot) {
+    const ASTVariable* variable = asCounter(expression);
+    return variable != nullptr && variable->binding.slot == slot;
+}
+
+void CountedLoopRecognizer::recognize(ASTProgram& program) {
+    recognizeBody(program.body);
+}
+
+void CountedLoopRecognizer::recognizeBody(std::vector<std::unique_ptr<ASTBase>>& body) {
+    for (std::unique_ptr<ASTBase>& statement : body) {
+        if (statement == nullptr) continue;
+
+        switch (statement->type) {
+            case ASTType::FunctionDeclaration:
+                recognizeBody(static_cast<ASTFunction&>(*statement).body);
+                break;
+            case ASTType::Condition: {
+                auto& condition = static_cast<ASTCondition&>(*statement);
+                recognizeBody(condition.body);
+                recognizeBody(condition.elseBody);
+                break;
+            }
+            case ASTType::While: {
+                auto& loop = static_cast<ASTWhile&>(*statement);
+                recognizeBody(loop.body);
+                recognizeLoop(loop);
+                break;
+            }
+            default:
+                break;
+        }
+    }
+}
+
+void CountedLoopRecognizer::recognizeLoop(ASTWhile& loop) {
+    if (loop.value == nullptr || loop.value->type != ASTType::ComparisonOperation) return;
+    const auto& comparison = static_cast<const ASTComparisonOperation&>(*loop.value);
+    const ASTVariable* counter = asCounter(comparison.left.get());
+    if (counter == nullptr) return;
+    const size_t slot = counter->binding.slot;
+
+    const ASTBase* bound = comparison.right.get();
+    const ASTVariable* boundVariable = asCounter(bound);
+    if (!isIntegerConstant(bound) && (boundVariable == nullptr || boundVariable->binding.slot == slot)) return;
+
+    // The counter is stepped by the last statement, `i = i + c`, `i = c + i` or `i = i - c`.
+    if (loop.body.empty() || loop.body.back() == nullptr || loop.body.back()->type != ASTType::VariableModify) return;
+    const auto& increment = static_cast<const ASTVariableModify&>(*loop.body.back());
+    if (increment.binding.depth != 0 || increment.binding.slot != slot) return;
+    if (increment.value == nullptr || increment.value->type != ASTType::BinaryOperation) return;
+
+    const auto& operation = static_cast<const ASTBinaryOperation&>(*increment.value);
+    const ASTBase* amount = nullptr;
+    if (operation.op == ASTBinaryOperator::Add || operation.op == ASTBinaryOperator::Subtract) {
+        if (isCounter(operation.left.get(), slot) && isIntegerConstant(operation.right.get())) {
+            amount = operation.right.get();
+        } else if (operation.op == ASTBinaryOperator::Add && isCounter(operation.right.get(), slot)
+            && isIntegerConstant(operation.left.get())) {
+            amount = operation.left.get();
+        }
+    }
+    if (amount == nullptr) return;
+
+    std::unordered_map<size_t, size_t> assignments;
+    bool callsAssigning = false;
+    for (const std::unique_ptr<ASTBase>& statement : loop.body) {
+        countAssignments(statement.get(), assignments, callsAssigning);
+    }
+    if (callsAssigning || assignments[slot] != 1) return;
+    if (boundVariable != nullptr && assignments[boundVariable->binding.slot] != 0) return;
+
+    loop.counted = ASTCountedLoop{
+        counter->binding,
+        bound,
+        comparison.op,
+        operation.op,
+        static_cast<const ASTValue*>(amount)->constant.asInt(),
+        operation.line
+    };
+    statistics.countedLoops++;
+}
+
+void CountedLoopRecognizer::countAssignments(const ASTBase* node, std::unordered_map<size_t, size_t>& assignments, bool& callsAssigning) {
+    if (node == nullptr) return;
+
+    switch (node->type) {
+        case ASTType::FunctionDeclaration:
+            // Runs only when called, which is checked at the calls.
+            return;
+        case ASTType::VariableDeclaration:
+            assignments[static_cast<const ASTVariableDeclaration*>(node)->slot]++;
+            break;
+        case ASTType::VariableModify: {
+            const ASTBinding& binding = static_cast<const ASTVariableModify*>(node)->binding;
+            if (binding.depth == 0) assignments[binding.slot]++;
+            break;
+        }
+        case ASTType::FunctionCall: {
+            const ASTFunction* function = static_cast<const ASTFunctionCall*>(node)->function;
+            if (function == nullptr || assignsEnclosing(*function)) callsAssigning = true;
+            break;
+        }
+        default:
+            break;
+    }
+    forEachChild(*node, [&](const ASTBase* child) { countAssignments(child, assignments, callsAssigning); });
+}
@@ -2,33 +2,56 @@
 #include "include/runtime.hpp"
 #include <cassert>
 
+RuntimeEnvironment::RuntimeEnvironment() {
+    frames.reserve(MAX_DEPTH + 1);
+    blocks.reserve(MAX_DEPTH * 4);
+    slots.reserve(MAX_DEPTH * 8);
+    functions.reserve(64);
+}
+
 bool RuntimeEnvironment::isRecursionDepthExceeded() const {
-    return currentDepth >= MAX_DEPTH;
+    // The first frame belongs to the main program code.
+    return frames.size() > MAX_DEPTH;
 }
 
-Block* RuntimeEnvironment::currentBlock() const {
-    if (blockStack.empty()) return nullptr;
-    return blockStack.top().get();
+size_t RuntimeEnvironment::frameCount() const {
+    return frames.size();
 }
 
-void RuntimeEnvironment::declareVariable(const std::string& name, std::unique_ptr<ASTValue> value) const {
-    if (isVariableDeclared(name, false)) {
+const Block* RuntimeEnvironment::currentBlock() const {
+    if (blocks.empty()) return nullptr;
+    return &blocks.back();
+}
+
+void RuntimeEnvironment::declareVariable(const std::string& name, size_t slot, ASTValueType type, Value value, const size_t line) {
+    assert(!blocks.empty() && "Block should exist");
+
+    Variable& variable = slots[frames.back().base + slot];
+    if (variable.declared) {
         throw ZynkError(
             ZynkErrorType::DuplicateDeclarationError,
             "Variable '" + name + "' is already declared.",
-            value->line
+            line
         );
     }
-    Block* block = currentBlock();
-    assert(block != nullptr && "Block should not be nullptr");
-    block->setVariable(name, std::move(value));
+    variable.value = std::move(value);
+    variable.type = type;
+    variable.declared = true;
+    blocks.back().markSlot(slot);
 }
 
-ASTValue* RuntimeEnvironment::getVariable(const std::string& name, const size_t line, bool deepSearch) const {
-    Block* block = currentBlock();
-    assert(block != nullptr && "Block should not be nullptr");
-    ASTValue* variable = block->getVariable(name, deepSearch);
+void RuntimeEnvironment::bindArgument(size_t slot, ASTValueType type, Value value) {
+    assert(!blocks.empty() && "Block should exist");
+
+    Variable& variable = slots[frames.back().base + slot];
+    variable.value = std::move(value);
+    variable.type = type;
+    variable.declared = true;
+    blocks.back().markSlot(slot);
+}
 
+Variable* RuntimeEnvironment::getVariable(const std::string& name, const ASTBinding& binding, const size_t line) {
+    Variable* variable = findVariable(binding);
     if (variable == nullptr) {
         throw ZynkError(
             ZynkErrorType::NotDefinedError,
@@ -39,17 +62,19 @@ ASTValue* RuntimeEnvironment::getVariable(const std::string& name, const size_t
     return variable;
 }
 
-bool RuntimeEnvironment::isVariableDeclared(const std::string& name, bool deepSearch) const {
-    if (currentBlock() == nullptr) return false;
-    try {
-        getVariable(name, 1, deepSearch);
-    } catch (const ZynkError&) {
-        return false;
+Variable* RuntimeEnvironment::findVariable(const ASTBinding& binding) {
+    assert(!frames.empty() && "Frame should exist");
+    if (binding.slot == ASTBinding::Unresolved) return nullptr;
+
+    size_t frame = frames.size() - 1;
+    for (size_t depth = 0; depth < binding.depth; depth++) {
+        frame = frames[frame].enclosing;
     }
-    return true;
+    Variable& variable = slots[frames[frame].base + binding.slot];
+    return variable.declared ? &variable : nullptr;
 }
 
-void RuntimeEnvironment::declareFunction(std::unique_ptr<ASTFunction> func) const {
+void RuntimeEnvironment::declareFunction(const ASTFunction* func) {
     if (isFunctionDeclared(func->name)) {
         throw ZynkError(
             ZynkErrorType::DuplicateDeclarationError,
@@ -57,16 +82,14 @@ void RuntimeEnvironment::declareFunction(std::unique_ptr<ASTFunction> func) cons
             func->line
         );
     }
-    Block* block = currentBlock();
-    assert(block != nullptr && "Block should not be nullptr");
-    block->setFunction(std::move(func));
+    assert(!blocks.empty() && "Block should exist");
+    if (func->id >= functionScopes.size()) functionScopes.resize(func->id + 1, Block::None);
+    functions.push_back({ func, functionScopes[func->id] });
+    functionScopes[func->id] = blocks.size() - 1;
 }
 
-ASTFunction* RuntimeEnvironment::getFunction(const std::string& name, const size_t line) const {
-    Block* block = currentBlock();
-    assert(block != nullptr && "Block should not be nullptr");
-
-    ASTFunction* function = block->getFunction(name);
+const ASTFunction* RuntimeEnvironment::getFunction(const std::string& name, const size_t line) const {
+    const ASTFunction* function = findFunction(name);
     if (function == nullptr) {
         throw ZynkError{
             ZynkErrorType::NotDefinedError,
@@ -77,23 +100,110 @@ ASTFunction* RuntimeEnvironment::getFunction(const std::string& name, const size
     return function;
 }
 
+const ASTFunction* RuntimeEnvironment::findFunction(const std::string& name) const {
+    if (blocks.empty()) return nullptr;
+    size_t scope;
+    const size_t index = lookupFunction(name, scope);
+    return index != functions.size() ? functions[index].function : nullptr;
+}
+
 bool RuntimeEnvironment::isFunctionDeclared(const std::string& name) const {
-    if (currentBlock() == nullptr) return false;
-    try {
-        getFunction(name, 1);
-    } catch (const ZynkError&) {
-        return false;
+    return findFunction(name) != nullptr;
+}
+
+size_t RuntimeEnvironment::getFunctionScope(const ASTFunction& function, size_t depth, const size_t line) const {
+    const size_t scope = findFunctionScope(function, depth);
+    if (scope == Block::None) {
+        throw ZynkError{
+            ZynkErrorType::NotDefinedError,
+            "Function named '" + function.name + "' is not defined.",
+            line
+        };
+    }
+    return scope;
+}
+
+size_t RuntimeEnvironment::findFunctionScope(const ASTFunction& function, size_t depth) const {
+    if (frames.empty() || function.id >= functionScopes.size()) return Block::None;
+    const size_t scope = functionScopes[function.id];
+    if (scope == Block::None) return Block::None;
+
+    size_t frame = frames.size() - 1;
+    for (size_t i = 0; i < depth; i++) {
+        frame = frames[frame].enclosing;
+    }
+    // Otherwise the declaration belongs to another call, and this one hasn't reached it yet.
+    return blocks[scope].frame == frame ? scope : Block::None;
+}
+
+size_t RuntimeEnvironment::lookupFunction(const std::string& name, size_t& scope) const {
+    // Functions of a block end where the functions of the block opened after it begin.
+    // Blocks always close in reverse order, so those ranges never interleave.
+    for (size_t block = blocks.size() - 1; block != Block::None; block = blocks[block].parentBlock) {
+        const size_t end = block + 1 < blocks.size() ? blocks[block + 1].firstFunction : functions.size();
+        for (size_t index = blocks[block].firstFunction; index < end; index++) {
+            if (functions[index].function->name == name) {
+                scope = block;
+                return index;
+            }
+        }
+    }
+    return functions.size();
+}
+
+void RuntimeEnvironment::enterNewBlock() {
+    assert(!blocks.empty() && "Block should exist");
+    blocks.emplace_back(blocks.size() - 1, frames.size() - 1, functions.size());
+}
+
+void RuntimeEnvironment::exitCurrentBlock() {
+    if (blocks.empty()) return;
+    const Block& block = blocks.back();
+
+    // Slots are reused by the blocks that follow, so they have to be released.
+    const size_t base = frames[block.frame].base;
+    for (size_t slot = block.firstSlot; slot < block.endSlot; slot++) {
+        slots[base + slot] = Variable();
     }
-    return true;
+    releaseFunctions(block.firstFunction);
+    blocks.pop_back();
+}
+
+void RuntimeEnvironment::enterProgram(size_t frameSize) {
+    enterFrame(frameSize, Block::None);
+}
+
+void RuntimeEnvironment::enterFunction(const ASTFunction& function) {
+    assert(!blocks.empty() && "Block should exist");
+    size_t scope = Block::None;
+    lookupFunction(function.name, scope);
+    enterFrame(function.frameSize, scope);
 }
 
- void RuntimeEnvironment::enterNewBlock(bool increaseDepth) {
-    if (increaseDepth) currentDepth++;
-    blockStack.push(std::make_unique<Block>(currentBlock()));
+void RuntimeEnvironment::enterFunction(const ASTFunction& function, size_t scope) {
+    assert(scope < blocks.size() && "Block should exist");
+    enterFrame(function.frameSize, scope);
 }
 
-void RuntimeEnvironment::exitCurrentBlock(bool decreaseDepth) {
-    if (blockStack.empty()) return;
-    if (decreaseDepth) currentDepth--;
-    blockStack.pop();
+void RuntimeEnvironment::enterFrame(size_t frameSize, size_t scope) {
+    frames.push_back({ slots.size(), scope != Block::None ? blocks[scope].frame : 0 });
+    slots.resize(slots.size() + frameSize);
+    blocks.emplace_back(scope, frames.size() - 1, functions.size());
+}
+
+void RuntimeEnvironment::exitFrame() {
+    if (blocks.empty()) return;
+    releaseFunctions(blocks.back().firstFunction);
+    blocks.pop_back();
+    slots.resize(frames.back().base);
+    frames.pop_back();
+}
+
+void RuntimeEnvironment::releaseFunctions(size_t firstFunction) {
+    // Released in reverse, so a function declared again on recursion gets its previous scope back.
+    while (functions.size() > firstFunction) {
+        const DeclaredFunction& declared = functions.back();
+        functionScopes[declared.function->id] = declared.shadowedScope;
+        functions.pop_back();
+    }
 }
@@ -1,102 +1,295 @@
 #include "include/checker.hpp"
 #include "../../errors/include/errors.hpp"
 
-TypeChecker::TypeChecker(RuntimeEnvironment& env) : env(env) {};
+void TypeChecker::check(ASTProgram& program) {
+    scopes.clear();
+    functions.clear();
+    dynamic.clear();
+    checkBody(program.body);
+}
+
+void TypeChecker::checkBody(std::vector<std::unique_ptr<ASTBase>>& body) {
+    // Functions can be called before their declaration in the same body, e.g. by another function.
+    Scope& scope = scopes.emplace_back(Scope{ {}, functions.size() });
+    for (const std::unique_ptr<ASTBase>& statement : body) {
+        if (statement == nullptr || statement->type != ASTType::FunctionDeclaration) continue;
+
+        const ASTFunction* function = static_cast<const ASTFunction*>(statement.get());
+        scope.declared.emplace(function->name, function);
+    }
+
+    for (const std::unique_ptr<ASTBase>& statement : body) {
+        if (statement != nullptr) checkStatement(*statement);
+    }
+    scopes.pop_back();
+}
+
+void TypeChecker::checkStatement(ASTBase& statement) {
+    switch (statement.type) {
+        case ASTType::FunctionDeclaration:
+            checkFunction(static_cast<ASTFunction&>(statement));
+            break;
+        case ASTType::VariableDeclaration: {
+            ASTVariableDeclaration& declaration = static_cast<ASTVariableDeclaration&>(statement);
+            // A variable declared without a value is `null` until it is assigned.
+            if (declaration.value != nullptr) checkType(declaration.varType, declaration.value.get());
+            break;
+        }
+        case ASTType::VariableModify: {
+            ASTVariableModify& modify = static_cast<ASTVariableModify&>(statement);
+            if (modify.binding.slot == ASTBinding::Unresolved) {
+                throw ZynkError(
+                    ZynkErrorType::NotDefinedError,
+                    "Variable named '" + modify.name + "' is not defined.",
+                    modify.line
+                );
+            }
+            checkType(modify.binding.type, modify.value.get());
+            break;
+        }
+        case ASTType::Print:
+            determineType(static_cast<ASTPrint&>(statement).expression.get());
+            break;
+        case ASTType::Condition: {
+            ASTCondition& condition = static_cast<ASTCondition&>(statement);
+            determineType(condition.expression.get());
+            checkBody(condition.body);
+            checkBody(condition.elseBody);
+            break;
+        }
+        case ASTType::While: {
+            ASTWhile& loop = static_cast<ASTWhile&>(statement);
+            determineType(loop.value.get());
+            checkBody(loop.body);
+            break;
+        }
+        case ASTType::Return: {
+            ASTReturn& returnStatement = static_cast<ASTReturn&>(statement);
+            const ASTValueType type = determineType(&returnStatement);
+            // A return outside of a function is reported when it is executed.
+            if (functions.empty()) break;
+            checkStatic(&returnStatement);
+            checkType(functions.back(), type, returnStatement.line);
+            break;
+        }
+        case ASTType::Break:
+            break;
+        default:
+            determineType(&statement);
+            break;
+    }
+}
+
+void TypeChecker::checkFunction(ASTFunction& function) {
+    for (size_t i = 0; i < function.arguments.size(); i++) {
+        const auto argument = static_cast<ASTFunctionArgument*>(function.arguments[i].get());
+        argument->staticType = argument->valueType;
+
+        // Arguments are bound without checks when the function is called.
+        for (size_t j = 0; j < i; j++) {
+            if (static_cast<const ASTFunctionArgument*>(function.arguments[j].get())->name != argument->name) continue;
+            throw ZynkError(
+                ZynkErrorType::DuplicateDeclarationError,
+                "Variable '" + argument->name + "' is already declared.",
+                argument->line
+            );
+        }
+    }
+    functions.push_back(&function);
+    checkBody(function.body);
+    functions.pop_back();
+}
+
+ASTValueType TypeChecker::checkFunctionCall(ASTFunctionCall& functionCall) {
+    const ASTFunction* func = lookupFunction(functionCall.name, functionCall.line, functionCall.depth);
+    functionCall.function = func;
+
+    if (func->arguments.size() != functionCall.arguments.size()) {
+        throw ZynkError(
+            ZynkErrorType::RuntimeError,
+            "Invalid number of arguments for function '" + functionCall.name + "'.",
+            functionCall.line
+        );
+    }
+
+    for (size_t i = 0; i < func->arguments.size(); ++i) {
+        const auto funcArg = static_cast<const ASTFunctionArgument*>(func->arguments[i].get());
+        checkType(funcArg->valueType, functionCall.arguments[i].get());
+    }
+    return func->returnType;
+}
+
+const ASTFunction* TypeChecker::lookupFunction(const std::string& name, size_t line, size_t& depth) const {
+    for (auto scope = scopes.rbegin(); scope != scopes.rend(); ++scope) {
+        auto found = scope->declared.find(name);
+        if (found == scope->declared.end()) continue;
+
+        depth = functions.size() - scope->level;
+        return found->second;
+    }
+    throw ZynkError(
+        ZynkErrorType::NotDefinedError,
+        "Function named '" + name + "' is not defined.",
+        line
+    );
+}
 
 ASTValueType TypeChecker::determineType(ASTBase* expression) {
     if (expression == nullptr) return ASTValueType::None;
 
+    ASTValueType type = ASTValueType::None;
     switch (expression->type) {
-        case ASTType::TypeCast:
-            return static_cast<ASTTypeCast*>(expression)->castType;
-        case ASTType::Value: 
-            return static_cast<ASTValue*>(expression)->valueType;
-        case ASTType::Return:
-            return determineType(static_cast<ASTReturn*>(expression)->value.get());
-        case ASTType::ComparisonOperation:
-            return ASTValueType::Bool;
+        case ASTType::TypeCast: {
+            ASTTypeCast* typeCast = static_cast<ASTTypeCast*>(expression);
+            determineType(typeCast->value.get());
+            type = typeCast->castType;
+            break;
+        }
+        case ASTType::Value:
+            type = static_cast<const ASTValue*>(expression)->valueType;
+            break;
+        case ASTType::Return: {
+            ASTBase* value = static_cast<ASTReturn*>(expression)->value.get();
+            type = determineType(value);
+            markDynamic(expression, value);
+            break;
+        }
+        case ASTType::ComparisonOperation: {
+            ASTComparisonOperation* operation = static_cast<ASTComparisonOperation*>(expression);
+            determineType(operation->left.get());
+            determineType(operation->right.get());
+            type = ASTValueType::Bool;
+            break;
+        }
         case ASTType::FString:
+            for (const std::unique_ptr<ASTBase>& part : static_cast<ASTFString*>(expression)->parts) {
+                determineType(part.get());
+            }
+            type = ASTValueType::String;
+            break;
         case ASTType::ReadInput:
-            return ASTValueType::String;
-        case ASTType::FunctionCall: {
-            ASTFunctionCall* funcCall = static_cast<ASTFunctionCall*>(expression);
-            ASTFunction* func = env.getFunction(funcCall->name, expression->line);
-            return func->returnType;
-        }
+            determineType(static_cast<ASTReadInput*>(expression)->out.get());
+            type = ASTValueType::String;
+            break;
+        case ASTType::FunctionCall:
+            type = checkFunctionCall(*static_cast<ASTFunctionCall*>(expression));
+            break;
         case ASTType::Variable: {
-            ASTVariable* var = static_cast<ASTVariable*>(expression);
-            ASTValue* varValue = env.getVariable(var->name, var->line, true);
-            return determineType(varValue);
+            const ASTVariable* var = static_cast<const ASTVariable*>(expression);
+            if (var->binding.slot == ASTBinding::Unresolved) {
+                throw ZynkError(
+                    ZynkErrorType::NotDefinedError,
+                    "Variable named '" + var->name + "' is not defined.",
+                    var->line
+                );
+            }
+            type = var->binding.type;
+            break;
         }
         case ASTType::BinaryOperation: {
             ASTBinaryOperation* operation = static_cast<ASTBinaryOperation*>(expression);
-            ASTValueType leftType = determineType(operation->left.get());
-            ASTValueType rightType = determineType(operation->right.get());
+            const ASTValueType valueTypes[2] = {
+                determineType(operation->left.get()),
+                determineType(operation->right.get())
+            };
 
-            if (!isNumber(leftType)) return leftType;
-            if (!isNumber(rightType)) return rightType;
-            if (leftType == ASTValueType::Float || rightType == ASTValueType::Float) {
-                return ASTValueType::Float;
+            // Arithmetic needs the types of its operands ahead of time.
+            checkStatic(operation->left.get());
+            checkStatic(operation->right.get());
+            for (const ASTValueType& valueType : valueTypes) {
+                if (!isNumber(valueType)) {
+                    throw ZynkError(
+                        ZynkErrorType::ExpressionError,
+                        "Cannot perform BinaryOperation on '" + typeToString(valueType) + "' type.",
+                        operation->line
+                    );
+                }
             }
-            return ASTValueType::Integer;
+            type = valueTypes[0] == ASTValueType::Float || valueTypes[1] == ASTValueType::Float
+                ? ASTValueType::Float
+                : ASTValueType::Integer;
+            break;
         }
         case ASTType::OrOperation: {
             ASTOrOperation* operation = static_cast<ASTOrOperation*>(expression);
-            ASTValueType leftType = determineType(operation->left.get());
-            ASTValueType rightType = determineType(operation->right.get());
-
-            if (leftType != rightType) {
-                throw ZynkError(
-                    ZynkErrorType::TypeError,
-                    "Operands of the 'or' operation in variable declarations must be of the same type.",
-                    operation->line
-                );
-            }
-            return leftType;
+            type = determineLogicalType(*operation, operation->left.get(), operation->right.get());
+            break;
         }
         case ASTType::AndOperation: {
             ASTAndOperation* operation = static_cast<ASTAndOperation*>(expression);
-            ASTValueType leftType = determineType(operation->left.get());
-            ASTValueType rightType = determineType(operation->right.get());
-
-            if (leftType != rightType) {
-                throw ZynkError(
-                    ZynkErrorType::TypeError,
-                    "Operands of the 'and' operation in variable declarations must be of the same type.",
-                    operation->line
-                );
-            }
-            return leftType;
+            type = determineLogicalType(*operation, operation->left.get(), operation->right.get());
+            break;
         }
         default:
             throw ZynkError(
-                ZynkErrorType::TypeError, 
+                ZynkErrorType::TypeError,
                 "Cannot determine type for given AST type.",
                 expression->line
             );
-        }
+    }
+    expression->staticType = type;
+    return type;
+}
+
+ASTValueType TypeChecker::determineLogicalType(ASTBase& operation, ASTBase* left, ASTBase* right) {
+    // Either operand can be the result, so the type is only known ahead of time if both have the same.
+    const ASTValueType leftType = determineType(left);
+    const ASTValueType rightType = determineType(right);
+
+    markDynamic(&operation, left);
+    markDynamic(&operation, right);
+    if (leftType != rightType && dynamic.count(&operation) == 0) dynamic.emplace(&operation, &operation);
+    return dynamic.count(&operation) != 0 ? ASTValueType::None : leftType;
+}
+
+void TypeChecker::markDynamic(const ASTBase* expression, const ASTBase* operand) {
+    auto found = dynamic.find(operand);
+    if (found != dynamic.end()) dynamic.emplace(expression, found->second);
+}
+
+void TypeChecker::checkStatic(const ASTBase* value) const {
+    auto found = dynamic.find(value);
+    if (found == dynamic.end()) return;
+
+    const ASTBase* operation = found->second;
+    throw ZynkError(
+        ZynkErrorType::TypeError,
+        std::string("Operands of the '") + (operation->type == ASTType::AndOperation ? "and" : "or")
+        + "' operation must be of the same type.",
+        operation->line
+    );
 }
 
 void TypeChecker::checkType(const ASTValueType& declared, ASTBase* value) {
-    ASTValueType valueType = determineType(value);
-    if (declared != valueType) {
+    const ASTValueType actual = determineType(value);
+    checkStatic(value);
+    checkType(declared, actual, value->line);
+}
+
+void TypeChecker::checkType(const ASTValueType& declared, const ASTValueType& actual, size_t line) {
+    if (declared != actual) {
         throw ZynkError(
             ZynkErrorType::TypeError,
-            "Type mismatch. Declared type is " + typeToString(declared) + 
-            ", but assigned value is of type " + typeToString(valueType) + ".",
-            value->line
+            "Type mismatch. Declared type is " + typeToString(declared) +
+            ", but assigned value is of type " + typeToString(actual) + ".",
+            line
         );
     }
 }
 
-void TypeChecker::checkType(ASTFunction* func, ASTBase* value) {
-    ASTValueType returnType = determineType(value);
-    if (returnType != func->returnType) {
+void TypeChecker::checkType(const ASTFunction* func, ASTBase* value) {
+    const ASTValueType actual = determineType(value);
+    checkStatic(value);
+    checkType(func, actual, value->line);
+}
+
+void TypeChecker::checkType(const ASTFunction* func, const ASTValueType& actual, size_t line) {
+    if (actual != func->returnType) {
         throw ZynkError(
             ZynkErrorType::TypeError,
             "Function '" + func->name + "' does not return a value of type " +
-            typeToString(func->returnType) + ". Instead, it returned " + typeToString(returnType) + " type.",
-            value->line
+            typeToString(func->returnType) + ". Instead, it returned " + typeToString(actual) + " type.",
+            line
         );
     }
 }
@@ -120,4 +313,4 @@ std::string TypeChecker::typeToString(const ASTValueType& type) {
 
 inline bool TypeChecker::isNumber(const ASTValueType& type) {
     return type == ASTValueType::Float || type == ASTValueType::Integer;
-}
\ No newline at end of file
+}
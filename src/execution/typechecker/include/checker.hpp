@@ -2,18 +2,45 @@
 #define CHECKER_HPP
 
 #include "../../../parsing/include/ast.hpp"
-#include "../../include/runtime.hpp"
+#include <unordered_map>
+#include <vector>
 
+// Checks the types of a resolved program once, before it runs. Every expression
+// gets its static type, so the engines don't check types while executing.
 class TypeChecker {
 public:
-    TypeChecker(RuntimeEnvironment& env);
+    void check(ASTProgram& program);
     void checkType(const ASTValueType& declared, ASTBase* value);
-    void checkType(ASTFunction* func, ASTBase* value);
+    void checkType(const ASTFunction* func, ASTBase* value);
+    void checkType(const ASTFunction* func, const ASTValueType& actual, size_t line);
+    void checkType(const ASTValueType& declared, const ASTValueType& actual, size_t line);
     ASTValueType determineType(ASTBase* expression);
-    std::string typeToString(const ASTValueType& type);
+    static std::string typeToString(const ASTValueType& type);
 private:
-    RuntimeEnvironment& env;
+    struct Scope {
+        std::unordered_map<std::string, const ASTFunction*> declared;
+        size_t level; // Number of function bodies the scope is nested in.
+    };
+
+    // Functions visible in each enclosing body, and the functions being checked.
+    std::vector<Scope> scopes;
+    std::vector<const ASTFunction*> functions;
+    // Expressions whose type is only known when they run, with the `and` or `or` operation
+    // whose operands have different types. Their static type is None.
+    std::unordered_map<const ASTBase*, const ASTBase*> dynamic;
+
+    void checkBody(std::vector<std::unique_ptr<ASTBase>>& body);
+    void checkStatement(ASTBase& statement);
+    void checkFunction(ASTFunction& function);
+    ASTValueType checkFunctionCall(ASTFunctionCall& functionCall);
+    // Returns the declaration, and the number of function scopes between the call and it.
+    const ASTFunction* lookupFunction(const std::string& name, size_t line, size_t& depth) const;
+    ASTValueType determineLogicalType(ASTBase& operation, ASTBase* left, ASTBase* right);
+    // Makes the expression dynamic if the operand is.
+    void markDynamic(const ASTBase* expression, const ASTBase* operand);
+    // Rejects a dynamic value where a declared type is expected.
+    void checkStatic(const ASTBase* value) const;
     inline bool isNumber(const ASTValueType& type);
 };
 
-#endif // CHECKER_HPP
\ No newline at end of file
+#endif // CHECKER_HPP
@@ -0,0 +1,396 @@
+#include "../../errors/include/errors.hpp"
+#include "include/compiler.hpp"
+
+#include <stdexcept>
+
+std::unique_ptr<CompiledProgram> Compiler::compile(const ASTProgram& programTree) {
+    auto compiled = std::make_unique<CompiledProgram>();
+    program = compiled.get();
+    chunk = &compiled->main;
+    nameIndexes.clear();
+
+    // The frame of the main program code block is opened by the VM.
+    compiled->frameSize = programTree.frameSize;
+    compiled->functions.resize(programTree.functionCount);
+    for (const std::unique_ptr<ASTBase>& child : programTree.body) {
+        if (child != nullptr) compileStatement(*child);
+    }
+    emit(OpCode::Halt, programTree.line);
+
+    program = nullptr;
+    chunk = nullptr;
+    return compiled;
+}
+
+void Compiler::compileStatement(const ASTBase& statement) {
+    switch (statement.type) {
+        case ASTType::FunctionDeclaration:
+            compileFunction(static_cast<const ASTFunction&>(statement));
+            break;
+        case ASTType::FunctionCall:
+            compileFunctionCall(static_cast<const ASTFunctionCall&>(statement));
+            emit(OpCode::Pop, statement.line);
+            break;
+        case ASTType::VariableDeclaration: {
+            const auto& declaration = static_cast<const ASTVariableDeclaration&>(statement);
+            if (declaration.value == nullptr) {
+                // Variable declared without a value. The variable in that time will be `null`.
+                emit(
+                    OpCode::DeclareEmpty,
+                    declaration.line,
+                    addName(declaration.name),
+                    declaration.slot,
+                    static_cast<size_t>(declaration.varType)
+                );
+                break;
+            }
+            compileExpression(declaration.value.get(), declaration.line);
+            emit(
+                OpCode::DeclareVariable,
+                declaration.line,
+                addName(declaration.name),
+                declaration.slot,
+                static_cast<size_t>(declaration.varType)
+            );
+            break;
+        }
+        case ASTType::VariableModify: {
+            const auto& variableModify = static_cast<const ASTVariableModify&>(statement);
+            compileExpression(variableModify.value.get(), variableModify.line);
+            const size_t line = variableModify.value ? variableModify.value->line : variableModify.line;
+            emitVariable(OpCode::StoreVariable, line, variableModify.name, variableModify.binding);
+            break;
+        }
+        case ASTType::Print: {
+            const auto& print = static_cast<const ASTPrint&>(statement);
+            compileExpression(print.expression.get(), print.line);
+            emit(OpCode::Print, print.line, print.newLine ? 1 : 0);
+            break;
+        }
+        case ASTType::Condition:
+            compileCondition(static_cast<const ASTCondition&>(statement));
+            break;
+        case ASTType::While:
+            compileWhile(static_cast<const ASTWhile&>(statement));
+            break;
+        case ASTType::Break:
+            compileBreak(static_cast<const ASTBreak&>(statement));
+            break;
+        case ASTType::Return:
+            compileReturn(static_cast<const ASTReturn&>(statement));
+            break;
+        case ASTType::ReadInput:
+        case ASTType::Variable:
+        case ASTType::Value:
+            compileExpression(&statement, statement.line);
+            emit(OpCode::Pop, statement.line);
+            break;
+        default:
+            throw std::runtime_error("Unknown AST type encountered during evaluation.");
+    }
+}
+
+void Compiler::compileExpression(const ASTBase* expression, size_t line) {
+    if (expression == nullptr) {
+        emit(OpCode::PushConstant, line, addConstant("null", ASTValueType::None));
+        return;
+    }
+
+    switch (expression->type) {
+        case ASTType::Value: {
+            const auto value = static_cast<const ASTValue*>(expression);
+            emit(OpCode::PushConstant, value->line, addConstant(value->value, value->valueType));
+            break;
+        }
+        case ASTType::Variable: {
+            const auto variable = static_cast<const ASTVariable*>(expression);
+            emitVariable(OpCode::LoadVariable, variable->line, variable->name, variable->binding);
+            break;
+        }
+        case ASTType::ReadInput: {
+            const auto read = static_cast<const ASTReadInput*>(expression);
+            if (read->out != nullptr) compileExpression(read->out.get(), read->line);
+            emit(OpCode::ReadInput, read->line, read->out != nullptr ? 1 : 0);
+            break;
+        }
+        case ASTType::TypeCast: {
+            const auto typeCast = static_cast<const ASTTypeCast*>(expression);
+            compileExpression(typeCast->value.get(), typeCast->line);
+            emit(OpCode::TypeCast, typeCast->line, static_cast<size_t>(typeCast->castType));
+            break;
+        }
+        case ASTType::FString:
+            compileFString(*static_cast<const ASTFString*>(expression));
+            break;
+        case ASTType::BinaryOperation:
+            compileBinaryOperation(*static_cast<const ASTBinaryOperation*>(expression));
+            break;
+        case ASTType::ComparisonOperation:
+            compileComparisonOperation(*static_cast<const ASTComparisonOperation*>(expression));
+            break;
+        case ASTType::OrOperation: {
+            const auto operation = static_cast<const ASTOrOperation*>(expression);
+            compileExpression(operation->left.get(), operation->line);
+            const size_t shortCircuit = emit(OpCode::JumpIfTrueKeep, operation->line);
+            emit(OpCode::Pop, operation->line);
+            compileExpression(operation->right.get(), operation->line);
+            patchJump(shortCircuit);
+            break;
+        }
+        case ASTType::AndOperation: {
+            const auto operation = static_cast<const ASTAndOperation*>(expression);
+            compileExpression(operation->left.get(), operation->line);
+            const size_t shortCircuit = emit(OpCode::JumpIfFalseKeep, operation->line);
+            emit(OpCode::Pop, operation->line);
+            compileExpression(operation->right.get(), operation->line);
+            patchJump(shortCircuit);
+            break;
+        }
+        case ASTType::FunctionCall:
+            compileFunctionCall(*static_cast<const ASTFunctionCall*>(expression));
+            break;
+        default:
+            throw ZynkError(
+                ZynkErrorType::RuntimeError,
+                "Invalid expression type encountered during evaluation.",
+                expression->line
+            );
+    }
+}
+
+void Compiler::compileBlock(const std::vector<std::unique_ptr<ASTBase>>& body, size_t line) {
+    emit(OpCode::EnterBlock, line);
+    blockDepth++;
+    for (const std::unique_ptr<ASTBase>& child : body) {
+        if (child != nullptr) compileStatement(*child);
+    }
+    blockDepth--;
+    emit(OpCode::ExitBlock, line);
+}
+
+void Compiler::compileFunction(const ASTFunction& function) {
+    auto prototype = std::make_unique<FunctionPrototype>();
+    prototype->declaration = &function;
+
+    // Function bodies are compiled into their own chunk, so the state of
+    // the enclosing code has to be restored afterwards.
+    Chunk* enclosingChunk = chunk;
+    std::vector<LoopContext> enclosingLoops = std::move(loops);
+    const size_t enclosingDepth = blockDepth;
+    const bool enclosingInsideFunction = insideFunction;
+
+    chunk = &prototype->chunk;
+    loops.clear();
+    blockDepth = 0;
+    insideFunction = true;
+
+    for (const std::unique_ptr<ASTBase>& child : function.body) {
+        if (child != nullptr) compileStatement(*child);
+    }
+    emit(OpCode::ReturnNone, function.line);
+
+    chunk = enclosingChunk;
+    loops = std::move(enclosingLoops);
+    blockDepth = enclosingDepth;
+    insideFunction = enclosingInsideFunction;
+
+    program->functions[function.id] = std::move(prototype);
+    emit(OpCode::DeclareFunction, function.line, function.id);
+}
+
+void Compiler::compileFunctionCall(const ASTFunctionCall& functionCall) {
+    for (const std::unique_ptr<ASTBase>& argument : functionCall.arguments) {
+        compileExpression(argument.get(), functionCall.line);
+    }
+    // The callee was resolved by the type checker, the VM only checks that it is in scope.
+    emit(OpCode::Call, functionCall.line, functionCall.function->id, functionCall.arguments.size(), functionCall.depth);
+}
+
+void Compiler::compileCondition(const ASTCondition& condition) {
+    compileExpression(condition.expression.get(), condition.line);
+    const size_t elseJump = emit(OpCode::JumpIfFalse, condition.line);
+    compileBlock(condition.body, condition.line);
+
+    if (condition.elseBody.empty()) {
+        patchJump(elseJump);
+        return;
+    }
+    const size_t endJump = emit(OpCode::Jump, condition.line);
+    patchJump(elseJump);
+    compileBlock(condition.elseBody, condition.line);
+    patchJump(endJump);
+}
+
+void Compiler::compileWhile(const ASTWhile& loop) {
+    // Like in the evaluator, the whole loop shares a single block.
+    emit(OpCode::EnterBlock, loop.line);
+    blockDepth++;
+
+    const size_t loopStart = chunk->code.size();
+    size_t exitJump;
+    size_t countedLoop = 0;
+    if (loop.counted.has_value()) {
+        // The condition and the statement stepping the counter, as a single instruction each.
+        countedLoop = addCountedLoop(loop);
+        exitJump = emit(OpCode::CountedTest, loop.value->line, 0, countedLoop);
+    } else {
+        compileExpression(loop.value.get(), loop.line);
+        exitJump = emit(OpCode::JumpIfFalse, loop.line);
+    }
+
+    loops.push_back({ blockDepth, {} });
+    const size_t bodySize = loop.counted.has_value() ? loop.body.size() - 1 : loop.body.size();
+    for (size_t i = 0; i < bodySize; i++) {
+        if (loop.body[i] != nullptr) compileStatement(*loop.body[i]);
+    }
+    if (loop.counted.has_value()) emit(OpCode::CountedStep, loop.counted->line, countedLoop);
+    emit(OpCode::Jump, loop.line, loopStart);
+
+    patchJump(exitJump);
+    for (const size_t breakJump : loops.back().breakJumps) {
+        patchJump(breakJump);
+    }
+    loops.pop_back();
+
+    blockDepth--;
+    emit(OpCode::ExitBlock, loop.line);
+}
+
+void Compiler::compileBreak(const ASTBreak& breakStatement) {
+    if (loops.empty()) {
+        throw ZynkError(
+            ZynkErrorType::SyntaxError,
+            "'break' outside of a loop.",
+            breakStatement.line
+        );
+    }
+    // Blocks opened inside the loop body have to be closed before jumping out.
+    for (size_t depth = blockDepth; depth > loops.back().blockDepth; depth--) {
+        emit(OpCode::ExitBlock, breakStatement.line);
+    }
+    loops.back().breakJumps.push_back(emit(OpCode::Jump, breakStatement.line));
+}
+
+void Compiler::compileReturn(const ASTReturn& returnStatement) {
+    if (!insideFunction) {
+        throw ZynkError(
+            ZynkErrorType::SyntaxError,
+            "'return' outside of a function.",
+            returnStatement.line
+        );
+    }
+    compileExpression(returnStatement.value.get(), returnStatement.line);
+    emit(OpCode::Return, returnStatement.line);
+}
+
+void Compiler::compileFString(const ASTFString& fString) {
+    for (const std::unique_ptr<ASTBase>& part : fString.parts) {
+        compileExpression(part.get(), fString.line);
+    }
+    emit(OpCode::Concat, fString.line, fString.parts.size(), fString.literalLength);
+}
+
+void Compiler::compileBinaryOperation(const ASTBinaryOperation& operation) {
+    compileExpression(operation.left.get(), operation.line);
+    compileExpression(operation.right.get(), operation.line);
+
+    switch (operation.op) {
+        case ASTBinaryOperator::Add:
+            emit(OpCode::Add, operation.line);
+            break;
+        case ASTBinaryOperator::Subtract:
+            emit(OpCode::Subtract, operation.line);
+            break;
+        case ASTBinaryOperator::Multiply:
+            emit(OpCode::Multiply, operation.line);
+            break;
+        case ASTBinaryOperator::Divide:
+            emit(OpCode::Divide, operation.line);
+            break;
+    }
+}
+
+void Compiler::compileComparisonOperation(const ASTComparisonOperation& operation) {
+    compileExpression(operation.left.get(), operation.line);
+    compileExpression(operation.right.get(), operation.line);
+
+    switch (operation.op) {
+        case ASTComparisonOperator::Equal:
+            emit(OpCode::Equal, operation.line);
+            break;
+        case ASTComparisonOperator::NotEqual:
+            emit(OpCode::NotEqual, operation.line);
+            break;
+        case ASTComparisonOperator::Greater:
+            emit(OpCode::Greater, operation.line);
+            break;
+        case ASTComparisonOperator::GreaterOrEqual:
+            emit(OpCode::GreaterOrEqual, operation.line);
+            break;
+        case ASTComparisonOperator::Less:
+            emit(OpCode::Less, operation.line);
+            break;
+        case ASTComparisonOperator::LessOrEqual:
+            emit(OpCode::LessOrEqual, operation.line);
+            break;
+    }
+}
+
+size_t Compiler::emit(OpCode op, size_t line, size_t a, size_t b, size_t c) {
+    chunk->code.push_back({
+        op,
+        static_cast<uint32_t>(a),
+        static_cast<uint32_t>(b),
+        static_cast<uint32_t>(c),
+        static_cast<uint32_t>(line)
+    });
+    return chunk->code.size() - 1;
+}
+
+size_t Compiler::emitVariable(OpCode op, size_t line, const std::string& name, const ASTBinding& binding) {
+    const size_t slot = binding.slot == ASTBinding::Unresolved ? UNRESOLVED_SLOT : binding.slot;
+    return emit(op, line, addName(name), slot, binding.depth);
+}
+
+void Compiler::patchJump(size_t instruction) {
+    chunk->code[instruction].a = static_cast<uint32_t>(chunk->code.size());
+}
+
+uint32_t Compiler::addConstant(const std::string& value, ASTValueType type) {
+    program->constants.push_back(Value::fromLiteral(value, type));
+    return static_cast<uint32_t>(program->constants.size() - 1);
+}
+
+uint32_t Compiler::addCountedLoop(const ASTWhile& loop) {
+    const ASTCountedLoop& counted = *loop.counted;
+    const auto& comparison = static_cast<const ASTComparisonOperation&>(*loop.value);
+    CountedLoop countedLoop;
+    countedLoop.counter = addName(static_cast<const ASTVariable&>(*comparison.left).name);
+    countedLoop.counterSlot = static_cast<uint32_t>(counted.counter.slot);
+    if (counted.bound->type == ASTType::Value) {
+        const auto value = static_cast<const ASTValue*>(counted.bound);
+        countedLoop.bound = addConstant(value->value, value->valueType);
+        countedLoop.boundSlot = UNRESOLVED_SLOT;
+    } else {
+        const auto variable = static_cast<const ASTVariable*>(counted.bound);
+        countedLoop.bound = addName(variable->name);
+        countedLoop.boundSlot = static_cast<uint32_t>(variable->binding.slot);
+    }
+    countedLoop.boundLine = static_cast<uint32_t>(counted.bound->line);
+    countedLoop.comparison = counted.comparison;
+    countedLoop.step = counted.step;
+    countedLoop.amount = counted.amount;
+
+    program->countedLoops.push_back(countedLoop);
+    return static_cast<uint32_t>(program->countedLoops.size() - 1);
+}
+
+uint32_t Compiler::addName(const std::string& name) {
+    auto found = nameIndexes.find(name);
+    if (found != nameIndexes.end()) return found->second;
+
+    program->names.push_back(name);
+    const uint32_t index = static_cast<uint32_t>(program->names.size() - 1);
+    nameIndexes.emplace(name, index);
+    return index;
+}
@@ -0,0 +1,90 @@
+#ifndef BYTECODE_H
+#define BYTECODE_H
+
+#include "../../../parsing/include/ast.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <memory>
+
+enum class OpCode : uint8_t {
+    PushConstant,   // a: constant index.
+    Pop,
+    LoadVariable,   // a: name index, b: slot, c: depth.
+    StoreVariable,  // a: name index, b: slot, c: depth.
+    DeclareVariable, // a: name index, b: slot, c: declared type.
+    DeclareEmpty,   // a: name index, b: slot, c: declared type.
+    DeclareFunction, // a: function id.
+    Print,          // a: 1 if a new line should be printed.
+    ReadInput,      // a: 1 if a prompt is on the stack.
+    Concat,         // a: number of values to join, b: length of their literal text (f-strings).
+    TypeCast,       // a: target type.
+    Add,
+    Subtract,
+    Multiply,
+    Divide,
+    Equal,
+    NotEqual,
+    Greater,
+    GreaterOrEqual,
+    Less,
+    LessOrEqual,
+    Jump,           // a: target instruction.
+    JumpIfFalse,    // a: target instruction, pops the condition.
+    JumpIfFalseKeep, // a: target instruction, keeps the condition (and).
+    JumpIfTrueKeep, // a: target instruction, keeps the condition (or).
+    CountedTest,    // a: target instruction if the counter fails the bound, b: counted loop index.
+    CountedStep,    // a: counted loop index.
+    EnterBlock,
+    ExitBlock,
+    Call,           // a: function id, b: number of arguments, c: depth of the declaration.
+    Return,
+    ReturnNone,
+    Halt,
+};
+
+struct Instruction {
+    OpCode op;
+    uint32_t a = 0;
+    uint32_t b = 0;
+    uint32_t c = 0;
+    uint32_t line = 0;
+};
+
+// Slot operand of a variable the resolver couldn't bind.
+constexpr uint32_t UNRESOLVED_SLOT = UINT32_MAX;
+
+// Counted loop of the program, see ASTCountedLoop. The counter, and the bound unless it is
+// a constant, are variables of the function running the loop.
+struct CountedLoop {
+    uint32_t counter;   // Name index.
+    uint32_t counterSlot;
+    uint32_t bound;     // Name index, or constant index if the bound has no slot.
+    uint32_t boundSlot; // UNRESOLVED_SLOT for a constant bound.
+    uint32_t boundLine;
+    ASTComparisonOperator comparison;
+    ASTBinaryOperator step;
+    int64_t amount;
+};
+
+struct Chunk {
+    std::vector<Instruction> code;
+};
+
+struct FunctionPrototype {
+    // Declaration the prototype was compiled from. Used for arity and type checks,
+    // so the program AST has to outlive the compiled program.
+    const ASTFunction* declaration;
+    Chunk chunk;
+};
+
+struct CompiledProgram {
+    Chunk main;
+    size_t frameSize = 0;
+    std::vector<std::unique_ptr<FunctionPrototype>> functions; // Indexed by function id.
+    std::vector<Value> constants;
+    std::vector<std::string> names;
+    std::vector<CountedLoop> countedLoops;
+};
+
+#endif // BYTECODE_H
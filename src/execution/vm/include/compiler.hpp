@@ -0,0 +1,44 @@
+#ifndef COMPILER_H
+#define COMPILER_H
+
+#include "bytecode.hpp"
+#include <unordered_map>
+
+class Compiler {
+public:
+    std::unique_ptr<CompiledProgram> compile(const ASTProgram& program);
+private:
+    struct LoopContext {
+        size_t blockDepth;
+        std::vector<size_t> breakJumps;
+    };
+
+    std::unordered_map<std::string, uint32_t> nameIndexes;
+    CompiledProgram* program = nullptr;
+    Chunk* chunk = nullptr;
+    std::vector<LoopContext> loops;
+    size_t blockDepth = 0;
+    bool insideFunction = false;
+
+    void compileStatement(const ASTBase& statement);
+    void compileExpression(const ASTBase* expression, size_t line);
+    void compileBlock(const std::vector<std::unique_ptr<ASTBase>>& body, size_t line);
+    void compileFunction(const ASTFunction& function);
+    void compileFunctionCall(const ASTFunctionCall& functionCall);
+    void compileCondition(const ASTCondition& condition);
+    void compileWhile(const ASTWhile& loop);
+    void compileBreak(const ASTBreak& breakStatement);
+    void compileReturn(const ASTReturn& returnStatement);
+    void compileFString(const ASTFString& fString);
+    void compileBinaryOperation(const ASTBinaryOperation& operation);
+    void compileComparisonOperation(const ASTComparisonOperation& operation);
+
+    size_t emit(OpCode op, size_t line, size_t a = 0, size_t b = 0, size_t c = 0);
+    size_t emitVariable(OpCode op, size_t line, const std::string& name, const ASTBinding& binding);
+    void patchJump(size_t instruction);
+    uint32_t addConstant(const std::string& value, ASTValueType type);
+    uint32_t addName(const std::string& name);
+    uint32_t addCountedLoop(const ASTWhile& loop);
+};
+
+#endif // COMPILER_H
@@ -0,0 +1,41 @@
+#ifndef VM_H
+#define VM_H
+
+#include "bytecode.hpp"
+#include "../../include/runtime.hpp"
+#include "../../typechecker/include/checker.hpp"
+#include "../../jit/include/jit.hpp"
+#include <memory>
+
+class VirtualMachine {
+public:
+    explicit VirtualMachine(bool useJit = false);
+
+    RuntimeEnvironment env;
+    void run(const CompiledProgram& program);
+private:
+    struct CallFrame {
+        const Chunk* chunk;
+        const ASTFunction* function; // nullptr for the main program code.
+        size_t ip;
+        size_t blockBase; // Number of blocks opened before the call.
+    };
+
+    std::vector<Value> stack;
+    std::vector<CallFrame> frames;
+    size_t openBlocks = 0;
+    std::unique_ptr<Jit> jit; // Null unless enabled.
+
+    inline Value pop();
+    inline Variable* getVariable(const CompiledProgram& program, const Instruction& instruction);
+    // Variable of the function running, for the instructions of counted loops.
+    inline Variable* getVariable(const CompiledProgram& program, uint32_t name, uint32_t slot, size_t line);
+
+    void callFunction(const FunctionPrototype& prototype, const Instruction& instruction);
+    void returnFromFunction(Value result);
+
+    void binaryOperation(const ASTBinaryOperator op, size_t line);
+    void comparisonOperation(const ASTComparisonOperator op);
+};
+
+#endif // VM_H
@@ -0,0 +1,277 @@
+#include "../../errors/include/errors.hpp"
+#include "../include/evaluator.hpp"
+#include "include/vm.hpp"
+
+#include <iostream>
+
+VirtualMachine::VirtualMachine(bool useJit) : jit(useJit ? std::make_unique<Jit>() : nullptr) {};
+
+void VirtualMachine::run(const CompiledProgram& program) {
+    stack.clear();
+    frames.clear();
+    openBlocks = 0;
+    frames.push_back({ &program.main, nullptr, 0, 0 });
+    env.enterProgram(program.frameSize); // Main program code block.
+
+    while (true) {
+        CallFrame& frame = frames.back();
+        const Instruction& instruction = frame.chunk->code[frame.ip++];
+
+        switch (instruction.op) {
+            case OpCode::PushConstant:
+                stack.push_back(program.constants[instruction.a]);
+                break;
+            case OpCode::Pop:
+                stack.pop_back();
+                break;
+            case OpCode::LoadVariable: {
+                stack.push_back(getVariable(program, instruction)->value);
+                break;
+            }
+            case OpCode::StoreVariable: {
+                Value value = pop();
+                Variable* variable = getVariable(program, instruction);
+                variable->value = std::move(value);
+                break;
+            }
+            case OpCode::DeclareVariable: {
+                const auto declared = static_cast<ASTValueType>(instruction.c);
+                env.declareVariable(program.names[instruction.a], instruction.b, declared, pop(), instruction.line);
+                break;
+            }
+            case OpCode::DeclareEmpty:
+                env.declareVariable(
+                    program.names[instruction.a],
+                    instruction.b,
+                    static_cast<ASTValueType>(instruction.c),
+                    Value(),
+                    instruction.line
+                );
+                break;
+            case OpCode::DeclareFunction:
+                // The environment only needs the signature, the body lives in the prototype chunk.
+                env.declareFunction(program.functions[instruction.a]->declaration);
+                break;
+            case OpCode::Print: {
+                std::cout << stack.back() << (instruction.a ? "\n" : "");
+                stack.pop_back();
+                break;
+            }
+            case OpCode::ReadInput: {
+                if (instruction.a) std::cout << pop();
+                std::string input;
+                std::getline(std::cin, input);
+                stack.push_back(Value::fromString(std::move(input)));
+                break;
+            }
+            case OpCode::Concat: {
+                const size_t first = stack.size() - instruction.a;
+                std::string result;
+                result.reserve(instruction.b + instruction.a * 8);
+                for (size_t i = first; i < stack.size(); i++) {
+                    stack[i].appendTo(result);
+                }
+                stack.resize(first);
+                stack.push_back(Value::fromString(std::move(result)));
+                break;
+            }
+            case OpCode::TypeCast: {
+                Value& value = stack.back();
+                try {
+                    value = castValue(value, static_cast<ASTValueType>(instruction.a));
+                } catch (const ZynkError& err) {
+                    throw ZynkError(err.base_type, err.what(), instruction.line);
+                }
+                break;
+            }
+            case OpCode::Add:
+                binaryOperation(ASTBinaryOperator::Add, instruction.line);
+                break;
+            case OpCode::Subtract:
+                binaryOperation(ASTBinaryOperator::Subtract, instruction.line);
+                break;
+            case OpCode::Multiply:
+                binaryOperation(ASTBinaryOperator::Multiply, instruction.line);
+                break;
+            case OpCode::Divide:
+                binaryOperation(ASTBinaryOperator::Divide, instruction.line);
+                break;
+            case OpCode::Equal:
+                comparisonOperation(ASTComparisonOperator::Equal);
+                break;
+            case OpCode::NotEqual:
+                comparisonOperation(ASTComparisonOperator::NotEqual);
+                break;
+            case OpCode::Greater:
+                comparisonOperation(ASTComparisonOperator::Greater);
+                break;
+            case OpCode::GreaterOrEqual:
+                comparisonOperation(ASTComparisonOperator::GreaterOrEqual);
+                break;
+            case OpCode::Less:
+                comparisonOperation(ASTComparisonOperator::Less);
+                break;
+            case OpCode::LessOrEqual:
+                comparisonOperation(ASTComparisonOperator::LessOrEqual);
+                break;
+            case OpCode::Jump:
+                frame.ip = instruction.a;
+                break;
+            case OpCode::JumpIfFalse:
+                if (!pop().isTruthy()) frame.ip = instruction.a;
+                break;
+            case OpCode::JumpIfFalseKeep:
+                if (!stack.back().isTruthy()) frame.ip = instruction.a;
+                break;
+            case OpCode::JumpIfTrueKeep:
+                if (stack.back().isTruthy()) frame.ip = instruction.a;
+                break;
+            case OpCode::CountedTest: {
+                const CountedLoop& loop = program.countedLoops[instruction.b];
+                const Value& counter = getVariable(program, loop.counter, loop.counterSlot, instruction.line)->value;
+                const Value& bound = loop.boundSlot == UNRESOLVED_SLOT
+                    ? program.constants[loop.bound]
+                    : getVariable(program, loop.bound, loop.boundSlot, loop.boundLine)->value;
+
+                const bool status = counter.type() == ASTValueType::Integer && bound.type() == ASTValueType::Integer
+                    ? compareIntegers(counter.asInt(), bound.asInt(), loop.comparison)
+                    : compareValue(counter, bound, loop.comparison).isTruthy();
+                if (!status) frame.ip = instruction.a;
+                break;
+            }
+            case OpCode::CountedStep: {
+                const CountedLoop& loop = program.countedLoops[instruction.a];
+                Variable* counter = getVariable(program, loop.counter, loop.counterSlot, instruction.line);
+                if (counter->value.type() != ASTValueType::Integer) {
+                    stack.push_back(counter->value);
+                    stack.push_back(Value::fromInt(loop.amount));
+                    binaryOperation(loop.step, instruction.line);
+                    counter->value = pop();
+                    break;
+                }
+                try {
+                    counter->value = Value::fromInt(calculateInteger(counter->value.asInt(), loop.amount, loop.step));
+                } catch (const ZynkError& err) {
+                    throw ZynkError(err.base_type, err.what(), instruction.line);
+                }
+                break;
+            }
+            case OpCode::EnterBlock:
+                env.enterNewBlock();
+                openBlocks++;
+                break;
+            case OpCode::ExitBlock:
+                env.exitCurrentBlock();
+                openBlocks--;
+                break;
+            case OpCode::Call:
+                callFunction(*program.functions[instruction.a], instruction);
+                break;
+            case OpCode::Return:
+                returnFromFunction(pop());
+                break;
+            case OpCode::ReturnNone: {
+                const ASTFunction* function = frame.function;
+                if (function->returnType != ASTValueType::None) {
+                    throw ZynkError(
+                        ZynkErrorType::TypeError,
+                        "Function '" + function->name + "' does not return a value of type "
+                        + TypeChecker::typeToString(function->returnType) + " in all control paths.",
+                        function->line
+                    );
+                }
+                returnFromFunction(Value());
+                break;
+            }
+            case OpCode::Halt:
+                env.exitFrame();
+                return;
+        }
+    }
+}
+
+inline Value VirtualMachine::pop() {
+    Value value = std::move(stack.back());
+    stack.pop_back();
+    return value;
+}
+
+inline Variable* VirtualMachine::getVariable(const CompiledProgram& program, const Instruction& instruction) {
+    ASTBinding binding;
+    binding.depth = instruction.c;
+    if (instruction.b != UNRESOLVED_SLOT) binding.slot = instruction.b;
+    return env.getVariable(program.names[instruction.a], binding, instruction.line);
+}
+
+inline Variable* VirtualMachine::getVariable(const CompiledProgram& program, uint32_t name, uint32_t slot, size_t line) {
+    ASTBinding binding;
+    binding.slot = slot;
+    return env.getVariable(program.names[name], binding, line);
+}
+
+void VirtualMachine::callFunction(const FunctionPrototype& prototype, const Instruction& instruction) {
+    const ASTFunction* function = prototype.declaration;
+    const size_t argumentCount = instruction.b;
+    const size_t line = instruction.line;
+    const size_t scope = env.getFunctionScope(*function, instruction.c, line);
+
+    if (env.isRecursionDepthExceeded()) {
+        throw ZynkError(
+            ZynkErrorType::RecursionError,
+            "Exceeded maximum recursion depth of " + std::to_string(env.MAX_DEPTH) + ".",
+            line
+        );
+    }
+
+    const size_t firstArgument = stack.size() - argumentCount;
+    if (jit != nullptr) {
+        Value result;
+        if (jit->call(*function, instruction.c, stack.data() + firstArgument, env, result)) {
+            stack.resize(firstArgument);
+            stack.push_back(std::move(result));
+            return;
+        }
+    }
+
+    env.enterFunction(*function, scope);
+    for (size_t i = 0; i < argumentCount; i++) {
+        const auto argument = static_cast<const ASTFunctionArgument*>(function->arguments[i].get());
+        env.bindArgument(argument->slot, argument->valueType, std::move(stack[firstArgument + i]));
+    }
+    stack.resize(firstArgument);
+
+    frames.push_back({ &prototype.chunk, function, 0, openBlocks });
+    openBlocks++;
+}
+
+void VirtualMachine::returnFromFunction(Value result) {
+    // Closes every block opened inside the function, including its own.
+    const size_t blockBase = frames.back().blockBase;
+    while (openBlocks > blockBase + 1) {
+        env.exitCurrentBlock();
+        openBlocks--;
+    }
+    env.exitFrame();
+    openBlocks--;
+
+    frames.pop_back();
+    stack.push_back(std::move(result));
+}
+
+void VirtualMachine::binaryOperation(const ASTBinaryOperator op, size_t line) {
+    const Value right = pop();
+    Value& left = stack.back();
+
+    try {
+        left = calculateValue(left, right, op);
+    } catch (const ZynkError& err) {
+        throw ZynkError(err.base_type, err.what(), line);
+    }
+}
+
+void VirtualMachine::comparisonOperation(const ASTComparisonOperator op) {
+    const Value right = pop();
+    Value& left = stack.back();
+
+    left = compareValue(left, right, op);
+}
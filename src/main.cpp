@@ -47,7 +47,31 @@ int main(int argc, char* argv[]) {
 		std::cout << "Successfully created a new main.zk file." << std::endl;
 		return 0;
 	}
-	ZynkInterpreter interpreter;
+	ExecutionEngine engine = ExecutionEngine::TreeWalker;
+	if (cli.args.engine == "vm") engine = ExecutionEngine::VM;
+	else if (cli.args.engine == "closure") engine = ExecutionEngine::Closure;
+	const size_t inlineBudget = cli.args.inlineBudget.empty() ? DEFAULT_INLINE_BUDGET : std::stoul(cli.args.inlineBudget);
+	ZynkInterpreter interpreter(engine, cli.args.jit, cli.args.diagnostics, inlineBudget);
+
+	if (cli.args.build) {
+		try {
+			interpreter.buildFile(cli.args.file_path, cli.args.output);
+		} catch (const ZynkError& error) {
+			error.print(cli.args.file_path);
+			return -1;
+		}
+		std::cout << "Successfully built " << cli.args.output << "." << std::endl;
+		return 0;
+	}
+	if (cli.args.dumpOptimized) {
+		try {
+			std::cout << interpreter.dumpOptimized(cli.args.file_path);
+		} catch (const ZynkError& error) {
+			error.print(cli.args.file_path);
+			return -1;
+		}
+		return 0;
+	}
 	try {
 		interpreter.interpretFile(cli.args.file_path);
 	} catch (const ZynkError& error) {
@@ -1,9 +1,12 @@
 #ifndef AST_H
 #define AST_H
 
+#include "../../value/include/value.hpp"
+#include <cstdint>
 #include <vector>
 #include <string>
 #include <memory>
+#include <optional>
 
 enum class ASTType {
     Program,
@@ -28,17 +31,62 @@ enum class ASTType {
     Return,
 };
 
-enum class ASTValueType {
-    String,
-    Integer,
-    Float,
-    Bool,
-    None,
+// Operators are decoded from their tokens once by the parser.
+enum class ASTBinaryOperator {
+    Add,
+    Subtract,
+    Multiply,
+    Divide,
+};
+
+enum class ASTComparisonOperator {
+    Equal,
+    NotEqual,
+    Greater,
+    GreaterOrEqual,
+    Less,
+    LessOrEqual,
+};
+
+inline const char* operatorToString(ASTBinaryOperator op) {
+    switch (op) {
+        case ASTBinaryOperator::Add: return "+";
+        case ASTBinaryOperator::Subtract: return "-";
+        case ASTBinaryOperator::Multiply: return "*";
+        case ASTBinaryOperator::Divide: return "/";
+    }
+    return "?";
+}
+
+inline const char* operatorToString(ASTComparisonOperator op) {
+    switch (op) {
+        case ASTComparisonOperator::Equal: return "==";
+        case ASTComparisonOperator::NotEqual: return "!=";
+        case ASTComparisonOperator::Greater: return ">";
+        case ASTComparisonOperator::GreaterOrEqual: return ">=";
+        case ASTComparisonOperator::Less: return "<";
+        case ASTComparisonOperator::LessOrEqual: return "<=";
+    }
+    return "?";
+}
+
+// Where a variable lives at runtime, filled in by the resolver. `depth` is the number
+// of function scopes between the use and the declaration, `slot` is the index of the
+// variable in the frame of that function.
+struct ASTBinding {
+    static constexpr size_t Unresolved = SIZE_MAX;
+
+    size_t depth = 0;
+    size_t slot = Unresolved;
+    ASTValueType type = ASTValueType::None; // Declared type of the variable.
+    bool initialized = true; // False if declared without a value, the variable holds null until assigned.
 };
 
 struct ASTBase {
     const ASTType type;
     size_t line;
+    // Type of the expression, set by the type checker before the program is executed.
+    ASTValueType staticType = ASTValueType::None;
 
     ASTBase(ASTType type, size_t line) : type(type), line(line) {}
     virtual ~ASTBase() = default;
@@ -48,9 +96,13 @@ struct ASTBase {
 struct ASTProgram : public ASTBase {
     ASTProgram(const size_t line = 1) : ASTBase(ASTType::Program, line) {}
     std::vector<std::unique_ptr<ASTBase>> body;
+    size_t frameSize = 0; // Number of variable slots, set by the resolver.
+    size_t functionCount = 0; // Number of function declarations, set by the resolver.
 
     std::unique_ptr<ASTBase> clone() const override {
         auto newProgram = std::make_unique<ASTProgram>(line);
+        newProgram->frameSize = frameSize;
+        newProgram->functionCount = functionCount;
         for (const auto& stmt : body) {
             newProgram->body.push_back(stmt->clone());
         }
@@ -66,9 +118,17 @@ struct ASTFunction : public ASTBase {
 
     std::vector<std::unique_ptr<ASTBase>> arguments;
     std::vector<std::unique_ptr<ASTBase>> body;
+    size_t frameSize = 0; // Number of variable slots, set by the resolver.
+    size_t id = 0; // Index of the function in the function table of the program, set by the resolver.
+    // Neither prints, reads input nor uses variables of enclosing functions, nor do the functions
+    // it calls. Set by the optimizer.
+    bool pure = false;
 
     std::unique_ptr<ASTBase> clone() const override {
         auto newFunction = std::make_unique<ASTFunction>(name, returnType, line);
+        newFunction->frameSize = frameSize;
+        newFunction->id = id;
+        newFunction->pure = pure;
         for (const auto& arg : arguments) {
             newFunction->arguments.push_back(arg->clone());
         }
@@ -84,9 +144,12 @@ struct ASTFunctionArgument : public ASTBase {
         : ASTBase(ASTType::FunctionArgument, line), name(name), valueType(valueType) {}
     const std::string name;
     const ASTValueType valueType;
+    size_t slot = 0;
 
     std::unique_ptr<ASTBase> clone() const override {
-        return std::make_unique<ASTFunctionArgument>(name, valueType, line);
+        auto newArgument = std::make_unique<ASTFunctionArgument>(name, valueType, line);
+        newArgument->slot = slot;
+        return newArgument;
     }
 };
 
@@ -95,6 +158,10 @@ struct ASTFunctionCall : public ASTBase {
         : ASTBase(ASTType::FunctionCall, line), name(name) {}
     const std::string name;
     std::vector<std::unique_ptr<ASTBase>> arguments;
+    // Called declaration, cached by the type checker, and the number of function
+    // scopes between the call and that declaration. Clones have to be checked again.
+    const ASTFunction* function = nullptr;
+    size_t depth = 0;
 
     std::unique_ptr<ASTBase> clone() const override {
         auto newFuncCall = std::make_unique<ASTFunctionCall>(name, line);
@@ -132,9 +199,14 @@ struct ASTVariableDeclaration : public ASTBase {
     const std::string name;
     const ASTValueType varType;
     std::unique_ptr<ASTBase> value;
+    size_t slot = 0;
 
     std::unique_ptr<ASTBase> clone() const override {
-        return std::make_unique<ASTVariableDeclaration>(name, varType, value ? value->clone() : nullptr, line);
+        auto newDeclaration = std::make_unique<ASTVariableDeclaration>(
+            name, varType, value ? value->clone() : nullptr, line
+        );
+        newDeclaration->slot = slot;
+        return newDeclaration;
     }
 };
 
@@ -143,40 +215,64 @@ struct ASTVariableModify : public ASTBase {
         : ASTBase(ASTType::VariableModify, line), name(name), value(std::move(value)) {}
     const std::string name;
     std::unique_ptr<ASTBase> value;
+    ASTBinding binding;
 
     std::unique_ptr<ASTBase> clone() const override {
-        return std::make_unique<ASTVariableModify>(name, value ? value->clone() : nullptr, line);
-    }
-};
-
-struct ASTFString : public ASTBase {
-    ASTFString(const std::string& value, size_t line)
-        : ASTBase(ASTType::FString, line), value(value) {}
-    const std::string value;
-
-    std::unique_ptr<ASTBase> clone() const override {
-        return std::make_unique<ASTFString>(value, line);
+        auto newModify = std::make_unique<ASTVariableModify>(name, value ? value->clone() : nullptr, line);
+        newModify->binding = binding;
+        return newModify;
     }
 };
 
 struct ASTValue : public ASTBase {
     ASTValue(const std::string& value, ASTValueType type, size_t line)
-        : ASTBase(ASTType::Value, line), value(value), valueType(type) {}
+        : ASTBase(ASTType::Value, line), value(value), valueType(type), constant(Value::fromLiteral(value, type)) {}
+    ASTValue(const Value& constant, ASTValueType type, size_t line)
+        : ASTBase(ASTType::Value, line), value(constant.toString()), valueType(type), constant(constant) {}
     std::string value;
     const ASTValueType valueType;
+    // Literal decoded once at parse time, so evaluation doesn't have to parse the text.
+    const Value constant;
 
     std::unique_ptr<ASTBase> clone() const override {
         return std::make_unique<ASTValue>(value, valueType, line);
     }
 };
 
+struct ASTFString : public ASTBase {
+    ASTFString(const std::string& value, size_t line)
+        : ASTBase(ASTType::FString, line), value(value) {}
+    const std::string value;
+    // Literal text and embedded expressions in order, split by the parser.
+    std::vector<std::unique_ptr<ASTBase>> parts;
+    size_t literalLength = 0; // Total length of the literal parts, to size the result up front.
+
+    void addLiteral(const std::string& text) {
+        if (text.empty()) return;
+        parts.push_back(std::make_unique<ASTValue>(text, ASTValueType::String, line));
+        literalLength += text.size();
+    }
+
+    std::unique_ptr<ASTBase> clone() const override {
+        auto newFString = std::make_unique<ASTFString>(value, line);
+        for (const auto& part : parts) {
+            newFString->parts.push_back(part->clone());
+        }
+        newFString->literalLength = literalLength;
+        return newFString;
+    }
+};
+
 struct ASTVariable : public ASTBase {
     ASTVariable(const std::string& name, size_t line)
         : ASTBase(ASTType::Variable, line), name(name) {}
     const std::string name;
+    ASTBinding binding;
 
     std::unique_ptr<ASTBase> clone() const override {
-        return std::make_unique<ASTVariable>(name, line);
+        auto newVariable = std::make_unique<ASTVariable>(name, line);
+        newVariable->binding = binding;
+        return newVariable;
     }
 };
 
@@ -209,11 +305,26 @@ struct ASTReadInput : public ASTBase {
     }
 };
 
+// While loop stepping an int counter, recognized by the optimizer. The condition compares the
+// counter with a bound the loop never assigns, and the last statement of the body, the only one
+// assigning the counter, adds or subtracts a constant. Engines may keep the counter in a native
+// integer while the counter and the bound hold ints.
+struct ASTCountedLoop {
+    ASTBinding counter;
+    const ASTBase* bound; // Right operand of the condition, a value or a variable of the same function.
+    ASTComparisonOperator comparison;
+    ASTBinaryOperator step; // Add or Subtract.
+    int64_t amount;
+    size_t line; // Of the operation stepping the counter, where an overflow is reported.
+};
+
 struct ASTWhile : public ASTBase {
     ASTWhile(std::unique_ptr<ASTBase> value, size_t line)
         : ASTBase(ASTType::While, line), value(std::move(value)) {}
     std::unique_ptr<ASTBase> value;
     std::vector<std::unique_ptr<ASTBase>> body;
+    // Set by the optimizer. Not cloned, clones have to be recognized again.
+    std::optional<ASTCountedLoop> counted;
 
     std::unique_ptr<ASTBase> clone() const override {
         auto newWhile = std::make_unique<ASTWhile>(value ? value->clone() : nullptr, line);
@@ -244,10 +355,10 @@ struct ASTTypeCast : public ASTBase {
 };
 
 struct ASTBinaryOperation : public ASTBase {
-    ASTBinaryOperation(std::unique_ptr<ASTBase> left, const std::string& op, std::unique_ptr<ASTBase> right, size_t line)
+    ASTBinaryOperation(std::unique_ptr<ASTBase> left, ASTBinaryOperator op, std::unique_ptr<ASTBase> right, size_t line)
         : ASTBase(ASTType::BinaryOperation, line), left(std::move(left)), op(op), right(std::move(right)) {}
     std::unique_ptr<ASTBase> left;
-    const std::string op;
+    const ASTBinaryOperator op;
     std::unique_ptr<ASTBase> right;
 
     std::unique_ptr<ASTBase> clone() const override {
@@ -261,11 +372,11 @@ struct ASTBinaryOperation : public ASTBase {
 };
 
 struct ASTComparisonOperation : public ASTBase {
-    ASTComparisonOperation(std::unique_ptr<ASTBase> left, const std::string& op, std::unique_ptr<ASTBase> right, size_t line)
+    ASTComparisonOperation(std::unique_ptr<ASTBase> left, ASTComparisonOperator op, std::unique_ptr<ASTBase> right, size_t line)
         : ASTBase(ASTType::ComparisonOperation, line), left(std::move(left)), op(op), right(std::move(right)) {}
 
     std::unique_ptr<ASTBase> left;
-    const std::string op;
+    const ASTComparisonOperator op;
     std::unique_ptr<ASTBase> right;
 
     std::unique_ptr<ASTBase> clone() const override {
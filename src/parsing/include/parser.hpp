@@ -19,6 +19,8 @@ private:
 	Token currentToken() const;
 
 	ASTValueType parseValueType() const;
+	ASTBinaryOperator parseBinaryOperator(TokenType type) const;
+	ASTComparisonOperator parseComparisonOperator(TokenType type) const;
 	std::unique_ptr<ASTBase> parseFunctionDeclaration();
 	std::unique_ptr<ASTBase> parseFunctionCall(bool isFinalInstruction = true);
 	std::unique_ptr<ASTBase> parseFunctionArgument();
@@ -27,6 +29,7 @@ private:
 	std::unique_ptr<ASTBase> parseReturnStatement();
 	std::unique_ptr<ASTBase> parseTypeCast(TokenType type);
 	std::unique_ptr<ASTBase> parsePrimaryExpression();
+	std::unique_ptr<ASTBase> parseFString(const std::string& value, size_t line) const;
 	std::unique_ptr<ASTBase> parseIfStatement();
 	std::unique_ptr<ASTBase> parsePrintStatement(bool newLine);
 	std::unique_ptr<ASTBase> parseReadStatement(bool isFinalInstruction = true);
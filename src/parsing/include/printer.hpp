@@ -0,0 +1,25 @@
+#ifndef PRINTER_H
+#define PRINTER_H
+
+#include "ast.hpp"
+#include <sstream>
+#include <string>
+
+// Prints a program tree back as Zynk source. Operations are parenthesized when nested,
+// so the output parses back to the same tree.
+class ASTPrinter {
+public:
+    std::string print(const ASTProgram& program);
+private:
+    std::ostringstream out;
+    size_t indent = 0;
+
+    void printBody(const std::vector<std::unique_ptr<ASTBase>>& body);
+    void printStatement(const ASTBase& statement);
+    std::string expression(const ASTBase* expression) const;
+    // Like expression, but in parentheses if it is an operation.
+    std::string operand(const ASTBase* expression) const;
+    void line(const std::string& text);
+};
+
+#endif // PRINTER_H
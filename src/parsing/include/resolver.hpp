@@ -0,0 +1,46 @@
+#ifndef RESOLVER_H
+#define RESOLVER_H
+
+#include "ast.hpp"
+#include <unordered_map>
+
+// Binds every variable use to the frame slot of its declaration, under lexical scoping.
+// Runs once over the parsed program, before it is executed.
+class Resolver {
+public:
+    void resolve(ASTProgram& program);
+private:
+    struct Declaration {
+        size_t slot;
+        ASTValueType type;
+        bool initialized;
+    };
+
+    struct Scope {
+        std::unordered_map<std::string, Declaration> variables;
+        // Function bodies are resolved when the scope ends, so they can see
+        // every variable declared in the scope they were declared in.
+        std::vector<ASTFunction*> functions;
+    };
+
+    struct FunctionScope {
+        std::vector<Scope> scopes;
+        size_t nextSlot = 0;
+        size_t frameSize = 0;
+    };
+
+    std::vector<FunctionScope> functions;
+    size_t functionCount = 0;
+
+    void resolveBody(std::vector<std::unique_ptr<ASTBase>>& body);
+    void resolveStatement(ASTBase& statement);
+    void resolveExpression(ASTBase* expression);
+    void resolveFunction(ASTFunction& function);
+
+    void beginScope();
+    void endScope();
+    size_t declare(const std::string& name, ASTValueType type, bool initialized = true);
+    ASTBinding lookup(const std::string& name) const;
+};
+
+#endif // RESOLVER_H
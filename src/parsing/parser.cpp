@@ -1,5 +1,6 @@
 #include "../errors/include/errors.hpp"
 #include "include/parser.hpp"
+#include "include/lexer.hpp"
 
 Parser::Parser(const std::vector<Token>& tokens) : tokens(tokens) {};
 
@@ -276,7 +277,7 @@ std::unique_ptr<ASTBase> Parser::parseExpression(int priority) {
 			case TokenType::GREATER_OR_EQUAL:
 			case TokenType::LESS_OR_EQUAL:
 				left = std::make_unique<ASTComparisonOperation>(
-					std::move(left), op.value, std::move(right), op.line
+					std::move(left), parseComparisonOperator(op.type), std::move(right), op.line
 				);
 				break;
 			case TokenType::OR:
@@ -298,7 +299,7 @@ std::unique_ptr<ASTBase> Parser::parseExpression(int priority) {
 					);
 				}
 				left = std::make_unique<ASTBinaryOperation>(
-					std::move(left), op.value, std::move(right), op.line
+					std::move(left), parseBinaryOperator(op.type), std::move(right), op.line
 				);
 				break;
 			}
@@ -359,7 +360,7 @@ std::unique_ptr<ASTBase> Parser::parsePrimaryExpression() {
 			if (currentToken().type == TokenType::STRING && current.value == "f") {
 				const std::string fStringValue = currentToken().value;
 				moveForward();
-				return std::make_unique<ASTFString>(fStringValue, currentLine);
+				return parseFString(fStringValue, currentLine);
 			}
 			if (currentToken().type == TokenType::LBRACKET) {
 				return parseFunctionCall(false);
@@ -448,6 +449,75 @@ int Parser::getPriority(TokenType type) const {
 	}
 }
 
+std::unique_ptr<ASTBase> Parser::parseFString(const std::string& value, size_t line) const {
+	// The literal is split once here, so evaluation only has to join the parts.
+	auto fString = std::make_unique<ASTFString>(value, line);
+	size_t start = 0;
+
+	while (start < value.size()) {
+		const size_t braceOpen = value.find('{', start);
+		if (braceOpen == std::string::npos) {
+			// There is no further brackets.
+			fString->addLiteral(value.substr(start));
+			break;
+		}
+		fString->addLiteral(value.substr(start, braceOpen - start));
+
+		const size_t braceClose = value.find('}', braceOpen);
+		if (braceClose == std::string::npos) {
+			throw ZynkError(
+				ZynkErrorType::SyntaxError,
+				"Unclosed '{' in f-string.",
+				line
+			);
+		}
+		Lexer lexer(value.substr(braceOpen + 1, braceClose - braceOpen - 1));
+		Parser parser(lexer.tokenize());
+		std::unique_ptr<ASTBase> expression = parser.parseExpression(0);
+
+		// We set the line number manually here, because the parser doesn't know where
+		// this expression came from. Without this, line in error message would be wrong.
+		expression->line = line;
+		fString->parts.push_back(std::move(expression));
+		start = braceClose + 1;
+	}
+	return fString;
+}
+
+ASTBinaryOperator Parser::parseBinaryOperator(TokenType type) const {
+	switch (type) {
+		case TokenType::ADD:
+			return ASTBinaryOperator::Add;
+		case TokenType::SUBTRACT:
+			return ASTBinaryOperator::Subtract;
+		case TokenType::MULTIPLY:
+			return ASTBinaryOperator::Multiply;
+		case TokenType::DIVIDE:
+			return ASTBinaryOperator::Divide;
+		default:
+			throw ZynkError(ZynkErrorType::SyntaxError, "Invalid binary operator.", currentToken().line);
+	}
+}
+
+ASTComparisonOperator Parser::parseComparisonOperator(TokenType type) const {
+	switch (type) {
+		case TokenType::EQUAL:
+			return ASTComparisonOperator::Equal;
+		case TokenType::NOT_EQUAL:
+			return ASTComparisonOperator::NotEqual;
+		case TokenType::GREATER_THAN:
+			return ASTComparisonOperator::Greater;
+		case TokenType::GREATER_OR_EQUAL:
+			return ASTComparisonOperator::GreaterOrEqual;
+		case TokenType::LESS_THAN:
+			return ASTComparisonOperator::Less;
+		case TokenType::LESS_OR_EQUAL:
+			return ASTComparisonOperator::LessOrEqual;
+		default:
+			throw ZynkError(ZynkErrorType::SyntaxError, "Invalid comparison operator.", currentToken().line);
+	}
+}
+
 ASTValueType Parser::parseValueType() const {
 	const Token current = currentToken();
 	switch (current.type) {
@@ -0,0 +1,216 @@
+#include "include/printer.hpp"
+
+#include <charconv>
+#include <cmath>
+#include <string_view>
+
+static std::string typeName(ASTValueType type) {
+    switch (type) {
+        case ASTValueType::String: return "string";
+        case ASTValueType::Integer: return "int";
+        case ASTValueType::Float: return "float";
+        case ASTValueType::Bool: return "bool";
+        default: return "null";
+    }
+}
+
+// The lexer reads neither exponents nor numbers without a decimal point as floats, so folded
+// floats are written out with the digits of their shortest form. Infinities and NaN have no
+// literal and are printed as they are.
+static std::string floatLiteral(double value) {
+    if (!std::isfinite(value)) return Value::fromFloat(value).toString();
+
+    char buffer[32];
+    const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::scientific);
+    const std::string_view text(buffer, result.ptr - buffer);
+    const size_t exponentStart = text.find('e');
+
+    std::string literal = value < 0 ? "-" : "";
+    std::string digits;
+    for (char character : text.substr(0, exponentStart)) {
+        if (character >= '0' && character <= '9') digits += character;
+    }
+    // Digits before the decimal point.
+    const int point = 1 + std::stoi(std::string(text.substr(exponentStart + 1)));
+
+    if (point <= 0) {
+        literal += "0." + std::string(-point, '0') + digits;
+    } else if (static_cast<size_t>(point) >= digits.size()) {
+        literal += digits + std::string(point - digits.size(), '0') + ".0";
+    } else {
+        literal += digits.substr(0, point) + "." + digits.substr(point);
+    }
+    return literal;
+}
+
+static bool isOperation(const ASTBase* expression) {
+    switch (expression->type) {
+        case ASTType::BinaryOperation:
+        case ASTType::ComparisonOperation:
+        case ASTType::AndOperation:
+        case ASTType::OrOperation:
+            return true;
+        default:
+            return false;
+    }
+}
+
+std::string ASTPrinter::print(const ASTProgram& program) {
+    out.str("");
+    indent = 0;
+    printBody(program.body);
+    return out.str();
+}
+
+void ASTPrinter::printBody(const std::vector<std::unique_ptr<ASTBase>>& body) {
+    for (const std::unique_ptr<ASTBase>& child : body) {
+        if (child != nullptr) printStatement(*child);
+    }
+}
+
+void ASTPrinter::printStatement(const ASTBase& statement) {
+    switch (statement.type) {
+        case ASTType::FunctionDeclaration: {
+            const auto& function = static_cast<const ASTFunction&>(statement);
+            std::string arguments;
+            for (const std::unique_ptr<ASTBase>& argument : function.arguments) {
+                const auto functionArgument = static_cast<const ASTFunctionArgument*>(argument.get());
+                if (!arguments.empty()) arguments += ", ";
+                arguments += functionArgument->name + ": " + typeName(functionArgument->valueType);
+            }
+            line("def " + function.name + "(" + arguments + ") -> " + typeName(function.returnType) + " {");
+            indent++;
+            printBody(function.body);
+            indent--;
+            line("}");
+            break;
+        }
+        case ASTType::VariableDeclaration: {
+            const auto& declaration = static_cast<const ASTVariableDeclaration&>(statement);
+            const std::string head = "var " + declaration.name + ": " + typeName(declaration.varType);
+            if (declaration.value == nullptr) line(head + ";");
+            else line(head + " = " + expression(declaration.value.get()) + ";");
+            break;
+        }
+        case ASTType::VariableModify: {
+            const auto& variableModify = static_cast<const ASTVariableModify&>(statement);
+            line(variableModify.name + " = " + expression(variableModify.value.get()) + ";");
+            break;
+        }
+        case ASTType::Print: {
+            const auto& print = static_cast<const ASTPrint&>(statement);
+            line(std::string(print.newLine ? "println(" : "print(") + expression(print.expression.get()) + ");");
+            break;
+        }
+        case ASTType::Condition: {
+            const auto& condition = static_cast<const ASTCondition&>(statement);
+            line("if (" + expression(condition.expression.get()) + ") {");
+            indent++;
+            printBody(condition.body);
+            indent--;
+            if (condition.elseBody.empty()) {
+                line("}");
+                break;
+            }
+            line("} else {");
+            indent++;
+            printBody(condition.elseBody);
+            indent--;
+            line("}");
+            break;
+        }
+        case ASTType::While: {
+            const auto& loop = static_cast<const ASTWhile&>(statement);
+            line("while (" + expression(loop.value.get()) + ") {");
+            indent++;
+            printBody(loop.body);
+            indent--;
+            line("}");
+            break;
+        }
+        case ASTType::Return: {
+            const auto& returnStatement = static_cast<const ASTReturn&>(statement);
+            if (returnStatement.value == nullptr) line("return;");
+            else line("return " + expression(returnStatement.value.get()) + ";");
+            break;
+        }
+        case ASTType::Break:
+            line("break;");
+            break;
+        default:
+            line(expression(&statement) + ";");
+            break;
+    }
+}
+
+std::string ASTPrinter::expression(const ASTBase* expression) const {
+    if (expression == nullptr) return "null";
+
+    switch (expression->type) {
+        case ASTType::Value: {
+            const Value& constant = static_cast<const ASTValue*>(expression)->constant;
+            if (constant.type() == ASTValueType::String) return "\"" + constant.asString() + "\"";
+            if (constant.type() == ASTValueType::Float) return floatLiteral(constant.asFloat());
+            return constant.toString();
+        }
+        case ASTType::Variable:
+            return static_cast<const ASTVariable*>(expression)->name;
+        case ASTType::ReadInput: {
+            const auto read = static_cast<const ASTReadInput*>(expression);
+            return "readInput(" + (read->out != nullptr ? this->expression(read->out.get()) : "") + ")";
+        }
+        case ASTType::TypeCast: {
+            const auto typeCast = static_cast<const ASTTypeCast*>(expression);
+            return typeName(typeCast->castType) + "(" + this->expression(typeCast->value.get()) + ")";
+        }
+        case ASTType::FString: {
+            std::string text = "f\"";
+            for (const std::unique_ptr<ASTBase>& part : static_cast<const ASTFString*>(expression)->parts) {
+                if (part->type == ASTType::Value && static_cast<const ASTValue*>(part.get())->constant.type() == ASTValueType::String) {
+                    text += static_cast<const ASTValue*>(part.get())->constant.asString();
+                } else {
+                    text += "{" + this->expression(part.get()) + "}";
+                }
+            }
+            return text + "\"";
+        }
+        case ASTType::BinaryOperation: {
+            const auto operation = static_cast<const ASTBinaryOperation*>(expression);
+            return operand(operation->left.get()) + " " + operatorToString(operation->op) + " " + operand(operation->right.get());
+        }
+        case ASTType::ComparisonOperation: {
+            const auto operation = static_cast<const ASTComparisonOperation*>(expression);
+            return operand(operation->left.get()) + " " + operatorToString(operation->op) + " " + operand(operation->right.get());
+        }
+        case ASTType::AndOperation: {
+            const auto operation = static_cast<const ASTAndOperation*>(expression);
+            return operand(operation->left.get()) + " and " + operand(operation->right.get());
+        }
+        case ASTType::OrOperation: {
+            const auto operation = static_cast<const ASTOrOperation*>(expression);
+            return operand(operation->left.get()) + " or " + operand(operation->right.get());
+        }
+        case ASTType::FunctionCall: {
+            const auto functionCall = static_cast<const ASTFunctionCall*>(expression);
+            std::string arguments;
+            for (const std::unique_ptr<ASTBase>& argument : functionCall->arguments) {
+                if (!arguments.empty()) arguments += ", ";
+                arguments += this->expression(argument.get());
+            }
+            return functionCall->name + "(" + arguments + ")";
+        }
+        case ASTType::Return:
+            return this->expression(static_cast<const ASTReturn*>(expression)->value.get());
+        default:
+            return "?";
+    }
+}
+
+std::string ASTPrinter::operand(const ASTBase* expression) const {
+    if (expression != nullptr && isOperation(expression)) return "(" + this->expression(expression) + ")";
+    return this->expression(expression);
+}
+
+void ASTPrinter::line(const std::string& text) {
+    out << std::string(indent * 4, ' ') << text << "\n";
+}
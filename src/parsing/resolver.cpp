@@ -0,0 +1,195 @@
+#include "include/resolver.hpp"
+
+#include <algorithm>
+
+void Resolver::resolve(ASTProgram& program) {
+    functions.clear();
+    functions.emplace_back();
+    functionCount = 0;
+
+    beginScope(); // Main program code block.
+    for (const std::unique_ptr<ASTBase>& child : program.body) {
+        if (child != nullptr) resolveStatement(*child);
+    }
+    endScope();
+
+    program.frameSize = functions.back().frameSize;
+    program.functionCount = functionCount;
+    functions.pop_back();
+}
+
+void Resolver::resolveBody(std::vector<std::unique_ptr<ASTBase>>& body) {
+    beginScope();
+    for (const std::unique_ptr<ASTBase>& child : body) {
+        if (child != nullptr) resolveStatement(*child);
+    }
+    endScope();
+}
+
+void Resolver::resolveStatement(ASTBase& statement) {
+    switch (statement.type) {
+        case ASTType::FunctionDeclaration: {
+            auto& function = static_cast<ASTFunction&>(statement);
+            function.id = functionCount++;
+            functions.back().scopes.back().functions.push_back(&function);
+            break;
+        }
+        case ASTType::VariableDeclaration: {
+            auto& declaration = static_cast<ASTVariableDeclaration&>(statement);
+            // The value is evaluated before the variable exists, so it can't refer to it.
+            resolveExpression(declaration.value.get());
+            declaration.slot = declare(declaration.name, declaration.varType, declaration.value != nullptr);
+            break;
+        }
+        case ASTType::VariableModify: {
+            auto& variableModify = static_cast<ASTVariableModify&>(statement);
+            resolveExpression(variableModify.value.get());
+            variableModify.binding = lookup(variableModify.name);
+            break;
+        }
+        case ASTType::Print:
+            resolveExpression(static_cast<ASTPrint&>(statement).expression.get());
+            break;
+        case ASTType::Condition: {
+            auto& condition = static_cast<ASTCondition&>(statement);
+            resolveExpression(condition.expression.get());
+            resolveBody(condition.body);
+            resolveBody(condition.elseBody);
+            break;
+        }
+        case ASTType::While: {
+            // Like at runtime, the whole loop shares a single block.
+            auto& loop = static_cast<ASTWhile&>(statement);
+            beginScope();
+            resolveExpression(loop.value.get());
+            for (const std::unique_ptr<ASTBase>& child : loop.body) {
+                if (child != nullptr) resolveStatement(*child);
+            }
+            endScope();
+            break;
+        }
+        case ASTType::Break:
+            break;
+        default:
+            resolveExpression(&statement);
+            break;
+    }
+}
+
+void Resolver::resolveExpression(ASTBase* expression) {
+    if (expression == nullptr) return;
+
+    switch (expression->type) {
+        case ASTType::Variable: {
+            auto variable = static_cast<ASTVariable*>(expression);
+            variable->binding = lookup(variable->name);
+            break;
+        }
+        case ASTType::ReadInput:
+            resolveExpression(static_cast<ASTReadInput*>(expression)->out.get());
+            break;
+        case ASTType::TypeCast:
+            resolveExpression(static_cast<ASTTypeCast*>(expression)->value.get());
+            break;
+        case ASTType::FString:
+            for (const std::unique_ptr<ASTBase>& part : static_cast<ASTFString*>(expression)->parts) {
+                resolveExpression(part.get());
+            }
+            break;
+        case ASTType::BinaryOperation: {
+            auto operation = static_cast<ASTBinaryOperation*>(expression);
+            resolveExpression(operation->left.get());
+            resolveExpression(operation->right.get());
+            break;
+        }
+        case ASTType::ComparisonOperation: {
+            auto operation = static_cast<ASTComparisonOperation*>(expression);
+            resolveExpression(operation->left.get());
+            resolveExpression(operation->right.get());
+            break;
+        }
+        case ASTType::AndOperation: {
+            auto operation = static_cast<ASTAndOperation*>(expression);
+            resolveExpression(operation->left.get());
+            resolveExpression(operation->right.get());
+            break;
+        }
+        case ASTType::OrOperation: {
+            auto operation = static_cast<ASTOrOperation*>(expression);
+            resolveExpression(operation->left.get());
+            resolveExpression(operation->right.get());
+            break;
+        }
+        case ASTType::FunctionCall:
+            for (const std::unique_ptr<ASTBase>& argument : static_cast<ASTFunctionCall*>(expression)->arguments) {
+                resolveExpression(argument.get());
+            }
+            break;
+        case ASTType::Return:
+            resolveExpression(static_cast<ASTReturn*>(expression)->value.get());
+            break;
+        default:
+            break;
+    }
+}
+
+void Resolver::resolveFunction(ASTFunction& function) {
+    functions.emplace_back();
+
+    // Arguments and the body share the block of the call.
+    beginScope();
+    for (const std::unique_ptr<ASTBase>& argument : function.arguments) {
+        auto functionArgument = static_cast<ASTFunctionArgument*>(argument.get());
+        functionArgument->slot = declare(functionArgument->name, functionArgument->valueType);
+    }
+    for (const std::unique_ptr<ASTBase>& child : function.body) {
+        if (child != nullptr) resolveStatement(*child);
+    }
+    endScope();
+
+    function.frameSize = functions.back().frameSize;
+    functions.pop_back();
+}
+
+void Resolver::beginScope() {
+    functions.back().scopes.emplace_back();
+}
+
+void Resolver::endScope() {
+    // Resolving a function pushes a new function scope, so nothing can be held across it.
+    const std::vector<ASTFunction*> declared = std::move(functions.back().scopes.back().functions);
+    for (ASTFunction* function : declared) {
+        resolveFunction(*function);
+    }
+
+    FunctionScope& function = functions.back();
+    // Slots of a closed scope are reused by the scopes that follow it.
+    function.nextSlot -= function.scopes.back().variables.size();
+    function.scopes.pop_back();
+}
+
+size_t Resolver::declare(const std::string& name, ASTValueType type, bool initialized) {
+    FunctionScope& function = functions.back();
+    std::unordered_map<std::string, Declaration>& variables = function.scopes.back().variables;
+
+    // A duplicate declaration gets the same slot, the runtime reports it once it is executed.
+    auto found = variables.find(name);
+    if (found != variables.end()) return found->second.slot;
+
+    const size_t slot = function.nextSlot++;
+    function.frameSize = std::max(function.frameSize, function.nextSlot);
+    variables.emplace(name, Declaration{ slot, type, initialized });
+    return slot;
+}
+
+ASTBinding Resolver::lookup(const std::string& name) const {
+    size_t depth = 0;
+    for (auto function = functions.rbegin(); function != functions.rend(); ++function, ++depth) {
+        for (auto scope = function->scopes.rbegin(); scope != function->scopes.rend(); ++scope) {
+            auto found = scope->variables.find(name);
+            if (found != scope->variables.end()) return { depth, found->second.slot, found->second.type, found->second.initialized };
+        }
+    }
+    // Unknown names stay unresolved, using them raises an error at runtime.
+    return {};
+}
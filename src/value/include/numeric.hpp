@@ -0,0 +1,20 @@
+#ifndef NUMERIC_H
+#define NUMERIC_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Conversions between numbers and their text, shared by literals, casts and output.
+// They never throw and don't depend on the locale.
+
+// The whole text, apart from surrounding whitespace, has to be the number.
+bool parseInteger(std::string_view text, int64_t& out);
+bool parseFloat(std::string_view text, double& out);
+
+void appendInteger(std::string& out, int64_t value);
+// Appends the shortest text that reads back as the same double. Whole numbers keep
+// a trailing ".0", so they can still be told apart from integers.
+void appendFloat(std::string& out, double value);
+
+#endif // NUMERIC_H
@@ -0,0 +1,71 @@
+#ifndef VALUE_H
+#define VALUE_H
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+enum class ASTValueType {
+    String,
+    Integer,
+    Float,
+    Bool,
+    None,
+};
+
+// Runtime value. Numbers and booleans are stored inline, strings are immutable
+// and shared between copies through a reference count.
+class Value {
+public:
+    Value() : kind(ASTValueType::None) { data.integer = 0; }
+    Value(const Value& other);
+    Value(Value&& other) noexcept;
+    Value& operator=(const Value& other);
+    Value& operator=(Value&& other) noexcept;
+    ~Value() { release(); }
+
+    static Value fromInt(int64_t value);
+    static Value fromFloat(double value);
+    static Value fromBool(bool value);
+    static Value fromString(std::string value);
+    // Decodes the literal text produced by the lexer. Never throws.
+    static Value fromLiteral(const std::string& text, ASTValueType type);
+
+    inline ASTValueType type() const { return kind; }
+    inline bool isNumber() const { return kind == ASTValueType::Integer || kind == ASTValueType::Float; }
+
+    inline int64_t asInt() const { return data.integer; }
+    inline double asFloat() const { return data.floating; }
+    inline bool asBool() const { return data.boolean; }
+    inline const std::string& asString() const { return data.string->value; }
+
+    double toNumber() const;
+    bool isTruthy() const;
+    std::string toString() const;
+    void appendTo(std::string& out) const;
+private:
+    struct StringObject {
+        size_t references;
+        const std::string value;
+    };
+
+    ASTValueType kind;
+    union {
+        int64_t integer;
+        double floating;
+        bool boolean;
+        StringObject* string;
+    } data;
+
+    inline void release();
+};
+
+std::ostream& operator<<(std::ostream& stream, const Value& value);
+
+inline void Value::release() {
+    if (kind == ASTValueType::String && --data.string->references == 0) {
+        delete data.string;
+    }
+}
+
+#endif // VALUE_H
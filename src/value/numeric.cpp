@@ -0,0 +1,50 @@
+#include "include/numeric.hpp"
+
+#include <algorithm>
+#include <charconv>
+
+static std::string_view trim(std::string_view text) {
+    const char* whitespace = " \t\n\r\f\v";
+    const size_t begin = text.find_first_not_of(whitespace);
+    if (begin == std::string_view::npos) return {};
+    const size_t end = text.find_last_not_of(whitespace);
+    return text.substr(begin, end - begin + 1);
+}
+
+template <typename T>
+static bool parseNumber(std::string_view text, T& out) {
+    text = trim(text);
+    // from_chars doesn't accept an explicit plus sign.
+    if (text.size() > 1 && text.front() == '+' && text[1] != '-') text.remove_prefix(1);
+
+    const char* end = text.data() + text.size();
+    const auto [position, error] = std::from_chars(text.data(), end, out);
+    return error == std::errc() && position == end && !text.empty();
+}
+
+bool parseInteger(std::string_view text, int64_t& out) {
+    return parseNumber(text, out);
+}
+
+bool parseFloat(std::string_view text, double& out) {
+    return parseNumber(text, out);
+}
+
+void appendInteger(std::string& out, int64_t value) {
+    char buffer[24]; // Fits INT64_MIN.
+    const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr);
+}
+
+void appendFloat(std::string& out, double value) {
+    char buffer[32]; // Fits the longest shortest representation of a double.
+    const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr);
+
+    // Nothing but digits and a sign, so it would read back as an integer.
+    // The buffer isn't terminated, so only the written characters are looked at.
+    const bool integral = std::all_of(buffer, result.ptr, [](char character) {
+        return character == '-' || (character >= '0' && character <= '9');
+    });
+    if (integral) out += ".0";
+}
@@ -0,0 +1,139 @@
+#include "include/value.hpp"
+#include "include/numeric.hpp"
+
+Value::Value(const Value& other) : kind(other.kind), data(other.data) {
+    if (kind == ASTValueType::String) data.string->references++;
+}
+
+Value::Value(Value&& other) noexcept : kind(other.kind), data(other.data) {
+    other.kind = ASTValueType::None;
+}
+
+Value& Value::operator=(const Value& other) {
+    if (this == &other) return *this;
+    if (other.kind == ASTValueType::String) other.data.string->references++;
+    release();
+    kind = other.kind;
+    data = other.data;
+    return *this;
+}
+
+Value& Value::operator=(Value&& other) noexcept {
+    if (this == &other) return *this;
+    release();
+    kind = other.kind;
+    data = other.data;
+    other.kind = ASTValueType::None;
+    return *this;
+}
+
+Value Value::fromInt(int64_t value) {
+    Value result;
+    result.kind = ASTValueType::Integer;
+    result.data.integer = value;
+    return result;
+}
+
+Value Value::fromFloat(double value) {
+    Value result;
+    result.kind = ASTValueType::Float;
+    result.data.floating = value;
+    return result;
+}
+
+Value Value::fromBool(bool value) {
+    Value result;
+    result.kind = ASTValueType::Bool;
+    result.data.boolean = value;
+    return result;
+}
+
+Value Value::fromString(std::string value) {
+    Value result;
+    result.kind = ASTValueType::String;
+    result.data.string = new StringObject{ 1, std::move(value) };
+    return result;
+}
+
+Value Value::fromLiteral(const std::string& text, ASTValueType type) {
+    switch (type) {
+        case ASTValueType::Integer: {
+            // Literals are validated by the lexer.
+            int64_t value = 0;
+            parseInteger(text, value);
+            return fromInt(value);
+        }
+        case ASTValueType::Float: {
+            double value = 0;
+            parseFloat(text, value);
+            return fromFloat(value);
+        }
+        case ASTValueType::Bool:
+            return fromBool(text == "true");
+        case ASTValueType::String:
+            return fromString(text);
+        default:
+            return Value();
+    }
+}
+
+double Value::toNumber() const {
+    switch (kind) {
+        case ASTValueType::Integer:
+            return static_cast<double>(data.integer);
+        case ASTValueType::Float:
+            return data.floating;
+        case ASTValueType::Bool:
+            return data.boolean ? 1 : 0;
+        default:
+            return 0;
+    }
+}
+
+bool Value::isTruthy() const {
+    switch (kind) {
+        case ASTValueType::Integer:
+            return data.integer != 0;
+        case ASTValueType::Float:
+            return data.floating != 0;
+        case ASTValueType::Bool:
+            return data.boolean;
+        case ASTValueType::String: {
+            const std::string& value = data.string->value;
+            return !value.empty() && value != "0" && value != "null" && value != "false";
+        }
+        default:
+            return false;
+    }
+}
+
+std::string Value::toString() const {
+    std::string result;
+    appendTo(result);
+    return result;
+}
+
+void Value::appendTo(std::string& out) const {
+    switch (kind) {
+        case ASTValueType::Integer:
+            appendInteger(out, data.integer);
+            break;
+        case ASTValueType::Float:
+            appendFloat(out, data.floating);
+            break;
+        case ASTValueType::Bool:
+            out += data.boolean ? "true" : "false";
+            break;
+        case ASTValueType::String:
+            out += data.string->value;
+            break;
+        default:
+            out += "null";
+            break;
+    }
+}
+
+std::ostream& operator<<(std::ostream& stream, const Value& value) {
+    if (value.type() == ASTValueType::String) return stream << value.asString();
+    return stream << value.toString();
+}
@@ -0,0 +1,19 @@
+#ifndef TEST_HELPERS_H
+#define TEST_HELPERS_H
+
+#include "../src/parsing/include/parser.hpp"
+#include "../src/parsing/include/lexer.hpp"
+#include "../src/parsing/include/resolver.hpp"
+#include "../src/execution/typechecker/include/checker.hpp"
+
+// Lexes, parses, resolves and type checks the code, as the interpreter does before running it.
+inline std::unique_ptr<ASTProgram> parseSource(const std::string& code) {
+    Lexer lexer(code);
+    Parser parser(lexer.tokenize());
+    auto program = parser.parse();
+    Resolver().resolve(*program);
+    TypeChecker().check(*program);
+    return program;
+}
+
+#endif // TEST_HELPERS_H
@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+
+#include "../src/execution/aot/include/generator.hpp"
+#include "../src/execution/include/evaluator.hpp"
+#include "../src/execution/include/interpreter.hpp"
+#include "../src/errors/include/errors.hpp"
+#include "helpers.hpp"
+
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+static std::string generate(const std::string& code) {
+    auto program = parseSource(code);
+    return CppGenerator().generate(*program, "main.zk");
+}
+
+static std::string writeScript(const std::string& name, const std::string& code) {
+    const std::string path = testing::TempDir() + name;
+    std::ofstream(path) << code;
+    return path;
+}
+
+static std::string readText(const std::string& path) {
+    std::ifstream file(path);
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return buffer.str();
+}
+
+static std::string interpret(const std::string& code) {
+    auto program = parseSource(code);
+    testing::internal::CaptureStdout();
+    try {
+        Evaluator().evaluate(*program);
+    } catch (...) {
+        testing::internal::GetCapturedStdout();
+        throw;
+    }
+    return testing::internal::GetCapturedStdout();
+}
+
+TEST(CppGeneratorTest, GeneratesFunctionPerDeclaration) {
+    const std::string source = generate(R"(
+        def square(x: int) -> int {
+            return x * x;
+        }
+        println(square(4));
+    )");
+
+    EXPECT_NE(source.find("static Value function_0(NativeRuntime& rt, size_t scope, Value* arguments) {"), std::string::npos);
+    EXPECT_NE(source.find("rt.env.declareFunction(&rt.function(0));"), std::string::npos);
+    EXPECT_NE(source.find("{ \"square\", ASTValueType::Integer, "), std::string::npos);
+    EXPECT_NE(source.find("NativeRuntime::main(program"), std::string::npos);
+}
+
+TEST(CppGeneratorTest, EscapesStringConstants) {
+    const std::string source = generate("println(\"w\xC3\xB6rld\\\\\");");
+
+    EXPECT_NE(source.find("std::string(\"w\\303\\266rld\\\\\\\\\", 8)"), std::string::npos);
+}
+
+TEST(CppGeneratorTest, EscapesQuestionMarks) {
+    // Split so that this file has no trigraph either.
+    const std::string source = generate("println(\"what?" "?/\");");
+
+    EXPECT_NE(source.find("std::string(\"what\\?\\?/\", 7)"), std::string::npos);
+}
+
+TEST(CppGeneratorTest, ClosesBlocksBeforeReturning) {
+    const std::string source = generate(R"(
+        def find() -> int {
+            while (true) {
+                if (true) {
+                    return 1;
+                }
+            }
+        }
+    )");
+
+    EXPECT_NE(
+        source.find("rt.env.exitCurrentBlock();\n"
+                    "            rt.env.exitCurrentBlock();\n"
+                    "            rt.env.exitFrame();\n"
+                    "            return constants[1];"),
+        std::string::npos
+    );
+}
+
+#ifndef _WIN32
+TEST(NativeBuildTest, BuiltProgramMatchesInterpreter) {
+    const std::string code = R"(
+        def fib(n: int) -> int {
+            if (n < 2) {
+                return n;
+            }
+            return fib(n - 1) + fib(n - 2);
+        }
+        var i: int = 0;
+        var total: float = 0.5;
+        while (i < 10) {
+            if (i == 7) {
+                break;
+            }
+            total = total + float(i) * 1.5;
+            i = i + 1;
+        }
+        println(f"{total} {fib(15)} {i > 3 or false}");
+        println(10 / (i - 7));
+    )";
+    const std::string script = writeScript("native.zk", code);
+    const std::string executable = testing::TempDir() + "native";
+    const std::string output = testing::TempDir() + "native.txt";
+
+    ZynkInterpreter().buildFile(script, executable);
+    const int status = std::system((executable + " > " + output + " 2>&1").c_str());
+
+    EXPECT_NE(status, 0);
+    const std::string result = readText(output);
+    // The program prints the same, and fails with the error of the interpreter.
+    try {
+        interpret(code);
+        FAIL() << "Expected ZynkError thrown.";
+    } catch (const ZynkError& error) {
+        EXPECT_EQ(result.rfind("32.0 610 true\n", 0), 0u);
+        EXPECT_NE(result.find(error.what()), std::string::npos);
+        EXPECT_NE(result.find("Line: \033[0m" + std::to_string(*error.line)), std::string::npos);
+    }
+}
+
+TEST(NativeBuildTest, RejectsOperationsOnUninitializedVariables) {
+    const std::string script = writeScript("uninitialized.zk", "var x: int;\nprintln(x + 1);\n");
+    const std::string executable = testing::TempDir() + "uninitialized";
+    const std::string output = testing::TempDir() + "uninitialized.txt";
+
+    ZynkInterpreter().buildFile(script, executable);
+    const int status = std::system((executable + " > " + output + " 2>&1").c_str());
+
+    EXPECT_NE(status, 0);
+    const std::string result = readText(output);
+    EXPECT_NE(result.find("Cannot perform BinaryOperation on 'null' type."), std::string::npos);
+    EXPECT_NE(result.find("Line: \033[0m2"), std::string::npos);
+}
+
+TEST(NativeBuildTest, ReportsFailedCompilerCommand) {
+    const std::string script = writeScript("command.zk", "println(1);");
+    const std::string executable = testing::TempDir() + "command";
+
+    setenv("ZYNK_CXX", "false", 1);
+    try {
+        ZynkInterpreter().buildFile(script, executable);
+        FAIL() << "Expected ZynkError thrown.";
+    } catch (const ZynkError& error) {
+        EXPECT_EQ(error.base_type, ZynkErrorType::BuildError);
+        EXPECT_NE(std::string(error.what()).find("'false' -O2 -std=c++17"), std::string::npos);
+    }
+    unsetenv("ZYNK_CXX");
+}
+#endif
+
+TEST(NativeBuildTest, ReportsTypeErrorsWithoutBuilding) {
+    const std::string script = writeScript("invalid.zk", "var x: int = \"text\";");
+    const std::string executable = testing::TempDir() + "invalid";
+
+    try {
+        ZynkInterpreter().buildFile(script, executable);
+        FAIL() << "Expected ZynkError thrown.";
+    } catch (const ZynkError& error) {
+        EXPECT_EQ(error.base_type, ZynkErrorType::TypeError);
+    }
+    EXPECT_FALSE(std::ifstream(executable).good());
+}
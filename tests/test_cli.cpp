@@ -71,6 +71,81 @@ TEST(CLICheckoutTest, ShouldThrowTooManyArguments) {
     EXPECT_THROW(cli.checkout(), ZynkError);
 }
 
+TEST(CLIArgsTest, EngineArgument) {
+    CLI cli({ "main.zk", "--engine=vm" });
+    EXPECT_EQ(cli.args.engine, "vm");
+    EXPECT_EQ(cli.args.count, 1);
+    EXPECT_NO_THROW(cli.checkout());
+}
+
+TEST(CLIArgsTest, ClosureEngineArgument) {
+    CLI cli({ "main.zk", "--engine=closure" });
+    EXPECT_EQ(cli.args.engine, "closure");
+    EXPECT_NO_THROW(cli.checkout());
+}
+
+TEST(CLIArgsTest, DumpOptimizedArgument) {
+    CLI cli({ "main.zk", "--dump-optimized" });
+    EXPECT_TRUE(cli.args.dumpOptimized);
+    EXPECT_EQ(cli.args.count, 1);
+    EXPECT_NO_THROW(cli.checkout());
+}
+
+TEST(CLIArgsTest, DiagnosticsArgument) {
+    CLI cli({ "main.zk", "--diagnostics" });
+    EXPECT_TRUE(cli.args.diagnostics);
+    EXPECT_EQ(cli.args.count, 1);
+    EXPECT_NO_THROW(cli.checkout());
+}
+
+TEST(CLIArgsTest, InlineBudgetArgument) {
+    CLI cli({ "main.zk", "--inline-budget=32" });
+    EXPECT_EQ(cli.args.inlineBudget, "32");
+    EXPECT_EQ(cli.args.count, 1);
+    EXPECT_NO_THROW(cli.checkout());
+}
+
+TEST(CLIArgsTest, DefaultEngine) {
+    CLI cli({ "main.zk" });
+    EXPECT_EQ(cli.args.engine, "tree");
+}
+
+TEST(CLIArgsTest, JitArgument) {
+    CLI cli({ "main.zk", "--engine=vm", "--jit" });
+    EXPECT_TRUE(cli.args.jit);
+    EXPECT_EQ(cli.args.count, 1);
+    EXPECT_NO_THROW(cli.checkout());
+}
+
+TEST(CLIArgsTest, BuildArgument) {
+    CLI cli({ "build", "main.zk", "-o", "app" });
+    EXPECT_TRUE(cli.args.build);
+    EXPECT_EQ(cli.args.file_path, "main.zk");
+    EXPECT_EQ(cli.args.output, "app");
+    EXPECT_EQ(cli.args.count, 1);
+    EXPECT_NO_THROW(cli.checkout());
+}
+
+TEST(CLIArgsTest, BuildOutputDefaultsToScriptName) {
+    CLI cli({ "build", "scripts/main.zk" });
+    EXPECT_EQ(cli.args.output, "scripts/main");
+}
+
+TEST(CLICheckoutTest, ShouldThrowBuildWithoutScript) {
+    CLI cli({ "build" });
+    EXPECT_THROW(cli.checkout(), ZynkError);
+}
+
+TEST(CLICheckoutTest, ShouldThrowUnknownEngine) {
+    CLI cli({ "main.zk", "--engine=jit" });
+    EXPECT_THROW(cli.checkout(), ZynkError);
+}
+
+TEST(CLICheckoutTest, ShouldThrowInvalidInlineBudget) {
+    CLI cli({ "main.zk", "--inline-budget=many" });
+    EXPECT_THROW(cli.checkout(), ZynkError);
+}
+
 TEST(CLIArguments, ShouldBeEmpty) {
     Arguments args(0);
     EXPECT_TRUE(args.empty());
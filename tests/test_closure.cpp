@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+
+#include "../src/execution/closure/include/closure.hpp"
+#include "../src/execution/optimizer/include/optimizer.hpp"
+#include "../src/errors/include/errors.hpp"
+#include "helpers.hpp"
+
+TEST(ClosureEngineTest, ReturnFromNestedLoopInsideCondition) {
+    auto program = parseSource(R"(
+        def find() -> int {
+            var i: int = 0;
+            while (true) {
+                while (true) {
+                    if (i == 3) {
+                        return i;
+                    }
+                    i = i + 1;
+                }
+            }
+        }
+        println(find());
+    )");
+
+    testing::internal::CaptureStdout();
+    ClosureEngine engine;
+    engine.run(*program);
+    ASSERT_EQ(testing::internal::GetCapturedStdout(), "3\n");
+}
+
+TEST(ClosureEngineTest, BreakClosesInnerBlocks) {
+    auto program = parseSource(R"(
+        var i: int = 0;
+        while (true) {
+            if (i == 2) {
+                var inner: int = i;
+                break;
+            }
+            i = i + 1;
+        }
+        var inner: string = "outer";
+        println(inner);
+    )");
+
+    testing::internal::CaptureStdout();
+    ClosureEngine engine;
+    engine.run(*program);
+    ASSERT_EQ(testing::internal::GetCapturedStdout(), "outer\n");
+}
+
+TEST(ClosureEngineTest, ProgramCanBeRunMultipleTimes) {
+    auto program = parseSource(R"(
+        def greet(name: string) -> null {
+            println(f"Hello, {name}!");
+        }
+        greet("Zynk");
+    )");
+
+    testing::internal::CaptureStdout();
+    ClosureEngine engine;
+    engine.run(*program);
+    engine.run(*program);
+    ASSERT_EQ(testing::internal::GetCapturedStdout(), "Hello, Zynk!\nHello, Zynk!\n");
+}
+
+TEST(ClosureEngineTest, KernelErrorsReportTheirLine) {
+    auto program = parseSource(R"(
+        var big: int = 9223372036854775807;
+        var small: float = 1.5;
+        println(small * 2.0);
+        println(big + 1);
+    )");
+
+    testing::internal::CaptureStdout();
+    try {
+        ClosureEngine().run(*program);
+        FAIL() << "Expected ZynkError thrown.";
+    } catch (const ZynkError& error) {
+        EXPECT_EQ(error.base_type, ZynkErrorType::RuntimeError);
+        EXPECT_EQ(error.line, program->body[3]->line);
+    }
+    EXPECT_EQ(testing::internal::GetCapturedStdout(), "3.0\n");
+}
+
+TEST(ClosureEngineTest, CountedLoopReportsOverflowAtStep) {
+    auto program = parseSource(R"(
+        var i: int = 9223372036854775806;
+        while (i > 0) {
+            println(i);
+            i = i + 1;
+        }
+    )");
+    Optimizer optimizer;
+    optimizer.optimize(*program);
+    ASSERT_EQ(optimizer.statistics.countedLoops, 1);
+
+    testing::internal::CaptureStdout();
+    try {
+        ClosureEngine().run(*program);
+        FAIL() << "Expected ZynkError thrown.";
+    } catch (const ZynkError& error) {
+        EXPECT_EQ(error.base_type, ZynkErrorType::RuntimeError);
+        EXPECT_EQ(error.line, 4);
+    }
+    EXPECT_EQ(testing::internal::GetCapturedStdout(), "9223372036854775806\n9223372036854775807\n");
+}
@@ -4,9 +4,55 @@
 #include "../src/execution/include/runtime.hpp"
 #include "../src/parsing/include/parser.hpp"
 #include "../src/parsing/include/lexer.hpp"
+#include "../src/parsing/include/resolver.hpp"
+#include "../src/execution/typechecker/include/checker.hpp"
 #include "../src/errors/include/errors.hpp"
+#include "../src/execution/include/interpreter.hpp"
+#include "../src/execution/vm/include/compiler.hpp"
+#include "../src/execution/vm/include/vm.hpp"
+#include "../src/execution/closure/include/closure.hpp"
+
+// Every test is run against each execution engine, as they must behave the same.
+class EvaluatorTest : public testing::TestWithParam<ExecutionEngine> {
+protected:
+    void evaluate(std::unique_ptr<ASTProgram> program) {
+        Resolver().resolve(*program);
+        TypeChecker().check(*program);
+        switch (GetParam()) {
+            case ExecutionEngine::TreeWalker: {
+                Evaluator evaluator;
+                evaluator.evaluate(*program);
+                break;
+            }
+            case ExecutionEngine::VM: {
+                Compiler compiler;
+                VirtualMachine vm;
+                vm.run(*compiler.compile(*program));
+                break;
+            }
+            case ExecutionEngine::Closure: {
+                ClosureEngine closureEngine;
+                closureEngine.run(*program);
+                break;
+            }
+        }
+    }
+};
+
+INSTANTIATE_TEST_SUITE_P(
+    Engines,
+    EvaluatorTest,
+    testing::Values(ExecutionEngine::TreeWalker, ExecutionEngine::VM, ExecutionEngine::Closure),
+    [](const testing::TestParamInfo<ExecutionEngine>& info) {
+        switch (info.param) {
+            case ExecutionEngine::VM: return "VM";
+            case ExecutionEngine::Closure: return "Closure";
+            default: return "TreeWalker";
+        }
+    }
+);
 
-TEST(EvaluatorTest, EvaluatePrintStatement) {
+TEST_P(EvaluatorTest, EvaluatePrintStatement) {
     const std::string code = "println(\"Hello, World!\");";
     Lexer lexer(code);
     const std::vector<Token> tokens = lexer.tokenize();
@@ -15,12 +61,11 @@ TEST(EvaluatorTest, EvaluatePrintStatement) {
     auto program = parser.parse();
 
     testing::internal::CaptureStdout();
-    Evaluator evaluator;
-    evaluator.evaluate(std::move(program));
+    evaluate(std::move(program));
     ASSERT_EQ(testing::internal::GetCapturedStdout(), "Hello, World!\n");
 }
 
-TEST(EvaluatorTest, EvaluateVariableDeclarationAndPrint) {
+TEST_P(EvaluatorTest, EvaluateVariableDeclarationAndPrint) {
     const std::string code = "var x: int = 42; println(x);";
     Lexer lexer(code);
     const std::vector<Token> tokens = lexer.tokenize();
@@ -29,12 +74,11 @@ TEST(EvaluatorTest, EvaluateVariableDeclarationAndPrint) {
     auto program = parser.parse();
 
     testing::internal::CaptureStdout();
-    Evaluator evaluator;
-    evaluator.evaluate(std::move(program));
+    evaluate(std::move(program));
     ASSERT_EQ(testing::internal::GetCapturedStdout(), "42\n");
 }
 
-TEST(EvaluatorTest, EvaluateFunctionDeclaration) {
+TEST_P(EvaluatorTest, EvaluateFunctionDeclaration) {
     const std::string code = R"(
         def myFunction() -> null {
             println("Inside function");
@@ -47,13 +91,12 @@ TEST(EvaluatorTest, EvaluateFunctionDeclaration) {
     auto program = parser.parse();
 
     testing::internal::CaptureStdout();
-    Evaluator evaluator;
-    evaluator.evaluate(std::move(program));
+    evaluate(std::move(program));
     // We do not call the function, so nothing should show up.
     ASSERT_EQ(testing::internal::GetCapturedStdout(), "");
 }
 
-TEST(EvaluatorTest, EvaluateFunctionCall) {
+TEST_P(EvaluatorTest, EvaluateFunctionCall) {
     const std::string code = R"(
         def myFunction() -> null {
             var x: string = "Inside function.";
@@ -68,12 +111,11 @@ TEST(EvaluatorTest, EvaluateFunctionCall) {
     auto program = parser.parse();
 
     testing::internal::CaptureStdout();
-    Evaluator evaluator;
-    evaluator.evaluate(std::move(program));
+    evaluate(std::move(program));
     ASSERT_EQ(testing::internal::GetCapturedStdout(), "Inside function.\n");
 }
 
-TEST(EvaluatorTest, EvaluateNestedFunctionCalls) {
+TEST_P(EvaluatorTest, EvaluateNestedFunctionCalls) {
     const std::string code = R"(
         def outerFunction() -> null {
             def innerFunction() -> null { 
@@ -91,12 +133,11 @@ TEST(EvaluatorTest, EvaluateNestedFunctionCalls) {
     auto program = parser.parse();
 
     testing::internal::CaptureStdout();
-    Evaluator evaluator;
-    evaluator.evaluate(std::move(program));
+    evaluate(std::move(program));
     ASSERT_EQ(testing::internal::GetCapturedStdout(), "Outer function\nInside inner function\n");
 }
 
-TEST(EvaluatorTest, EvaluateBinaryOperationAddition) {
+TEST_P(EvaluatorTest, EvaluateBinaryOperationAddition) {
     const std::string code = "println(5 + 3);";
     Lexer lexer(code);
     const std::vector<Token> tokens = lexer.tokenize();
@@ -105,12 +146,11 @@ TEST(EvaluatorTest, EvaluateBinaryOperationAddition) {
     auto program = parser.parse();
 
     testing::internal::CaptureStdout();
-    Evaluator evaluator;
-    evaluator.evaluate(std::move(program));
+    evaluate(std::move(program));
     ASSERT_EQ(testing::internal::GetCapturedStdout(), "8\n");
 }
 
-TEST(EvaluatorTest, EvaluateBinaryOperationMultiply) {
+TEST_P(EvaluatorTest, EvaluateBinaryOperationMultiply) {
     const std::string code = "println(6 * 7);";
     Lexer lexer(code);
     const std::vector<Token> tokens = lexer.tokenize();
@@ -119,12 +159,11 @@ TEST(EvaluatorTest, EvaluateBinaryOperationMultiply) {
     auto program = parser.parse();
 
     testing::internal::CaptureStdout();
-    Evaluator evaluator;
-    evaluator.evaluate(std::move(program));
+    evaluate(std::move(program));
     ASSERT_EQ(testing::internal::GetCapturedStdout(), "42\n");
 }
 
-TEST(EvaluatorTest, EvaluateBinaryOperationSubtraction) {
+TEST_P(EvaluatorTest, EvaluateBinaryOperationSubtraction) {
     const std::string code = "println(10 - 4);";
     Lexer lexer(code);
     const std::vector<Token> tokens = lexer.tokenize();
@@ -133,12 +172,11 @@ TEST(EvaluatorTest, EvaluateBinaryOperationSubtraction) {
     auto program = parser.parse();
 
     testing::internal::CaptureStdout();
-    Evaluator evaluator;
-    evaluator.evaluate(std::move(program));
+    evaluate(std::move(program));
     ASSERT_EQ(testing::internal::GetCapturedStdout(), "6\n");
 }
 
-TEST(EvaluatorTest, EvaluateBinaryOperationDivision) {
+TEST_P(EvaluatorTest, EvaluateBinaryOperationDivision) {
     const std::string code = "println(12 / 4);";
     Lexer lexer(code);
     const std::vector<Token> tokens = lexer.tokenize();
@@ -147,12 +185,11 @@ TEST(EvaluatorTest, EvaluateBinaryOperationDivision) {
     auto program = parser.parse();
 
     testing::internal::CaptureStdout();
-    Evaluator evaluator;
-    evaluator.evaluate(std::move(program));
+    evaluate(std::move(program));
     ASSERT_EQ(testing::internal::GetCapturedStdout(), "3\n");
 }
 
-TEST(EvaluatorTest, EvaluateUndefinedFunctionCall) {
+TEST_P(EvaluatorTest, EvaluateUndefinedFunctionCall) {
     const std::string code = "undefinedFunction();";
     Lexer lexer(code);
     const std::vector<Token> tokens = lexer.tokenize();
@@ -160,11 +197,10 @@ TEST(EvaluatorTest, EvaluateUndefinedFunctionCall) {
     Parser parser(tokens);
     auto program = parser.parse();
 
-    Evaluator evaluator;
-    ASSERT_THROW(evaluator.evaluate(std::move(program)), ZynkError);
+    ASSERT_THROW(evaluate(std::move(program)), ZynkError);
 }
 
-TEST(EvaluatorTest, EvaluateUndefinedVariableUsage) {
+TEST_P(EvaluatorTest, EvaluateUndefinedVariableUsage) {
     const std::string code = "println(x);";
     Lexer lexer(code);
     const std::vector<Token> tokens = lexer.tokenize();
@@ -172,11 +208,10 @@ TEST(EvaluatorTest, EvaluateUndefinedVariableUsage) {
     Parser parser(tokens);
     auto program = parser.parse();
 
-    Evaluator evaluator;
-    ASSERT_THROW(evaluator.evaluate(std::move(program)), ZynkError);
+    ASSERT_THROW(evaluate(std::move(program)), ZynkError);
 }
 
-TEST(EvaluatorTest, EvaluateFloatVariableDeclarationAndPrint) {
+TEST_P(EvaluatorTest, EvaluateFloatVariableDeclarationAndPrint) {
     const std::string code = "var x: float = 3.14;\nprintln(x);";
     Lexer lexer(code);
     const std::vector<Token> tokens = lexer.tokenize();
@@ -185,12 +220,11 @@ TEST(EvaluatorTest, EvaluateFloatVariableDeclarationAndPrint) {
     auto program = parser.parse();
 
     testing::internal::CaptureStdout();
-    Evaluator evaluator;
-    evaluator.evaluate(std::move(program));
+    evaluate(std::move(program));
     ASSERT_EQ(testing::internal::GetCapturedStdout(), "3.14\n");
 }
 
-TEST(EvaluatorTest, EvaluateBinaryOperationFloatAddition) {
+TEST_P(EvaluatorTest, EvaluateBinaryOperationFloatAddition) {
     const std::string code = "println(2.5 + 1.5);";
     Lexer lexer(code);
     const std::vector<Token> tokens = lexer.tokenize();
@@ -199,12 +233,76 @@ TEST(EvaluatorTest, EvaluateBinaryOperationFloatAddition) {
     auto program = parser.parse();
 
     testing::internal::CaptureStdout();
-    Evaluator evaluator;
-    evaluator.evaluate(std::move(program));
-    ASSERT_EQ(testing::internal::GetCapturedStdout(), "4.000000\n");
+    evaluate(std::move(program));
+    ASSERT_EQ(testing::internal::GetCapturedStdout(), "4.0\n");
 }
 
-TEST(EvaluatorTest, DuplicateVariableDeclaration) {
+TEST_P(EvaluatorTest, EvaluateFunctionDeclaredOnEveryCall) {
+    const std::string code = R"(
+        def f(n: int) -> int {
+            def g(k: int) -> int {
+                if (k == 0) {
+                    return n;
+                }
+                return g(k - 1);
+            }
+            if (n == 0) {
+                return g(2);
+            }
+            return f(n - 1) + g(1);
+        }
+        println(f(2));
+    )";
+    Lexer lexer(code);
+    const std::vector<Token> tokens = lexer.tokenize();
+
+    Parser parser(tokens);
+    auto program = parser.parse();
+
+    testing::internal::CaptureStdout();
+    evaluate(std::move(program));
+    ASSERT_EQ(testing::internal::GetCapturedStdout(), "3\n");
+}
+
+TEST_P(EvaluatorTest, CallFunctionDeclaredByAnotherCall) {
+    const std::string code = R"(
+        def f(n: int) -> int {
+            if (n == 0) {
+                return g();
+            }
+            def g() -> int {
+                return n;
+            }
+            return f(n - 1);
+        }
+        println(f(1));
+    )";
+    Lexer lexer(code);
+    const std::vector<Token> tokens = lexer.tokenize();
+
+    Parser parser(tokens);
+    auto program = parser.parse();
+
+    ASSERT_THROW(evaluate(std::move(program)), ZynkError);
+}
+
+TEST_P(EvaluatorTest, TypeErrorBeforeAnyOutput) {
+    const std::string code = R"(
+        println("started");
+        var x: int = "text";
+    )";
+    Lexer lexer(code);
+    const std::vector<Token> tokens = lexer.tokenize();
+
+    Parser parser(tokens);
+    auto program = parser.parse();
+
+    testing::internal::CaptureStdout();
+    ASSERT_THROW(evaluate(std::move(program)), ZynkError);
+    ASSERT_EQ(testing::internal::GetCapturedStdout(), "");
+}
+
+TEST_P(EvaluatorTest, DuplicateVariableDeclaration) {
     const std::string code = "var x: int = 42;\nvar x: int = 43;";
     Lexer lexer(code);
     const std::vector<Token> tokens = lexer.tokenize();
@@ -212,11 +310,10 @@ TEST(EvaluatorTest, DuplicateVariableDeclaration) {
     Parser parser(tokens);
     auto program = parser.parse();
 
-    Evaluator evaluator;
-    ASSERT_THROW(evaluator.evaluate(std::move(program)), ZynkError);
+    ASSERT_THROW(evaluate(std::move(program)), ZynkError);
 }
 
-TEST(EvaluatorTest, DuplicateFunctionDeclaration) {
+TEST_P(EvaluatorTest, DuplicateFunctionDeclaration) {
     const std::string code = R"(
         def myFunction() -> null {}
         def myFunction() -> null {}
@@ -227,11 +324,10 @@ TEST(EvaluatorTest, DuplicateFunctionDeclaration) {
     Parser parser(tokens);
     auto program = parser.parse();
 
-    Evaluator evaluator;
-    ASSERT_THROW(evaluator.evaluate(std::move(program)), ZynkError);
+    ASSERT_THROW(evaluate(std::move(program)), ZynkError);
 }
 
-TEST(EvaluatorTest, EvaluateVariableInExpression) {
+TEST_P(EvaluatorTest, EvaluateVariableInExpression) {
     const std::string code = "var x: int = 5;\nprintln(x + 10);";
     Lexer lexer(code);
     const std::vector<Token> tokens = lexer.tokenize();
@@ -240,12 +336,11 @@ TEST(EvaluatorTest, EvaluateVariableInExpression) {
     auto program = parser.parse();
 
     testing::internal::CaptureStdout();
-    Evaluator evaluator;
-    evaluator.evaluate(std::move(program));
+    evaluate(std::move(program));
     ASSERT_EQ(testing::internal::GetCapturedStdout(), "15\n");
 }
 
-TEST(EvaluatorTest, EvaluateBinaryOperationFloatMultiplication) {
+TEST_P(EvaluatorTest, EvaluateBinaryOperationFloatMultiplication) {
     const std::string code = "println(2.5 * 2);";
     Lexer lexer(code);
     const std::vector<Token> tokens = lexer.tokenize();
@@ -254,12 +349,11 @@ TEST(EvaluatorTest, EvaluateBinaryOperationFloatMultiplication) {
     auto program = parser.parse();
 
     testing::internal::CaptureStdout();
-    Evaluator evaluator;
-    evaluator.evaluate(std::move(program));
-    ASSERT_EQ(testing::internal::GetCapturedStdout(), "5.000000\n");
+    evaluate(std::move(program));
+    ASSERT_EQ(testing::internal::GetCapturedStdout(), "5.0\n");
 }
 
-TEST(EvaluatorTest, EvaluateDivisionByZero) {
+TEST_P(EvaluatorTest, EvaluateDivisionByZero) {
     const std::string code = "println(1 / 0);";
     Lexer lexer(code);
     const std::vector<Token> tokens = lexer.tokenize();
@@ -267,11 +361,10 @@ TEST(EvaluatorTest, EvaluateDivisionByZero) {
     Parser parser(tokens);
     auto program = parser.parse();
 
-    Evaluator evaluator;
-    ASSERT_THROW(evaluator.evaluate(std::move(program)), ZynkError);
+    ASSERT_THROW(evaluate(std::move(program)), ZynkError);
 }
 
-TEST(EvaluatorTest, EvaluateEmptyProgram) {
+TEST_P(EvaluatorTest, EvaluateEmptyProgram) {
     const std::string code = "";
     Lexer lexer(code);
     const std::vector<Token> tokens = lexer.tokenize();
@@ -280,12 +373,11 @@ TEST(EvaluatorTest, EvaluateEmptyProgram) {
     auto program = parser.parse();
 
     testing::internal::CaptureStdout();
-    Evaluator evaluator;
-    evaluator.evaluate(std::move(program));
+    evaluate(std::move(program));
     ASSERT_EQ(testing::internal::GetCapturedStdout(), "");
 }
 
-TEST(EvaluatorTest, EvaluateVariableModifyInteger) {
+TEST_P(EvaluatorTest, EvaluateVariableModifyInteger) {
     const std::string code = "var a: int = 10;\na = 20;\nprintln(a);";
     Lexer lexer(code);
     const std::vector<Token> tokens = lexer.tokenize();
@@ -294,12 +386,11 @@ TEST(EvaluatorTest, EvaluateVariableModifyInteger) {
     auto program = parser.parse();
 
     testing::internal::CaptureStdout();
-    Evaluator evaluator;
-    evaluator.evaluate(std::move(program));
+    evaluate(std::move(program));
     ASSERT_EQ(testing::internal::GetCapturedStdout(), "20\n");
 }
 
-TEST(EvaluatorTest, EvaluateVariableModifyWithExpression) {
+TEST_P(EvaluatorTest, EvaluateVariableModifyWithExpression) {
     const std::string code = "var y: int = 5;\ny = y + 10;\nprintln(y);";
     Lexer lexer(code);
     const std::vector<Token> tokens = lexer.tokenize();
@@ -308,12 +399,11 @@ TEST(EvaluatorTest, EvaluateVariableModifyWithExpression) {
     auto program = parser.parse();
 
     testing::internal::CaptureStdout();
-    Evaluator evaluator;
-    evaluator.evaluate(std::move(program));
+    evaluate(std::move(program));
     ASSERT_EQ(testing::internal::GetCapturedStdout(), "15\n");
 }
 
-TEST(EvaluatorTest, EvaluateVariableModifyMultipleTimes) {
+TEST_P(EvaluatorTest, EvaluateVariableModifyMultipleTimes) {
     const std::string code = R"(
         var z: int = 1;
         println(z);
@@ -329,12 +419,11 @@ TEST(EvaluatorTest, EvaluateVariableModifyMultipleTimes) {
     auto program = parser.parse();
 
     testing::internal::CaptureStdout();
-    Evaluator evaluator;
-    evaluator.evaluate(std::move(program));
+    evaluate(std::move(program));
     ASSERT_EQ(testing::internal::GetCapturedStdout(), "1\n2\n3\n");
 }
 
-TEST(EvaluatorTest, EvaluateIfStatementTrueCondition) {
+TEST_P(EvaluatorTest, EvaluateIfStatementTrueCondition) {
     const std::string code = R"(
         var x: int = 1;
         if (x) {
@@ -350,12 +439,11 @@ TEST(EvaluatorTest, EvaluateIfStatementTrueCondition) {
     auto program = parser.parse();
 
     testing::internal::CaptureStdout();
-    Evaluator evaluator;
-    evaluator.evaluate(std::move(program));
+    evaluate(std::move(program));
     ASSERT_EQ(testing::internal::GetCapturedStdout(), "Condition is true\n");
 }
 
-TEST(EvaluatorTest, EvaluateIfElseStatement) {
+TEST_P(EvaluatorTest, EvaluateIfElseStatement) {
     const std::string code = R"(
         var x: bool = false;
         if (x) {
@@ -371,12 +459,11 @@ TEST(EvaluatorTest, EvaluateIfElseStatement) {
     auto program = parser.parse();
 
     testing::internal::CaptureStdout();
-    Evaluator evaluator;
-    evaluator.evaluate(std::move(program));
+    evaluate(std::move(program));
     ASSERT_EQ(testing::internal::GetCapturedStdout(), "Condition is false, so this is printed\n");
 }
 
-TEST(EvaluatorTest, EvaluateShortIfStatement) {
+TEST_P(EvaluatorTest, EvaluateShortIfStatement) {
     const std::string code = R"(
         var x: int = 0;
         if (x) println(x);
@@ -389,12 +476,11 @@ TEST(EvaluatorTest, EvaluateShortIfStatement) {
     auto program = parser.parse();
 
     testing::internal::CaptureStdout();
-    Evaluator evaluator;
-    evaluator.evaluate(std::move(program));
+    evaluate(std::move(program));
     ASSERT_EQ(testing::internal::GetCapturedStdout(), "1\n");
 }
 
-TEST(EvaluatorTest, EvaluateReadStatementWithPrompt) {
+TEST_P(EvaluatorTest, EvaluateReadStatementWithPrompt) {
     const std::string code = R"(
         var input: string = readInput("Enter your name: ");
         println(input);
@@ -409,8 +495,7 @@ TEST(EvaluatorTest, EvaluateReadStatementWithPrompt) {
     Parser parser(tokens);
     auto program = parser.parse();
 
-    Evaluator evaluator;
-    evaluator.evaluate(std::move(program));
+    evaluate(std::move(program));
 
     std::cin.rdbuf(originalCinStreamBuf);
     std::string captured_output = testing::internal::GetCapturedStdout();
@@ -418,7 +503,7 @@ TEST(EvaluatorTest, EvaluateReadStatementWithPrompt) {
     ASSERT_EQ(captured_output.substr(captured_output.find("Alice")), "Alice\n");
 }
 
-TEST(EvaluatorTest, EvaluateReadStatementWithoutPrompt) {
+TEST_P(EvaluatorTest, EvaluateReadStatementWithoutPrompt) {
     const std::string code = R"(
         var input: string = readInput();
         println(input);
@@ -433,15 +518,14 @@ TEST(EvaluatorTest, EvaluateReadStatementWithoutPrompt) {
     Parser parser(tokens);
     auto program = parser.parse();
 
-    Evaluator evaluator;
-    evaluator.evaluate(std::move(program));
+    evaluate(std::move(program));
 
     std::cin.rdbuf(originalCinStreamBuf);
     std::string captured_output = testing::internal::GetCapturedStdout();
     ASSERT_EQ(captured_output, "Bob\n");
 }
 
-TEST(EvaluatorTest, EvaluateStringToIntCast) {
+TEST_P(EvaluatorTest, EvaluateStringToIntCast) {
     const std::string code = "var x: int = int(\"42\");\nprintln(x + 1);";
     Lexer lexer(code);
     const std::vector<Token> tokens = lexer.tokenize();
@@ -450,12 +534,11 @@ TEST(EvaluatorTest, EvaluateStringToIntCast) {
     auto program = parser.parse();
 
     testing::internal::CaptureStdout();
-    Evaluator evaluator;
-    evaluator.evaluate(std::move(program));
+    evaluate(std::move(program));
     ASSERT_EQ(testing::internal::GetCapturedStdout(), "43\n");
 }
 
-TEST(EvaluatorTest, EvaluateIntToFloatCast) {
+TEST_P(EvaluatorTest, EvaluateIntToFloatCast) {
     const std::string code = "var x: float = float(42);\nprintln(x);";
     Lexer lexer(code);
     const std::vector<Token> tokens = lexer.tokenize();
@@ -464,12 +547,11 @@ TEST(EvaluatorTest, EvaluateIntToFloatCast) {
     auto program = parser.parse();
 
     testing::internal::CaptureStdout();
-    Evaluator evaluator;
-    evaluator.evaluate(std::move(program));
-    ASSERT_EQ(testing::internal::GetCapturedStdout(), "42.000000\n");
+    evaluate(std::move(program));
+    ASSERT_EQ(testing::internal::GetCapturedStdout(), "42.0\n");
 }
 
-TEST(EvaluatorTest, EvaluateFloatToIntCast) {
+TEST_P(EvaluatorTest, EvaluateFloatToIntCast) {
     const std::string code = "var x: int = int(42.99);\nprintln(x);";
     Lexer lexer(code);
     const std::vector<Token> tokens = lexer.tokenize();
@@ -478,12 +560,11 @@ TEST(EvaluatorTest, EvaluateFloatToIntCast) {
     auto program = parser.parse();
 
     testing::internal::CaptureStdout();
-    Evaluator evaluator;
-    evaluator.evaluate(std::move(program));
+    evaluate(std::move(program));
     ASSERT_EQ(testing::internal::GetCapturedStdout(), "42\n");
 }
 
-TEST(EvaluatorTest, EvaluateStringToFloatCast) {
+TEST_P(EvaluatorTest, EvaluateStringToFloatCast) {
     const std::string code = "var x: float = float(\"42.50\");\nprintln(x);";
     Lexer lexer(code);
     const std::vector<Token> tokens = lexer.tokenize();
@@ -492,12 +573,11 @@ TEST(EvaluatorTest, EvaluateStringToFloatCast) {
     auto program = parser.parse();
 
     testing::internal::CaptureStdout();
-    Evaluator evaluator;
-    evaluator.evaluate(std::move(program));
-    ASSERT_EQ(testing::internal::GetCapturedStdout(), "42.500000\n");
+    evaluate(std::move(program));
+    ASSERT_EQ(testing::internal::GetCapturedStdout(), "42.5\n");
 }
 
-TEST(EvaluatorTest, EvaluateStringToBoolCast) {
+TEST_P(EvaluatorTest, EvaluateStringToBoolCast) {
     const std::string code = "var x: bool = bool(\"0\");\nprintln(x);";
     Lexer lexer(code);
     const std::vector<Token> tokens = lexer.tokenize();
@@ -506,24 +586,73 @@ TEST(EvaluatorTest, EvaluateStringToBoolCast) {
     auto program = parser.parse();
 
     testing::internal::CaptureStdout();
-    Evaluator evaluator;
-    evaluator.evaluate(std::move(program));
+    evaluate(std::move(program));
     ASSERT_EQ(testing::internal::GetCapturedStdout(), "false\n");
 }
 
-TEST(EvaluatorTest, EvaluateInvalidStringToIntCast) {
+TEST_P(EvaluatorTest, EvaluateInvalidStringToIntCast) {
     const std::string code = "var x: int = int(\"not_a_number\");\nprintln(x);";
     Lexer lexer(code);
     const std::vector<Token> tokens = lexer.tokenize();
 
     Parser parser(tokens);
     auto program = parser.parse();
-    Evaluator evaluator;
+    EXPECT_THROW(evaluate(std::move(program)), ZynkError);
+}
+
+TEST_P(EvaluatorTest, EvaluateOutOfRangeFloatToIntCast) {
+    const std::string code = "var big: float = 10000000000.0 * 10000000000.0;\nprintln(int(big));";
+    Lexer lexer(code);
+    const std::vector<Token> tokens = lexer.tokenize();
+
+    Parser parser(tokens);
+    auto program = parser.parse();
+    try {
+        evaluate(std::move(program));
+        FAIL() << "Expected ZynkError thrown.";
+    } catch (const ZynkError& error) {
+        EXPECT_EQ(error.base_type, ZynkErrorType::TypeCastError);
+        EXPECT_EQ(*error.line, 2u);
+    }
+}
+
+TEST_P(EvaluatorTest, EvaluateBinaryOperationOnUninitializedVariable) {
+    const std::string code = R"(
+        var x: int;
+        println(x + 1);
+    )";
+    Lexer lexer(code);
+    const std::vector<Token> tokens = lexer.tokenize();
+
+    Parser parser(tokens);
+    auto program = parser.parse();
+    try {
+        evaluate(std::move(program));
+        FAIL() << "Expected ZynkError thrown.";
+    } catch (const ZynkError& error) {
+        EXPECT_EQ(error.base_type, ZynkErrorType::ExpressionError);
+        EXPECT_STREQ(error.what(), "Cannot perform BinaryOperation on 'null' type.");
+        EXPECT_EQ(*error.line, 2u);
+    }
+}
+
+TEST_P(EvaluatorTest, EvaluateDuplicateDeclarationWithMultilineValue) {
+    const std::string code = "var x: int = 1;\nvar x: int =\n    2;";
+    Lexer lexer(code);
+    const std::vector<Token> tokens = lexer.tokenize();
 
-    EXPECT_THROW(evaluator.evaluate(std::move(program)), ZynkError);
+    Parser parser(tokens);
+    auto program = parser.parse();
+    try {
+        evaluate(std::move(program));
+        FAIL() << "Expected ZynkError thrown.";
+    } catch (const ZynkError& error) {
+        EXPECT_EQ(error.base_type, ZynkErrorType::DuplicateDeclarationError);
+        EXPECT_EQ(*error.line, 2u);
+    }
 }
 
-TEST(EvaluatorTest, EvaluateCommentedPrintStatement) {
+TEST_P(EvaluatorTest, EvaluateCommentedPrintStatement) {
     const std::string code = R"(
         // println("This should not be printed");
         var x: int = 5;
@@ -536,12 +665,11 @@ TEST(EvaluatorTest, EvaluateCommentedPrintStatement) {
     auto program = parser.parse();
 
     testing::internal::CaptureStdout();
-    Evaluator evaluator;
-    evaluator.evaluate(std::move(program));
+    evaluate(std::move(program));
     ASSERT_EQ(testing::internal::GetCapturedStdout(), "5\n");
 }
 
-TEST(EvaluatorTest, EvaluateNegativeInteger) {
+TEST_P(EvaluatorTest, EvaluateNegativeInteger) {
     const std::string code = "println(-42);";
     Lexer lexer(code);
     const std::vector<Token> tokens = lexer.tokenize();
@@ -550,12 +678,11 @@ TEST(EvaluatorTest, EvaluateNegativeInteger) {
     auto program = parser.parse();
 
     testing::internal::CaptureStdout();
-    Evaluator evaluator;
-    evaluator.evaluate(std::move(program));
+    evaluate(std::move(program));
     ASSERT_EQ(testing::internal::GetCapturedStdout(), "-42\n");
 }
 
-TEST(EvaluatorTest, EvaluateNegativeFloat) {
+TEST_P(EvaluatorTest, EvaluateNegativeFloat) {
     const std::string code = "println(-3.14);";
     Lexer lexer(code);
     const std::vector<Token> tokens = lexer.tokenize();
@@ -564,12 +691,11 @@ TEST(EvaluatorTest, EvaluateNegativeFloat) {
     auto program = parser.parse();
 
     testing::internal::CaptureStdout();
-    Evaluator evaluator;
-    evaluator.evaluate(std::move(program));
+    evaluate(std::move(program));
     ASSERT_EQ(testing::internal::GetCapturedStdout(), "-3.14\n");
 }
 
-TEST(EvaluatorTest, EvaluateAdditionWithNegativeInteger) {
+TEST_P(EvaluatorTest, EvaluateAdditionWithNegativeInteger) {
     const std::string code = "println(10 + -4);";
     Lexer lexer(code);
     const std::vector<Token> tokens = lexer.tokenize();
@@ -578,12 +704,11 @@ TEST(EvaluatorTest, EvaluateAdditionWithNegativeInteger) {
     auto program = parser.parse();
 
     testing::internal::CaptureStdout();
-    Evaluator evaluator;
-    evaluator.evaluate(std::move(program));
+    evaluate(std::move(program));
     ASSERT_EQ(testing::internal::GetCapturedStdout(), "6\n");
 }
 
-TEST(EvaluatorTest, EvaluateMultiplicationWithNegativeInteger) {
+TEST_P(EvaluatorTest, EvaluateMultiplicationWithNegativeInteger) {
     const std::string code = "println(-5.5 * 3);";
     Lexer lexer(code);
     const std::vector<Token> tokens = lexer.tokenize();
@@ -592,12 +717,11 @@ TEST(EvaluatorTest, EvaluateMultiplicationWithNegativeInteger) {
     auto program = parser.parse();
 
     testing::internal::CaptureStdout();
-    Evaluator evaluator;
-    evaluator.evaluate(std::move(program));
-    ASSERT_EQ(testing::internal::GetCapturedStdout(), "-16.500000\n");
+    evaluate(std::move(program));
+    ASSERT_EQ(testing::internal::GetCapturedStdout(), "-16.5\n");
 }
 
-TEST(EvaluatorTest, EvaluateLogicalAndTrueTrue) {
+TEST_P(EvaluatorTest, EvaluateLogicalAndTrueTrue) {
     const std::string code = "println(true && true);";
     Lexer lexer(code);
     const std::vector<Token> tokens = lexer.tokenize();
@@ -606,12 +730,11 @@ TEST(EvaluatorTest, EvaluateLogicalAndTrueTrue) {
     auto program = parser.parse();
 
     testing::internal::CaptureStdout();
-    Evaluator evaluator;
-    evaluator.evaluate(std::move(program));
+    evaluate(std::move(program));
     ASSERT_EQ(testing::internal::GetCapturedStdout(), "true\n");
 }
 
-TEST(EvaluatorTest, EvaluateLogicalAndTrueFalse) {
+TEST_P(EvaluatorTest, EvaluateLogicalAndTrueFalse) {
     const std::string code = "println(true && false);";
     Lexer lexer(code);
     const std::vector<Token> tokens = lexer.tokenize();
@@ -620,12 +743,11 @@ TEST(EvaluatorTest, EvaluateLogicalAndTrueFalse) {
     auto program = parser.parse();
 
     testing::internal::CaptureStdout();
-    Evaluator evaluator;
-    evaluator.evaluate(std::move(program));
+    evaluate(std::move(program));
     ASSERT_EQ(testing::internal::GetCapturedStdout(), "false\n");
 }
 
-TEST(EvaluatorTest, EvaluateLogicalOrTrueFalse) {
+TEST_P(EvaluatorTest, EvaluateLogicalOrTrueFalse) {
     const std::string code = "println(true || false);";
     Lexer lexer(code);
     const std::vector<Token> tokens = lexer.tokenize();
@@ -634,12 +756,11 @@ TEST(EvaluatorTest, EvaluateLogicalOrTrueFalse) {
     auto program = parser.parse();
 
     testing::internal::CaptureStdout();
-    Evaluator evaluator;
-    evaluator.evaluate(std::move(program));
+    evaluate(std::move(program));
     ASSERT_EQ(testing::internal::GetCapturedStdout(), "true\n");
 }
 
-TEST(EvaluatorTest, EvaluateLogicalOrFalseFalse) {
+TEST_P(EvaluatorTest, EvaluateLogicalOrFalseFalse) {
     const std::string code = "println(false || false);";
     Lexer lexer(code);
     const std::vector<Token> tokens = lexer.tokenize();
@@ -648,12 +769,11 @@ TEST(EvaluatorTest, EvaluateLogicalOrFalseFalse) {
     auto program = parser.parse();
 
     testing::internal::CaptureStdout();
-    Evaluator evaluator;
-    evaluator.evaluate(std::move(program));
+    evaluate(std::move(program));
     ASSERT_EQ(testing::internal::GetCapturedStdout(), "false\n");
 }
 
-TEST(EvaluatorTest, EvaluateFStringWithMultipleExpressions) {
+TEST_P(EvaluatorTest, EvaluateFStringWithMultipleExpressions) {
     const std::string code = R"(
         var x: int = 42;
         var y: float = 3.5;
@@ -666,12 +786,11 @@ TEST(EvaluatorTest, EvaluateFStringWithMultipleExpressions) {
     auto program = parser.parse();
 
     testing::internal::CaptureStdout();
-    Evaluator evaluator;
-    evaluator.evaluate(std::move(program));
-    ASSERT_EQ(testing::internal::GetCapturedStdout(), "x: 42, y: 3.5, sum: 45.500000\n");
+    evaluate(std::move(program));
+    ASSERT_EQ(testing::internal::GetCapturedStdout(), "x: 42, y: 3.5, sum: 45.5\n");
 }
 
-TEST(EvaluatorTest, EvaluatePrintExpressionWithParentheses) {
+TEST_P(EvaluatorTest, EvaluatePrintExpressionWithParentheses) {
     const std::string code = "println((1 + 2) * 5);";
     Lexer lexer(code);
     const std::vector<Token> tokens = lexer.tokenize();
@@ -680,12 +799,11 @@ TEST(EvaluatorTest, EvaluatePrintExpressionWithParentheses) {
     auto program = parser.parse();
 
     testing::internal::CaptureStdout();
-    Evaluator evaluator;
-    evaluator.evaluate(std::move(program));
+    evaluate(std::move(program));
     ASSERT_EQ(testing::internal::GetCapturedStdout(), "15\n");
 }
 
-TEST(EvaluatorTest, EvaluatePrintNestedParentheses) {
+TEST_P(EvaluatorTest, EvaluatePrintNestedParentheses) {
     const std::string code = "println(((3 + 4) * (2 + 1)));";
     Lexer lexer(code);
     const std::vector<Token> tokens = lexer.tokenize();
@@ -694,12 +812,11 @@ TEST(EvaluatorTest, EvaluatePrintNestedParentheses) {
     auto program = parser.parse();
 
     testing::internal::CaptureStdout();
-    Evaluator evaluator;
-    evaluator.evaluate(std::move(program));
+    evaluate(std::move(program));
     ASSERT_EQ(testing::internal::GetCapturedStdout(), "21\n");
 }
 
-TEST(EvaluatorTest, EvaluateVarNestedParentheses) {
+TEST_P(EvaluatorTest, EvaluateVarNestedParentheses) {
     const std::string code = R"(
         var x: int = ((3 + 4) * (2 + 1));
         println(x);
@@ -711,12 +828,11 @@ TEST(EvaluatorTest, EvaluateVarNestedParentheses) {
     auto program = parser.parse();
 
     testing::internal::CaptureStdout();
-    Evaluator evaluator;
-    evaluator.evaluate(std::move(program));
+    evaluate(std::move(program));
     ASSERT_EQ(testing::internal::GetCapturedStdout(), "21\n");
 }
 
-TEST(EvaluatorTest, EvaluateFStringWithIntegers) {
+TEST_P(EvaluatorTest, EvaluateFStringWithIntegers) {
     const std::string code = R"(
         var x: int = 42;
         println(f"Value of x is {x}");
@@ -728,12 +844,11 @@ TEST(EvaluatorTest, EvaluateFStringWithIntegers) {
     auto program = parser.parse();
 
     testing::internal::CaptureStdout();
-    Evaluator evaluator;
-    evaluator.evaluate(std::move(program));
+    evaluate(std::move(program));
     ASSERT_EQ(testing::internal::GetCapturedStdout(), "Value of x is 42\n");
 }
 
-TEST(EvaluatorTest, EvaluateFStringWithBooleans) {
+TEST_P(EvaluatorTest, EvaluateFStringWithBooleans) {
     const std::string code = R"(
         var is_valid: bool = true;
         println(f"Is the input valid? {is_valid}");
@@ -745,12 +860,11 @@ TEST(EvaluatorTest, EvaluateFStringWithBooleans) {
     auto program = parser.parse();
 
     testing::internal::CaptureStdout();
-    Evaluator evaluator;
-    evaluator.evaluate(std::move(program));
+    evaluate(std::move(program));
     ASSERT_EQ(testing::internal::GetCapturedStdout(), "Is the input valid? true\n");
 }
 
-TEST(EvaluatorTest, EvaluateFStringWithStringInterpolation) {
+TEST_P(EvaluatorTest, EvaluateFStringWithStringInterpolation) {
     const std::string code = R"(
         var name: string = "Alice";
         var age: int = 30;
@@ -763,12 +877,11 @@ TEST(EvaluatorTest, EvaluateFStringWithStringInterpolation) {
     auto program = parser.parse();
 
     testing::internal::CaptureStdout();
-    Evaluator evaluator;
-    evaluator.evaluate(std::move(program));
+    evaluate(std::move(program));
     ASSERT_EQ(testing::internal::GetCapturedStdout(), "My name is Alice and I am 30 years old.\n");
 }
 
-TEST(EvaluatorTest, EvaluateFStringWithUndefinedVariable) {
+TEST_P(EvaluatorTest, EvaluateFStringWithUndefinedVariable) {
     const std::string code = "println(f\"{abc}\");";
     Lexer lexer(code);
     const std::vector<Token> tokens = lexer.tokenize();
@@ -776,23 +889,10 @@ TEST(EvaluatorTest, EvaluateFStringWithUndefinedVariable) {
     Parser parser(tokens);
     auto program = parser.parse();
 
-    Evaluator evaluator;
-    ASSERT_THROW(evaluator.evaluate(std::move(program)), ZynkError);
+    ASSERT_THROW(evaluate(std::move(program)), ZynkError);
 }
 
-TEST(EvaluatorTest, EvaluateFStringWithUnclosedBracket) {
-    const std::string code = "println(f\"{abc\");";
-    Lexer lexer(code);
-    const std::vector<Token> tokens = lexer.tokenize();
-
-    Parser parser(tokens);
-    auto program = parser.parse();
-
-    Evaluator evaluator;
-    ASSERT_THROW(evaluator.evaluate(std::move(program)), ZynkError);
-}
-
-TEST(EvaluatorTest, EvaluateEqualOperation) {
+TEST_P(EvaluatorTest, EvaluateEqualOperation) {
     const std::string code = "println(5 == 5);";
     Lexer lexer(code);
     const std::vector<Token> tokens = lexer.tokenize();
@@ -801,12 +901,11 @@ TEST(EvaluatorTest, EvaluateEqualOperation) {
     auto program = parser.parse();
 
     testing::internal::CaptureStdout();
-    Evaluator evaluator;
-    evaluator.evaluate(std::move(program));
+    evaluate(std::move(program));
     ASSERT_EQ(testing::internal::GetCapturedStdout(), "true\n");
 }
 
-TEST(EvaluatorTest, EvaluateGreaterThanOperation) {
+TEST_P(EvaluatorTest, EvaluateGreaterThanOperation) {
     const std::string code = "println(7 > 4);";
     Lexer lexer(code);
     const std::vector<Token> tokens = lexer.tokenize();
@@ -815,12 +914,11 @@ TEST(EvaluatorTest, EvaluateGreaterThanOperation) {
     auto program = parser.parse();
 
     testing::internal::CaptureStdout();
-    Evaluator evaluator;
-    evaluator.evaluate(std::move(program));
+    evaluate(std::move(program));
     ASSERT_EQ(testing::internal::GetCapturedStdout(), "true\n");
 }
 
-TEST(EvaluatorTest, EvaluateStringEqualityOperation) {
+TEST_P(EvaluatorTest, EvaluateStringEqualityOperation) {
     const std::string code = R"(
         var a: string = "hello";
         var b: string = "hello";
@@ -833,12 +931,11 @@ TEST(EvaluatorTest, EvaluateStringEqualityOperation) {
     auto program = parser.parse();
 
     testing::internal::CaptureStdout();
-    Evaluator evaluator;
-    evaluator.evaluate(std::move(program));
+    evaluate(std::move(program));
     ASSERT_EQ(testing::internal::GetCapturedStdout(), "true\n");
 }
 
-TEST(EvaluatorTest, EvaluateLessThanOrEqualOperation) {
+TEST_P(EvaluatorTest, EvaluateLessThanOrEqualOperation) {
     const std::string code = "println(5 <= 5);";
     Lexer lexer(code);
     const std::vector<Token> tokens = lexer.tokenize();
@@ -847,12 +944,11 @@ TEST(EvaluatorTest, EvaluateLessThanOrEqualOperation) {
     auto program = parser.parse();
 
     testing::internal::CaptureStdout();
-    Evaluator evaluator;
-    evaluator.evaluate(std::move(program));
+    evaluate(std::move(program));
     ASSERT_EQ(testing::internal::GetCapturedStdout(), "true\n");
 }
 
-TEST(EvaluatorTest, FunctionCallWithRecursiveLoopThrowsError) {
+TEST_P(EvaluatorTest, FunctionCallWithRecursiveLoopThrowsError) {
     const std::string code = R"(
         var x: int = 0;
 
@@ -868,11 +964,10 @@ TEST(EvaluatorTest, FunctionCallWithRecursiveLoopThrowsError) {
     Parser parser(tokens);
     auto program = parser.parse();
 
-    Evaluator evaluator;
-    ASSERT_THROW(evaluator.evaluate(std::move(program)), ZynkError);
+    ASSERT_THROW(evaluate(std::move(program)), ZynkError);
 }
 
-TEST(EvaluatorTest, EvaluateFunctionReturningWrongType) {
+TEST_P(EvaluatorTest, EvaluateFunctionReturningWrongType) {
     const std::string code = R"(
         def myFunction() -> int {
             return "string"; // Funkcja deklaruje int, ale zwraca string
@@ -885,11 +980,10 @@ TEST(EvaluatorTest, EvaluateFunctionReturningWrongType) {
     Parser parser(tokens);
     auto program = parser.parse();
 
-    Evaluator evaluator;
-    ASSERT_THROW(evaluator.evaluate(std::move(program)), ZynkError);
+    ASSERT_THROW(evaluate(std::move(program)), ZynkError);
 }
 
-TEST(EvaluatorTest, EvaluateFunctionReturningNullWhenValueExpected) {
+TEST_P(EvaluatorTest, EvaluateFunctionReturningNullWhenValueExpected) {
     const std::string code = R"(
         def myFunction() -> int {
             return 1;
@@ -904,12 +998,11 @@ TEST(EvaluatorTest, EvaluateFunctionReturningNullWhenValueExpected) {
     auto program = parser.parse();
 
     testing::internal::CaptureStdout();
-    Evaluator evaluator;
-    evaluator.evaluate(std::move(program));
+    evaluate(std::move(program));
     ASSERT_EQ(testing::internal::GetCapturedStdout(), "1\n");
 }
 
-TEST(EvaluatorTest, EvaluateFunctionWithIntegerArgument) {
+TEST_P(EvaluatorTest, EvaluateFunctionWithIntegerArgument) {
     const std::string code = R"(
         def myFunction(x: int) -> null {
             println(x + 1);
@@ -923,12 +1016,11 @@ TEST(EvaluatorTest, EvaluateFunctionWithIntegerArgument) {
     auto program = parser.parse();
 
     testing::internal::CaptureStdout();
-    Evaluator evaluator;
-    evaluator.evaluate(std::move(program));
+    evaluate(std::move(program));
     ASSERT_EQ(testing::internal::GetCapturedStdout(), "11\n");
 }
 
-TEST(EvaluatorTest, EvaluateFunctionWithMultipleArguments) {
+TEST_P(EvaluatorTest, EvaluateFunctionWithMultipleArguments) {
     const std::string code = R"(
         def add(a: int, b: int) -> int {
             return a + b;
@@ -942,12 +1034,11 @@ TEST(EvaluatorTest, EvaluateFunctionWithMultipleArguments) {
     auto program = parser.parse();
 
     testing::internal::CaptureStdout();
-    Evaluator evaluator;
-    evaluator.evaluate(std::move(program));
+    evaluate(std::move(program));
     ASSERT_EQ(testing::internal::GetCapturedStdout(), "7\n");
 }
 
-TEST(EvaluatorTest, EvaluateFunctionWithStringArgument) {
+TEST_P(EvaluatorTest, EvaluateFunctionWithStringArgument) {
     const std::string code = R"(
         def greet(name: string) -> null {
             println(f"Hello, {name}!");
@@ -961,12 +1052,11 @@ TEST(EvaluatorTest, EvaluateFunctionWithStringArgument) {
     auto program = parser.parse();
 
     testing::internal::CaptureStdout();
-    Evaluator evaluator;
-    evaluator.evaluate(std::move(program));
+    evaluate(std::move(program));
     ASSERT_EQ(testing::internal::GetCapturedStdout(), "Hello, Alice!\n");
 }
 
-TEST(EvaluatorTest, EvaluateFunctionWithBooleanArgument) {
+TEST_P(EvaluatorTest, EvaluateFunctionWithBooleanArgument) {
     const std::string code = R"(
         def checkStatus(active: bool) -> null {
             if (active) {
@@ -984,12 +1074,11 @@ TEST(EvaluatorTest, EvaluateFunctionWithBooleanArgument) {
     auto program = parser.parse();
 
     testing::internal::CaptureStdout();
-    Evaluator evaluator;
-    evaluator.evaluate(std::move(program));
+    evaluate(std::move(program));
     ASSERT_EQ(testing::internal::GetCapturedStdout(), "Active\n");
 }
 
-TEST(EvaluatorTest, EvaluateWhileLoopBasic) {
+TEST_P(EvaluatorTest, EvaluateWhileLoopBasic) {
     const std::string code = R"(
         var x: int = 0;
         while (x < 5) {
@@ -1004,12 +1093,11 @@ TEST(EvaluatorTest, EvaluateWhileLoopBasic) {
     auto program = parser.parse();
 
     testing::internal::CaptureStdout();
-    Evaluator evaluator;
-    evaluator.evaluate(std::move(program));
+    evaluate(std::move(program));
     ASSERT_EQ(testing::internal::GetCapturedStdout(), "0\n1\n2\n3\n4\n");
 }
 
-TEST(EvaluatorTest, EvaluateWhileLoopWithBreak) {
+TEST_P(EvaluatorTest, EvaluateWhileLoopWithBreak) {
     const std::string code = R"(
         var x: int = 0;
         while (true) {
@@ -1028,7 +1116,177 @@ TEST(EvaluatorTest, EvaluateWhileLoopWithBreak) {
     auto program = parser.parse();
 
     testing::internal::CaptureStdout();
-    Evaluator evaluator;
-    evaluator.evaluate(std::move(program));
+    evaluate(std::move(program));
     ASSERT_EQ(testing::internal::GetCapturedStdout(), "0\n1\n2\nLoop ended\n");
-}
\ No newline at end of file
+}
+
+TEST_P(EvaluatorTest, EvaluateReturnFromNestedLoop) {
+    const std::string code = R"(
+        def find(limit: int) -> int {
+            var i: int = 0;
+            var j: int = 0;
+            while (true) {
+                j = 0;
+                while (j < limit) {
+                    if (i * j == 6) {
+                        return i + j;
+                    }
+                    j = j + 1;
+                }
+                i = i + 1;
+            }
+        }
+        println(find(4));
+    )";
+    Lexer lexer(code);
+    const std::vector<Token> tokens = lexer.tokenize();
+
+    Parser parser(tokens);
+    auto program = parser.parse();
+
+    testing::internal::CaptureStdout();
+    evaluate(std::move(program));
+    ASSERT_EQ(testing::internal::GetCapturedStdout(), "5\n");
+}
+
+TEST_P(EvaluatorTest, EvaluateBreakFromInnerLoop) {
+    const std::string code = R"(
+        var i: int = 0;
+        while (i < 2) {
+            while (true) {
+                if (true) {
+                    break;
+                }
+            }
+            print(i);
+            i = i + 1;
+        }
+    )";
+    Lexer lexer(code);
+    const std::vector<Token> tokens = lexer.tokenize();
+
+    Parser parser(tokens);
+    auto program = parser.parse();
+
+    testing::internal::CaptureStdout();
+    evaluate(std::move(program));
+    ASSERT_EQ(testing::internal::GetCapturedStdout(), "01");
+}
+
+TEST_P(EvaluatorTest, EvaluateBreakOutsideLoop) {
+    const std::string code = R"(
+        if (true) {
+            break;
+        }
+    )";
+    Lexer lexer(code);
+    const std::vector<Token> tokens = lexer.tokenize();
+
+    Parser parser(tokens);
+    auto program = parser.parse();
+    ASSERT_THROW(evaluate(std::move(program)), ZynkError);
+}
+
+TEST_P(EvaluatorTest, EvaluateLargeIntegerArithmetic) {
+    const std::string code = R"(
+        var big: int = 16777217;
+        println(big + 2);
+        println(3000000000 * 3);
+        println(-7 / 2);
+        println(1.5 * 4);
+    )";
+    Lexer lexer(code);
+    const std::vector<Token> tokens = lexer.tokenize();
+
+    Parser parser(tokens);
+    auto program = parser.parse();
+
+    testing::internal::CaptureStdout();
+    evaluate(std::move(program));
+    ASSERT_EQ(testing::internal::GetCapturedStdout(), "16777219\n9000000000\n-3\n6.0\n");
+}
+
+TEST_P(EvaluatorTest, EvaluateIntegerOverflow) {
+    const std::string code = R"(
+        var big: int = 9223372036854775807;
+        println(big + 1);
+    )";
+    Lexer lexer(code);
+    const std::vector<Token> tokens = lexer.tokenize();
+
+    Parser parser(tokens);
+    auto program = parser.parse();
+    ASSERT_THROW(evaluate(std::move(program)), ZynkError);
+}
+
+TEST_P(EvaluatorTest, EvaluateLogicalOperationsOfMixedTypes) {
+    const std::string code = R"(
+        var i: int = 5;
+        if (i > 3 and i < 10) { println("in"); }
+        var b: bool = i > 3 and i < 10;
+        println(b);
+        println(1 and "x");
+        println(0 and "x");
+        println(0 or 2.5);
+    )";
+    Lexer lexer(code);
+    const std::vector<Token> tokens = lexer.tokenize();
+
+    Parser parser(tokens);
+    auto program = parser.parse();
+
+    testing::internal::CaptureStdout();
+    evaluate(std::move(program));
+    ASSERT_EQ(testing::internal::GetCapturedStdout(), "in\ntrue\nx\n0\n2.5\n");
+}
+
+TEST_P(EvaluatorTest, EvaluateTypedComparisons) {
+    const std::string code = R"(
+        var big: int = 16777217;
+        println(big == 16777216);
+        println("apple" < "banana");
+        println("10" < "9");
+        println(false < true);
+        println(2 == 2.0);
+        println("5" == 5);
+    )";
+    Lexer lexer(code);
+    const std::vector<Token> tokens = lexer.tokenize();
+
+    Parser parser(tokens);
+    auto program = parser.parse();
+
+    testing::internal::CaptureStdout();
+    evaluate(std::move(program));
+    ASSERT_EQ(testing::internal::GetCapturedStdout(), "false\ntrue\ntrue\ntrue\ntrue\ntrue\n");
+}
+
+TEST(TreeWalkerTest, EvaluateDoesNotModifyProgram) {
+    const std::string code = R"(
+        def count(limit: int) -> int {
+            var i: int = 0;
+            while (i < limit) {
+                if (i == 2) {
+                    print("two ");
+                }
+                i = i + 1;
+            }
+            return i;
+        }
+        println(count(3));
+    )";
+    Lexer lexer(code);
+    const std::vector<Token> tokens = lexer.tokenize();
+
+    Parser parser(tokens);
+    const auto program = parser.parse();
+    Resolver().resolve(*program);
+    TypeChecker().check(*program);
+
+    testing::internal::CaptureStdout();
+    Evaluator first;
+    first.evaluate(*program);
+    Evaluator second;
+    second.evaluate(*program);
+    ASSERT_EQ(testing::internal::GetCapturedStdout(), "two 3\ntwo 3\n");
+}
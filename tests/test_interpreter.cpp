@@ -3,6 +3,8 @@
 #include "../src/execution/include/interpreter.hpp"
 #include "../src/errors/include/errors.hpp"
 
+#include <fstream>
+
 TEST(InterpreterTest, ShouldThrowFileOpenError) {
 	// For now there is no need to test the interpreter stronger, 
 	// as most things are tested in other tests anyway.
@@ -17,4 +19,13 @@ TEST(InterpreterTest, ShouldThrowFileOpenError) {
 	catch (const std::exception& error) {
 		FAIL() << "Unexpected exception type: " << error.what();
 	}
-}
\ No newline at end of file
+}
+
+TEST(InterpreterTest, DumpsOptimizedScript) {
+	const std::string path = testing::TempDir() + "optimized.zk";
+	std::ofstream(path) << "var day: int = 60 * 60 * 24;\nprintln(day);\n";
+
+	const std::string dump = ZynkInterpreter().dumpOptimized(path);
+	EXPECT_EQ(dump.rfind("// Constant folding: 2 expressions folded, 1 constants propagated, 0 branches pruned.\n", 0), 0u);
+	EXPECT_EQ(dump.substr(dump.find("\n\n")), "\n\nprintln(86400);\n");
+}
@@ -0,0 +1,452 @@
+#include <gtest/gtest.h>
+#include <cmath>
+
+#include "../src/execution/jit/include/codegen.hpp"
+#include "../src/execution/jit/include/jit.hpp"
+#include "../src/execution/jit/include/tracer.hpp"
+#include "../src/execution/include/evaluator.hpp"
+#include "../src/execution/vm/include/compiler.hpp"
+#include "../src/execution/vm/include/vm.hpp"
+#include "../src/execution/closure/include/closure.hpp"
+#include "../src/errors/include/errors.hpp"
+#include "helpers.hpp"
+
+static const ASTFunction& firstFunction(const ASTProgram& program) {
+    return static_cast<const ASTFunction&>(*program.body[0]);
+}
+
+static std::string runTreeWalker(const std::string& code, bool useJit) {
+    auto program = parseSource(code);
+    testing::internal::CaptureStdout();
+    try {
+        Evaluator(useJit).evaluate(*program);
+    } catch (...) {
+        testing::internal::GetCapturedStdout();
+        throw;
+    }
+    return testing::internal::GetCapturedStdout();
+}
+
+static std::string runVm(const std::string& code, bool useJit) {
+    auto program = parseSource(code);
+    auto compiled = Compiler().compile(*program);
+    testing::internal::CaptureStdout();
+    try {
+        VirtualMachine(useJit).run(*compiled);
+    } catch (...) {
+        testing::internal::GetCapturedStdout();
+        throw;
+    }
+    return testing::internal::GetCapturedStdout();
+}
+
+static std::string runClosures(const std::string& code, bool useJit) {
+    auto program = parseSource(code);
+    testing::internal::CaptureStdout();
+    try {
+        ClosureEngine(useJit).run(*program);
+    } catch (...) {
+        testing::internal::GetCapturedStdout();
+        throw;
+    }
+    return testing::internal::GetCapturedStdout();
+}
+
+static const std::string numericProgram = R"(
+    def fib(n: int) -> int {
+        if (n < 2) {
+            return n;
+        }
+        return fib(n - 1) + fib(n - 2);
+    }
+    def average(a: float, b: float) -> float {
+        return (a + b) / 2.0;
+    }
+    def sumUntil(n: int, limit: int) -> int {
+        var i: int = 0;
+        var total: int = 0;
+        while (i < n) {
+            i = i + 1;
+            if (i > limit) {
+                break;
+            }
+            total = total + i;
+        }
+        return total;
+    }
+    def isEven(n: int) -> bool {
+        return (n / 2 * 2 == n) or (n == 0);
+    }
+    println(fib(20));
+    var i: int = 0;
+    while (i < 30) {
+        println(f"{average(float(i), 0.5)} {sumUntil(i, 20)} {isEven(i)} {int(average(float(i), 1.0))}");
+        i = i + 1;
+    }
+)";
+
+TEST(CodeGeneratorTest, GeneratesNumericFunction) {
+    auto program = parseSource(R"(
+        def square(x: float) -> float {
+            return x * x;
+        }
+    )");
+    std::vector<uint8_t> code;
+    std::vector<const ASTFunction*> callees;
+    EXPECT_TRUE(CodeGenerator().generate(firstFunction(*program), code, callees));
+    EXPECT_FALSE(code.empty());
+    EXPECT_TRUE(callees.empty());
+}
+
+TEST(CodeGeneratorTest, CollectsCallees) {
+    auto program = parseSource(R"(
+        def fib(n: int) -> int {
+            if (n < 2) {
+                return n;
+            }
+            return fib(n - 1) + fib(n - 2);
+        }
+    )");
+    std::vector<uint8_t> code;
+    std::vector<const ASTFunction*> callees;
+    ASSERT_TRUE(CodeGenerator().generate(firstFunction(*program), code, callees));
+    ASSERT_FALSE(callees.empty());
+    EXPECT_EQ(callees[0], &firstFunction(*program));
+}
+
+TEST(CodeGeneratorTest, RejectsSideEffects) {
+    auto program = parseSource(R"(
+        def shout(x: int) -> int {
+            println(x);
+            return x;
+        }
+    )");
+    std::vector<uint8_t> code;
+    std::vector<const ASTFunction*> callees;
+    EXPECT_FALSE(CodeGenerator().generate(firstFunction(*program), code, callees));
+}
+
+TEST(CodeGeneratorTest, RejectsStrings) {
+    auto program = parseSource(R"(
+        def name(x: string) -> int {
+            return 1;
+        }
+    )");
+    std::vector<uint8_t> code;
+    std::vector<const ASTFunction*> callees;
+    EXPECT_FALSE(CodeGenerator().generate(firstFunction(*program), code, callees));
+}
+
+#ifdef ZYNK_JIT_SUPPORTED
+TEST(JitTest, CompilesAfterThreshold) {
+    auto program = parseSource(R"(
+        def add(a: int, b: int) -> int {
+            return a + b;
+        }
+    )");
+    const ASTFunction& add = firstFunction(*program);
+    RuntimeEnvironment env;
+    env.enterProgram(program->frameSize);
+    env.declareFunction(&add);
+
+    Jit jit(2);
+    const Value arguments[] = { Value::fromInt(40), Value::fromInt(2) };
+    Value result;
+    EXPECT_FALSE(jit.call(add, 0, arguments, env, result));
+    EXPECT_FALSE(jit.isCompiled(add));
+
+    ASSERT_TRUE(jit.call(add, 0, arguments, env, result));
+    EXPECT_TRUE(jit.isCompiled(add));
+    EXPECT_EQ(result.asInt(), 42);
+}
+
+TEST(JitTest, BailsOutOnOverflow) {
+    auto program = parseSource(R"(
+        def grow(a: int) -> int {
+            return a * 4;
+        }
+    )");
+    const ASTFunction& grow = firstFunction(*program);
+    RuntimeEnvironment env;
+    env.enterProgram(program->frameSize);
+    env.declareFunction(&grow);
+
+    Jit jit(1);
+    const Value small[] = { Value::fromInt(3) };
+    Value result;
+    ASSERT_TRUE(jit.call(grow, 0, small, env, result));
+    EXPECT_EQ(result.asInt(), 12);
+
+    const Value large[] = { Value::fromInt(INT64_MAX / 2) };
+    EXPECT_FALSE(jit.call(grow, 0, large, env, result));
+}
+
+TEST(JitTest, BailsOutOnOutOfRangeCast) {
+    auto program = parseSource(R"(
+        def truncate(a: float) -> int {
+            return int(a);
+        }
+    )");
+    const ASTFunction& truncate = firstFunction(*program);
+    RuntimeEnvironment env;
+    env.enterProgram(program->frameSize);
+    env.declareFunction(&truncate);
+
+    Jit jit(1);
+    Value result;
+    const Value small[] = { Value::fromFloat(-2.75) };
+    ASSERT_TRUE(jit.call(truncate, 0, small, env, result));
+    EXPECT_EQ(result.asInt(), -2);
+
+    for (const double number : { 1e20, -1e20, std::nan(""), -9.2233720368547758e18 }) {
+        const Value arguments[] = { Value::fromFloat(number) };
+        EXPECT_FALSE(jit.call(truncate, 0, arguments, env, result));
+    }
+}
+
+TEST(JitTest, SkipsUnsupportedFunctions) {
+    auto program = parseSource(R"(
+        def shout(x: int) -> int {
+            println(x);
+            return x;
+        }
+    )");
+    const ASTFunction& shout = firstFunction(*program);
+    RuntimeEnvironment env;
+    env.enterProgram(program->frameSize);
+    env.declareFunction(&shout);
+
+    Jit jit(1);
+    const Value arguments[] = { Value::fromInt(1) };
+    Value result;
+    EXPECT_FALSE(jit.call(shout, 0, arguments, env, result));
+    EXPECT_FALSE(jit.isCompiled(shout));
+}
+#endif
+
+TEST(JitTest, TreeWalkerOutputMatches) {
+    EXPECT_EQ(runTreeWalker(numericProgram, true), runTreeWalker(numericProgram, false));
+}
+
+TEST(JitTest, VirtualMachineOutputMatches) {
+    EXPECT_EQ(runVm(numericProgram, true), runVm(numericProgram, false));
+}
+
+TEST(JitTest, ClosureEngineOutputMatches) {
+    EXPECT_EQ(runClosures(numericProgram, true), runTreeWalker(numericProgram, false));
+}
+
+TEST(JitTest, DivisionByZeroStillThrows) {
+    const std::string code = R"(
+        def divide(a: int, b: int) -> int {
+            return a / b;
+        }
+        var i: int = 20;
+        while (i > -1) {
+            println(divide(100, i));
+            i = i - 1;
+        }
+    )";
+    try {
+        runTreeWalker(code, true);
+        FAIL() << "Expected ZynkError thrown.";
+    } catch (const ZynkError& error) {
+        EXPECT_EQ(error.base_type, ZynkErrorType::RuntimeError);
+    }
+    try {
+        runVm(code, true);
+        FAIL() << "Expected ZynkError thrown.";
+    } catch (const ZynkError& error) {
+        EXPECT_EQ(error.base_type, ZynkErrorType::RuntimeError);
+    }
+}
+
+TEST(JitTest, RecursionLimitStillApplies) {
+    const std::string code = R"(
+        def sum(n: int) -> int {
+            if (n == 0) {
+                return 0;
+            }
+            return n + sum(n - 1);
+        }
+        println(sum(998));
+        println(sum(5000));
+    )";
+    try {
+        runTreeWalker(code, true);
+        FAIL() << "Expected ZynkError thrown.";
+    } catch (const ZynkError& error) {
+        EXPECT_EQ(error.base_type, ZynkErrorType::RecursionError);
+    }
+    try {
+        runVm(code, true);
+        FAIL() << "Expected ZynkError thrown.";
+    } catch (const ZynkError& error) {
+        EXPECT_EQ(error.base_type, ZynkErrorType::RecursionError);
+    }
+}
+
+#ifdef ZYNK_JIT_SUPPORTED
+// Declares the variables of the program before its loop, the way the interpreter would.
+static const ASTWhile& prepareLoop(const ASTProgram& program, RuntimeEnvironment& env) {
+    env.enterProgram(program.frameSize);
+    for (const std::unique_ptr<ASTBase>& statement : program.body) {
+        if (statement->type == ASTType::While) return static_cast<const ASTWhile&>(*statement);
+
+        const auto& declaration = static_cast<const ASTVariableDeclaration&>(*statement);
+        const Value& value = static_cast<const ASTValue*>(declaration.value.get())->constant;
+        env.declareVariable(declaration.name, declaration.slot, declaration.varType, value, declaration.line);
+    }
+    throw std::logic_error("No loop in the program.");
+}
+
+static Value variableValue(const ASTProgram& program, RuntimeEnvironment& env, size_t index) {
+    ASTBinding binding;
+    binding.slot = static_cast<const ASTVariableDeclaration&>(*program.body[index]).slot;
+    return env.findVariable(binding)->value;
+}
+
+TEST(TracerTest, RunsHotLoopToTheEnd) {
+    auto program = parseSource(R"(
+        var i: int = 0;
+        var total: int = 0;
+        while (i < 100) {
+            total = total + i;
+            i = i + 1;
+        }
+    )");
+    RuntimeEnvironment env;
+    const ASTWhile& loop = prepareLoop(*program, env);
+
+    Tracer tracer(1);
+    EXPECT_EQ(tracer.run(loop, env), Tracer::Result::RunIteration);
+    EXPECT_TRUE(tracer.isTraced(loop));
+    EXPECT_EQ(variableValue(*program, env, 0).asInt(), 0);
+
+    EXPECT_EQ(tracer.run(loop, env), Tracer::Result::LoopEnded);
+    EXPECT_EQ(variableValue(*program, env, 0).asInt(), 100);
+    EXPECT_EQ(variableValue(*program, env, 1).asInt(), 4950);
+}
+
+TEST(TracerTest, SideExitKeepsCompletedIterations) {
+    auto program = parseSource(R"(
+        var i: int = 0;
+        var total: int = 0;
+        while (i < 100) {
+            if (i == 50) {
+                total = total + 1000;
+            }
+            total = total + i;
+            i = i + 1;
+        }
+    )");
+    RuntimeEnvironment env;
+    const ASTWhile& loop = prepareLoop(*program, env);
+
+    Tracer tracer(1);
+    EXPECT_EQ(tracer.run(loop, env), Tracer::Result::RunIteration);
+    EXPECT_EQ(tracer.run(loop, env), Tracer::Result::RunIteration);
+    EXPECT_EQ(variableValue(*program, env, 0).asInt(), 50);
+    EXPECT_EQ(variableValue(*program, env, 1).asInt(), 1225);
+}
+
+TEST(TracerTest, LeavingConditionChecksItAgain) {
+    auto program = parseSource(R"(
+        var x: float = 100.0;
+        var steps: int = 0;
+        while ((x > 1.0) and (steps < 1000)) {
+            x = x / 1.5;
+            steps = steps + 1;
+        }
+    )");
+    RuntimeEnvironment env;
+    const ASTWhile& loop = prepareLoop(*program, env);
+
+    Tracer tracer(1);
+    EXPECT_EQ(tracer.run(loop, env), Tracer::Result::RunIteration);
+    // The trace leaves on the left operand, which decides the condition is false.
+    EXPECT_EQ(tracer.run(loop, env), Tracer::Result::CheckCondition);
+    EXPECT_EQ(variableValue(*program, env, 1).asInt(), 12);
+}
+
+TEST(TracerTest, SkipsLoopsWithSideEffects) {
+    auto program = parseSource(R"(
+        var i: int = 0;
+        while (i < 100) {
+            println(i);
+            i = i + 1;
+        }
+    )");
+    RuntimeEnvironment env;
+    const ASTWhile& loop = prepareLoop(*program, env);
+
+    Tracer tracer(1);
+    EXPECT_EQ(tracer.run(loop, env), Tracer::Result::RunIteration);
+    EXPECT_FALSE(tracer.isTraced(loop));
+}
+#endif
+
+TEST(TracerTest, InlinedCallsMatchInterpreter) {
+    const std::string code = R"(
+        var counter: int = 0;
+        def bump(by: int) -> null {
+            counter = counter + by;
+        }
+        def clamp(x: float, limit: float) -> float {
+            if (x > limit) {
+                return limit;
+            }
+            return x;
+        }
+        def sumTo(n: int) -> int {
+            var total: int = 0;
+            var k: int = 0;
+            while (k < n) {
+                k = k + 1;
+                if (k / 3 * 3 == k) {
+                    var bonus: int = 2;
+                    total = total + bonus;
+                }
+                total = total + k;
+                bump(1);
+            }
+            return total;
+        }
+        var i: int = 0;
+        var acc: int = 0;
+        var f: float = 0.0;
+        while (i < 200) {
+            acc = acc + sumTo(i);
+            f = clamp(f + float(i) / 7.0, 500.0);
+            i = i + 1;
+        }
+        println(f"{acc} {counter} {f}");
+    )";
+    EXPECT_EQ(runTreeWalker(code, true), runTreeWalker(code, false));
+    EXPECT_EQ(runClosures(code, true), runTreeWalker(code, false));
+}
+
+TEST(TracerTest, ErrorsInTracedLoopStillThrow) {
+    const std::string code = R"(
+        var d: int = 50;
+        var q: int = 0;
+        while (true) {
+            q = q + 1000 / d;
+            d = d - 1;
+        }
+    )";
+    std::optional<size_t> line;
+    try {
+        runTreeWalker(code, false);
+        FAIL() << "Expected ZynkError thrown.";
+    } catch (const ZynkError& error) {
+        line = error.line;
+    }
+    try {
+        runTreeWalker(code, true);
+        FAIL() << "Expected ZynkError thrown.";
+    } catch (const ZynkError& error) {
+        EXPECT_EQ(error.base_type, ZynkErrorType::RuntimeError);
+        EXPECT_EQ(error.line, line);
+    }
+}
@@ -0,0 +1,737 @@
+#include <gtest/gtest.h>
+
+#include "../src/execution/optimizer/include/optimizer.hpp"
+#include "../src/execution/optimizer/include/folder.hpp"
+#include "../src/execution/optimizer/include/eliminator.hpp"
+#include "../src/execution/optimizer/include/hoister.hpp"
+#include "../src/execution/optimizer/include/recognizer.hpp"
+#include "../src/execution/optimizer/include/inliner.hpp"
+#include "../src/execution/include/evaluator.hpp"
+#include "../src/parsing/include/printer.hpp"
+#include "../src/errors/include/errors.hpp"
+#include "helpers.hpp"
+
+// Runs a single pass over the program and prints the result.
+template <typename Pass>
+static std::string runPass(const std::string& code, OptimizerStatistics* statistics, void (Pass::*run)(ASTProgram&)) {
+    auto program = parseSource(code);
+    OptimizerStatistics passStatistics;
+    Pass pass(passStatistics);
+    (pass.*run)(*program);
+    if (statistics != nullptr) *statistics = passStatistics;
+    return ASTPrinter().print(*program);
+}
+
+static std::string fold(const std::string& code, OptimizerStatistics* statistics = nullptr) {
+    return runPass(code, statistics, &ConstantFolder::fold);
+}
+
+static std::string eliminate(const std::string& code, OptimizerStatistics* statistics = nullptr) {
+    return runPass(code, statistics, &DeadCodeEliminator::eliminate);
+}
+
+static std::string hoist(const std::string& code, OptimizerStatistics* statistics = nullptr) {
+    return runPass(code, statistics, &InvariantHoister::hoist);
+}
+
+static std::string recognize(const std::string& code, OptimizerStatistics* statistics = nullptr) {
+    return runPass(code, statistics, &CountedLoopRecognizer::recognize);
+}
+
+static std::string inlineCalls(const std::string& code, OptimizerStatistics* statistics = nullptr, size_t budget = DEFAULT_INLINE_BUDGET) {
+    auto program = parseSource(code);
+    OptimizerStatistics passStatistics;
+    FunctionInliner(passStatistics, budget).inlineCalls(*program);
+    if (statistics != nullptr) *statistics = passStatistics;
+    return ASTPrinter().print(*program);
+}
+
+static std::string optimize(const std::string& code, OptimizerStatistics* statistics = nullptr) {
+    auto program = parseSource(code);
+    Optimizer optimizer;
+    optimizer.optimize(*program);
+    if (statistics != nullptr) *statistics = optimizer.statistics;
+    return ASTPrinter().print(*program);
+}
+
+static std::string run(ASTProgram& program) {
+    testing::internal::CaptureStdout();
+    try {
+        Evaluator().evaluate(program);
+    } catch (const ZynkError& error) {
+        return testing::internal::GetCapturedStdout() + "error: " + error.what() + " at " + std::to_string(*error.line);
+    }
+    return testing::internal::GetCapturedStdout();
+}
+
+// Runs the program before and after optimization, the output has to stay the same.
+static void expectSameOutput(const std::string& code) {
+    auto original = parseSource(code);
+    auto optimized = parseSource(code);
+    Optimizer().optimize(*optimized);
+
+    EXPECT_EQ(run(*optimized), run(*original));
+}
+
+TEST(ConstantFolderTest, FoldsArithmetic) {
+    OptimizerStatistics statistics;
+    EXPECT_EQ(fold("println(60 * 60 * 24);", &statistics), "println(86400);\n");
+    EXPECT_EQ(statistics.foldedExpressions, 2u);
+
+    EXPECT_EQ(fold("println(float(3) / 2.0);"), "println(1.5);\n");
+    EXPECT_EQ(fold("println(string(4) == \"4\");"), "println(true);\n");
+}
+
+TEST(ConstantFolderTest, FoldsLogicalOperations) {
+    EXPECT_EQ(fold("var b: bool = true; println((1 > 2) or b);"), "var b: bool = true;\nprintln(true);\n");
+    EXPECT_EQ(fold("def f() -> bool { println(1); return true; } println(true and f());"),
+        "def f() -> bool {\n    println(1);\n    return true;\n}\nprintln(f());\n");
+    EXPECT_EQ(fold("def f() -> bool { return true; } println(false and f());"),
+        "def f() -> bool {\n    return true;\n}\nprintln(false);\n");
+}
+
+TEST(ConstantFolderTest, KeepsOperationsThatFail) {
+    EXPECT_EQ(fold("println(10 / (5 - 5));"), "println(10 / 0);\n");
+    EXPECT_EQ(fold("println(int(\"abc\"));"), "println(int(\"abc\"));\n");
+    expectSameOutput("println(1);\nprintln(10 / (5 - 5));");
+}
+
+TEST(ConstantFolderTest, PropagatesVariablesNeverReassigned) {
+    OptimizerStatistics statistics;
+    const std::string optimized = fold(R"(
+        var limit: int = 10 * 10;
+        var step: int = 1;
+        var i: int = 0;
+        while (i < limit) {
+            i = i + step;
+        }
+    )", &statistics);
+
+    EXPECT_NE(optimized.find("while (i < 100) {\n    i = i + 1;\n}"), std::string::npos);
+    EXPECT_EQ(statistics.propagatedConstants, 2u);
+}
+
+TEST(ConstantFolderTest, DoesNotPropagateAcrossFunctions) {
+    // The function may run before the variable is declared.
+    const std::string code = R"(
+        def show() -> null {
+            println(x);
+        }
+        var x: int = 3;
+        show();
+    )";
+
+    EXPECT_NE(fold(code).find("println(x);"), std::string::npos);
+    expectSameOutput(code);
+}
+
+TEST(ConstantFolderTest, DoesNotPropagateRedeclaredVariables) {
+    const std::string code = R"(
+        var x: int = 3;
+        if (x > 1) {
+            var x: int = 4;
+            println(x);
+        }
+        println(x);
+    )";
+
+    EXPECT_EQ(fold(code).find("println(3)"), std::string::npos);
+    expectSameOutput(code);
+}
+
+TEST(ConstantFolderTest, PrunesConstantBranches) {
+    OptimizerStatistics statistics;
+    const std::string optimized = fold(R"(
+        var debug: bool = false;
+        if (debug) {
+            println("debug");
+        } else {
+            println("release");
+        }
+        while (debug) {
+            println("never");
+        }
+    )", &statistics);
+
+    EXPECT_EQ(optimized, "var debug: bool = false;\nprintln(\"release\");\n");
+    EXPECT_EQ(statistics.prunedBranches, 2u);
+}
+
+TEST(ConstantFolderTest, KeepsBlockOfBranchWithDeclarations) {
+    const std::string code = R"(
+        var x: int = 1;
+        if (true) {
+            var y: int = 2;
+            println(y);
+        } else {
+            println("never");
+        }
+        var y: string = "outer";
+        println(y);
+    )";
+
+    EXPECT_EQ(fold(code), "var x: int = 1;\nif (true) {\n    var y: int = 2;\n    println(y);\n}\nvar y: string = \"outer\";\nprintln(y);\n");
+    expectSameOutput(code);
+}
+
+TEST(ConstantFolderTest, KeepsErrorLines) {
+    const std::string code = "var zero: int = 0;\nvar x: int = 5;\nprintln(x / zero);\n";
+    auto program = parseSource(code);
+    Optimizer().optimize(*program);
+
+    EXPECT_EQ(run(*program), "error: Division by zero. at 3");
+}
+
+TEST(ConstantFolderTest, EvaluatesCallsOfPureFunctions) {
+    const std::string code = R"(
+        def pow2(n: int) -> int {
+            var result: int = 1;
+            var i: int = 0;
+            while (i < n) {
+                result = result * 2;
+                i = i + 1;
+            }
+            return result;
+        }
+        var limit: int = pow2(20);
+        println(limit);
+        println(f"{pow2(3)} {pow2(3) > 7}");
+    )";
+
+    OptimizerStatistics statistics;
+    const std::string folded = fold(code, &statistics);
+    EXPECT_NE(folded.find("println(1048576);\nprintln(f\"{8} {true}\");\n"), std::string::npos);
+    EXPECT_EQ(statistics.pureFunctions, 1u);
+    EXPECT_EQ(statistics.evaluatedCalls, 3u);
+    expectSameOutput(code);
+}
+
+TEST(ConstantFolderTest, KeepsCallsThatCantBeEvaluated) {
+    // Calls with effects, with variable arguments, running out of steps, failing, or of functions
+    // not declared yet are left to the runtime.
+    const std::string code = R"(
+        def loud(n: int) -> int {
+            println(n);
+            return n;
+        }
+        def spin(n: int) -> int {
+            var i: int = 0;
+            while (i < n) {
+                i = i + 1;
+            }
+            return i;
+        }
+        def early() -> int {
+            return later();
+        }
+        def later() -> int {
+            return 1;
+        }
+        def half(n: int) -> int {
+            return 10 / n;
+        }
+        var n: int = int("4");
+        println(loud(1));
+        println(half(n));
+        println(spin(100000));
+        println(early());
+        println(half(0));
+    )";
+
+    OptimizerStatistics statistics;
+    const std::string folded = fold(code, &statistics);
+    EXPECT_NE(folded.find("return later();"), std::string::npos);
+    EXPECT_NE(
+        folded.find("println(loud(1));\nprintln(half(n));\nprintln(spin(100000));\nprintln(1);\nprintln(half(0));\n"),
+        std::string::npos
+    );
+    EXPECT_EQ(statistics.pureFunctions, 4u);
+    EXPECT_EQ(statistics.evaluatedCalls, 1u);
+    expectSameOutput(code);
+}
+
+TEST(DeadCodeEliminatorTest, RemovesStatementsAfterReturn) {
+    OptimizerStatistics statistics;
+    const std::string eliminated = eliminate(R"(
+        def f(x: int) -> int {
+            if (x > 0) {
+                return 1;
+                println("after");
+            } else {
+                return 2;
+            }
+            println(x + 1);
+            def g() -> int {
+                return 3;
+            }
+        }
+    )", &statistics);
+
+    EXPECT_EQ(
+        eliminated,
+        "def f(x: int) -> int {\n    if (x > 0) {\n        return 1;\n    } else {\n        return 2;\n    }\n"
+        "    def g() -> int {\n        return 3;\n    }\n}\n"
+    );
+    EXPECT_EQ(statistics.unreachableStatements, 2u);
+    EXPECT_EQ(statistics.removedNodes, 6u);
+}
+
+TEST(DeadCodeEliminatorTest, RemovesStatementsAfterBreak) {
+    const std::string code = R"(
+        var i: int = 0;
+        while (true) {
+            i = i + 1;
+            if (i > 3) {
+                break;
+                i = 100;
+            }
+        }
+        println(i);
+    )";
+
+    EXPECT_EQ(eliminate(code).find("i = 100;"), std::string::npos);
+    expectSameOutput(code);
+}
+
+TEST(DeadCodeEliminatorTest, RemovesUnusedDeclarations) {
+    OptimizerStatistics statistics;
+    const std::string eliminated = eliminate(R"(
+        var a: float = 1.5;
+        var b: float = a * 2.0;
+        var c: bool = (a > 1.0) and true;
+        println("done");
+    )", &statistics);
+
+    EXPECT_EQ(eliminated, "println(\"done\");\n");
+    EXPECT_EQ(statistics.unusedDeclarations, 3u);
+}
+
+TEST(DeadCodeEliminatorTest, KeepsDeclarationsThatMayFail) {
+    const std::string code = R"(
+        var zero: int = 0;
+        var ratio: int = 10 / zero;
+        var total: int = 9223372036854775807 + 1;
+        var parsed: int = int("abc");
+        var line: string = readInput();
+        def f() -> int {
+            return 1;
+        }
+        var result: int = f();
+    )";
+
+    const std::string eliminated = eliminate(code);
+    for (const char* name : { "ratio", "total", "parsed", "line", "result" }) {
+        EXPECT_NE(eliminated.find(std::string("var ") + name), std::string::npos) << name;
+    }
+}
+
+TEST(DeadCodeEliminatorTest, KeepsCastsOutOfTheIntRange) {
+    const std::string code = R"(
+        var big: float = 10000000000.0 * 10000000000.0 * 1000000000.0;
+        var unused: int = int(big);
+        println("after");
+    )";
+
+    EXPECT_NE(eliminate(code).find("var unused: int = int(big);"), std::string::npos);
+    expectSameOutput(code);
+}
+
+TEST(DeadCodeEliminatorTest, KeepsArithmeticOnVariablesWithoutValue) {
+    // The variable holds null, which arithmetic rejects.
+    const std::string code = R"(
+        var x: float;
+        var unused: float = x + 1.0;
+        println("after");
+    )";
+
+    EXPECT_NE(eliminate(code).find("var unused: float = x + 1.0;"), std::string::npos);
+    expectSameOutput(code);
+}
+
+TEST(DeadCodeEliminatorTest, KeepsDeclarationsInLoops) {
+    // The declaration fails on the second iteration.
+    const std::string code = R"(
+        var i: int = 0;
+        while (i < 2) {
+            var unused: int = 1;
+            i = i + 1;
+        }
+    )";
+
+    EXPECT_NE(eliminate(code).find("var unused"), std::string::npos);
+    expectSameOutput(code);
+}
+
+TEST(DeadCodeEliminatorTest, RemovesEmptyBranches) {
+    OptimizerStatistics statistics;
+    const std::string eliminated = eliminate(R"(
+        var x: int = 3;
+        if (x > 1) {
+            var y: int = 2;
+        } else {
+        }
+        println(x);
+    )", &statistics);
+
+    EXPECT_EQ(eliminated, "var x: int = 3;\nprintln(x);\n");
+    EXPECT_EQ(statistics.emptyBranches, 1u);
+}
+
+TEST(InvariantHoisterTest, HoistsFromCondition) {
+    OptimizerStatistics statistics;
+    const std::string code = R"(
+        var n: int = int("4");
+        var i: int = 0;
+        while (i < (n * 2)) {
+            i = i + 1;
+        }
+        println(i);
+    )";
+
+    EXPECT_EQ(
+        hoist(code, &statistics),
+        "var n: int = int(\"4\");\nvar i: int = 0;\nvar __invariant0: int = n * 2;\n"
+        "while (i < __invariant0) {\n    i = i + 1;\n}\nprintln(i);\n"
+    );
+    EXPECT_EQ(statistics.hoistedExpressions, 1u);
+    EXPECT_EQ(statistics.hoistedLoops, 1u);
+    expectSameOutput(code);
+}
+
+TEST(InvariantHoisterTest, HoistsSafeExpressionsFromBody) {
+    const std::string hoisted = hoist(R"(
+        var f: float = float(readInput());
+        var i: int = 0;
+        var total: float = 0.0;
+        while (i < 10) {
+            if (i > 5) {
+                total = total + (f * 2.0);
+            }
+            i = i + 1;
+        }
+    )");
+
+    EXPECT_NE(hoisted.find("var __invariant0: float = f * 2.0;\nwhile (i < 10) {"), std::string::npos);
+}
+
+TEST(InvariantHoisterTest, GuardsCallsWithCondition) {
+    const std::string code = R"(
+        def square(x: int) -> int {
+            return x * x;
+        }
+        var n: int = 3;
+        var i: int = 0;
+        var total: int = 0;
+        while (i < 4) {
+            total = total + square(n);
+            i = i + 1;
+        }
+        println(total);
+    )";
+
+    EXPECT_NE(
+        hoist(code).find("if (i < 4) {\n    var __invariant0: int = square(n);\n    while (i < 4) {\n        total = total + __invariant0;"),
+        std::string::npos
+    );
+    expectSameOutput(code);
+}
+
+TEST(InvariantHoisterTest, KeepsExpressionsThatMayFailAfterEffects) {
+    const std::string code = R"(
+        var zero: int = 0;
+        var i: int = 0;
+        while (i < 3) {
+            println(i);
+            i = i + (10 / zero);
+        }
+    )";
+
+    EXPECT_EQ(hoist(code).find("__invariant"), std::string::npos);
+    expectSameOutput(code);
+}
+
+TEST(InvariantHoisterTest, GuardsCastsThatMayFail) {
+    // Converting a float outside of the int64 range fails, but the loop never runs.
+    const std::string code = R"(
+        var big: float = 10000000000.0 * 10000000000.0 * 1000000000.0;
+        var i: int = 0;
+        var r: int = 0;
+        while (i < 0) {
+            r = int(big);
+            i = i + 1;
+        }
+        println("done");
+    )";
+
+    EXPECT_NE(hoist(code).find("if (i < 0) {\n    var __invariant0: int = int(big);"), std::string::npos);
+    expectSameOutput(code);
+}
+
+TEST(InvariantHoisterTest, KeepsExpressionsOfAssignedVariables) {
+    const std::string code = R"(
+        var n: int = 2;
+        var g: int = 0;
+        def bump() -> int {
+            n = n + 1;
+            return n;
+        }
+        var i: int = 0;
+        while (i < (10 - n)) {
+            g = g + bump();
+            i = i + 1;
+        }
+        var j: int = 0;
+        while (j < (g * 2)) {
+            g = g - 1;
+            j = j + 1;
+        }
+        println(f"{i} {j} {g}");
+    )";
+
+    EXPECT_EQ(hoist(code).find("__invariant"), std::string::npos);
+    expectSameOutput(code);
+}
+
+TEST(InvariantHoisterTest, GivesNestedLoopsTheirOwnBlock) {
+    // The temporaries of the inner loop are declared on every iteration of the outer one.
+    const std::string code = R"(
+        var n: int = int("3");
+        var i: int = 0;
+        var j: int = 0;
+        var total: int = 0;
+        while (i < n) {
+            j = 0;
+            while (j < (i * 2)) {
+                total = total + j;
+                j = j + 1;
+            }
+            i = i + 1;
+        }
+        println(total);
+    )";
+
+    EXPECT_NE(hoist(code).find("if (true) {\n        var __invariant0: int = i * 2;"), std::string::npos);
+    expectSameOutput(code);
+}
+
+TEST(CountedLoopRecognizerTest, RecognizesCountedLoops) {
+    const std::string code = R"(
+        var n: int = int("4");
+        var i: int = 0;
+        var total: int = 0;
+        while (i < n) {
+            total = total + i;
+            i = i + 1;
+        }
+        var j: int = 10;
+        while (j >= 0) {
+            if (j == 4) {
+                break;
+            }
+            print(j);
+            j = j - 3;
+        }
+        def first(limit: int) -> int {
+            var k: int = 0;
+            while (k <= limit) {
+                if ((k * k) > 20) {
+                    return k;
+                }
+                k = 2 + k;
+            }
+            return -1;
+        }
+        println(f" {i} {total} {j} {first(10)} {first(2)}");
+    )";
+
+    OptimizerStatistics statistics;
+    recognize(code, &statistics);
+    EXPECT_EQ(statistics.countedLoops, 3u);
+    expectSameOutput(code);
+}
+
+TEST(CountedLoopRecognizerTest, SkipsLoopsAssigningCounterOrBound) {
+    const std::string code = R"(
+        var n: int = 6;
+        var i: int = 0;
+        while (i < n) {
+            i = i + 1;
+            i = i + 1;
+        }
+        var j: int = 0;
+        while (j < n) {
+            n = n - 1;
+            j = j + 1;
+        }
+        def bump() -> int {
+            n = n + 1;
+            return n;
+        }
+        var k: int = 0;
+        while (k < 3) {
+            println(bump());
+            k = k + 1;
+        }
+        var m: int = 0;
+        while (m < 8) {
+            m = m + 1;
+            println(m);
+        }
+        var x: float = 0.0;
+        while (x < 2.0) {
+            x = x + 1.0;
+        }
+        println(f"{i} {j} {n} {m} {x}");
+    )";
+
+    OptimizerStatistics statistics;
+    recognize(code, &statistics);
+    EXPECT_EQ(statistics.countedLoops, 0u);
+    expectSameOutput(code);
+}
+
+TEST(CountedLoopRecognizerTest, KeepsErrorsOfTheCounter) {
+    // Overflows are reported at the step, and a counter without an int runs the generic loop.
+    const std::string code = R"(
+        var empty: int;
+        while (empty < 3) {
+            println("never");
+            empty = empty + 1;
+        }
+        var big: int = 9223372036854775800;
+        while (big > 0) {
+            println(big);
+            big = big + 3;
+        }
+    )";
+
+    auto program = parseSource(code);
+    Optimizer optimizer;
+    optimizer.optimize(*program);
+    EXPECT_EQ(optimizer.statistics.countedLoops, 2u);
+    EXPECT_EQ(run(*program), "9223372036854775800\n9223372036854775803\n9223372036854775806\nerror: Integer overflow in '+' operation. at 9");
+    expectSameOutput(code);
+}
+
+TEST(FunctionInlinerTest, InlinesSmallFunctions) {
+    const std::string code = R"(
+        def sq(x: int) -> int {
+            return x * x;
+        }
+        def hyp(a: float, b: float) -> float {
+            return (a * a) + (b * b);
+        }
+        var n: int = int("7");
+        println(sq(n));
+        println(sq(sq(n)));
+        println(hyp(3.0, 4.0));
+    )";
+
+    // The argument of the outer call would be evaluated twice.
+    OptimizerStatistics statistics;
+    const std::string inlined = inlineCalls(code, &statistics);
+    EXPECT_NE(inlined.find("println(n * n);\nprintln(sq(n * n));\nprintln((3.0 * 3.0) + (4.0 * 4.0));\n"), std::string::npos);
+    EXPECT_EQ(statistics.inlinedCalls, 3u);
+    EXPECT_EQ(statistics.inlinedFunctions, 2u);
+    expectSameOutput(code);
+}
+
+TEST(FunctionInlinerTest, KeepsArgumentsEvaluatedInOrder) {
+    // Arguments with effects are inlined only where the body evaluates them once, in order, before anything else.
+    const std::string code = R"(
+        var counter: int = 0;
+        def next() -> int {
+            counter = counter + 1;
+            println(f"next {counter}");
+            return counter;
+        }
+        def difference(a: int, b: int) -> int {
+            return a - b;
+        }
+        def reversed(a: int, b: int) -> int {
+            return b - a;
+        }
+        def sq(x: int) -> int {
+            return x * x;
+        }
+        def both(a: bool, b: bool) -> bool {
+            return a and b;
+        }
+        println(difference(next(), next()));
+        println(reversed(next(), next()));
+        println(sq(next()));
+        println(both(false, (next() > 0)));
+    )";
+
+    const std::string inlined = inlineCalls(code);
+    EXPECT_NE(inlined.find("println(next() - next());"), std::string::npos);
+    EXPECT_NE(inlined.find("println(reversed(next(), next()));"), std::string::npos);
+    EXPECT_NE(inlined.find("println(sq(next()));"), std::string::npos);
+    EXPECT_NE(inlined.find("println(both(false, next() > 0));"), std::string::npos);
+    expectSameOutput(code);
+}
+
+TEST(FunctionInlinerTest, SkipsRecursiveLargeAndUndeclaredFunctions) {
+    const std::string code = R"(
+        def fact(n: int) -> int {
+            return int((n < 2)) + (n * fact(n - 1));
+        }
+        def big(x: int) -> int {
+            return ((x + 1) * (x + 2)) + ((x + 3) * (x + 4));
+        }
+        def scaled(x: int) -> int {
+            return x * factor;
+        }
+        var factor: int = 3;
+        println(big(1));
+        println(scaled(2));
+    )";
+
+    OptimizerStatistics statistics;
+    inlineCalls(code, &statistics, 8);
+    EXPECT_EQ(statistics.inlinedCalls, 0u);
+    inlineCalls(code, &statistics, 16);
+    EXPECT_EQ(statistics.inlinedCalls, 1u);
+    expectSameOutput(code);
+}
+
+TEST(FunctionInlinerTest, KeepsErrorLinesOfTheBody) {
+    const std::string code = R"(
+        def div(a: int, b: int) -> int {
+            return a / b;
+        }
+        var zero: int = int("0");
+        println(div(10, 5));
+        println(div(1, zero));
+    )";
+
+    auto program = parseSource(code);
+    Optimizer optimizer;
+    optimizer.optimize(*program);
+    EXPECT_EQ(optimizer.statistics.inlinedCalls, 2u);
+    EXPECT_EQ(run(*program), "2\nerror: Division by zero. at 2");
+    expectSameOutput(code);
+}
+
+TEST(OptimizerTest, SummarizesStatistics) {
+    OptimizerStatistics statistics;
+    optimize("var x: int = 2 + 2; if (x > 3) println(x);", &statistics);
+
+    const std::string summary = statistics.summary();
+    EXPECT_EQ(summary.rfind("Constant folding: 2 expressions folded, 2 constants propagated, 1 branches pruned.\n", 0), 0u);
+    EXPECT_NE(
+        summary.find("Dead code elimination: 0 unreachable statements, 1 unused declarations, 0 empty branches removed (2 nodes).\n"),
+        std::string::npos
+    );
+}
+
+TEST(OptimizerTest, RemovesPropagatedConstants) {
+    const std::string code = R"(
+        var secondsPerDay: int = 60 * 60 * 24;
+        var days: int = 3;
+        println(secondsPerDay * days);
+    )";
+
+    EXPECT_EQ(optimize(code), "println(259200);\n");
+    expectSameOutput(code);
+}
@@ -87,7 +87,7 @@ TEST(ParserTest, parseFunctionDeclarationWithReturnType) {
 
     const auto returnValue = static_cast<ASTBinaryOperation*>(returnStmt->value.get());
     ASSERT_NE(returnValue, nullptr);
-    ASSERT_EQ(returnValue->op, "+");
+    ASSERT_EQ(returnValue->op, ASTBinaryOperator::Add);
 
     const auto left = static_cast<ASTVariable*>(returnValue->left.get());
     const auto right = static_cast<ASTVariable*>(returnValue->right.get());
@@ -130,7 +130,7 @@ TEST(ParserTest, parseVariableDeclarationWithBinaryOperation) {
 
     const auto operation = static_cast<ASTBinaryOperation*>(var->value.get());
     ASSERT_NE(operation, nullptr);
-    ASSERT_EQ(operation->op, "+");
+    ASSERT_EQ(operation->op, ASTBinaryOperator::Add);
 
     const auto left = static_cast<ASTVariable*>(operation->left.get());
     const auto right = static_cast<ASTValue*>(operation->right.get());
@@ -157,7 +157,7 @@ TEST(ParserTest, parseVariableDeclarationWithComplexExpression) {
 
     const auto operation = static_cast<ASTBinaryOperation*>(var->value.get());
     ASSERT_NE(operation, nullptr);
-    ASSERT_EQ(operation->op, "+");
+    ASSERT_EQ(operation->op, ASTBinaryOperator::Add);
 
     const auto leftValue = static_cast<ASTValue*>(operation->left.get());
     const auto rightOperation = static_cast<ASTBinaryOperation*>(operation->right.get());
@@ -165,7 +165,7 @@ TEST(ParserTest, parseVariableDeclarationWithComplexExpression) {
     ASSERT_NE(leftValue, nullptr);
     ASSERT_NE(rightOperation, nullptr);
     ASSERT_EQ(leftValue->value, "1");
-    ASSERT_EQ(rightOperation->op, "*");
+    ASSERT_EQ(rightOperation->op, ASTBinaryOperator::Multiply);
 
     const auto rightLeftValue = static_cast<ASTValue*>(rightOperation->left.get());
     const auto rightRightVariable = static_cast<ASTVariable*>(rightOperation->right.get());
@@ -230,7 +230,7 @@ TEST(ParserTest, parseVariableModifyWithExpression) {
 
     const auto operation = static_cast<ASTBinaryOperation*>(varModify->value.get());
     ASSERT_NE(operation, nullptr);
-    ASSERT_EQ(operation->op, "+");
+    ASSERT_EQ(operation->op, ASTBinaryOperator::Add);
 
     const auto leftValue = static_cast<ASTValue*>(operation->left.get());
     const auto rightOperation = static_cast<ASTBinaryOperation*>(operation->right.get());
@@ -238,7 +238,7 @@ TEST(ParserTest, parseVariableModifyWithExpression) {
     ASSERT_NE(leftValue, nullptr);
     ASSERT_NE(rightOperation, nullptr);
     ASSERT_EQ(leftValue->value, "5");
-    ASSERT_EQ(rightOperation->op, "*");
+    ASSERT_EQ(rightOperation->op, ASTBinaryOperator::Multiply);
 
     const auto rightLeftVariable = static_cast<ASTVariable*>(rightOperation->left.get());
     const auto rightRightValue = static_cast<ASTValue*>(rightOperation->right.get());
@@ -261,11 +261,11 @@ TEST(ParserTest, parseSimpleIfStatement) {
     ASSERT_EQ(program->body.front()->type, ASTType::Condition);
 
     const auto condition = static_cast<ASTCondition*>(program->body.front().get());
-    const auto conditionExpression = static_cast<ASTBinaryOperation*>(condition->expression.get());
+    const auto conditionExpression = static_cast<ASTComparisonOperation*>(condition->expression.get());
 
     ASSERT_NE(condition, nullptr);
     ASSERT_EQ(condition->body.size(), 1);
-    ASSERT_EQ(conditionExpression->op, ">");
+    ASSERT_EQ(conditionExpression->op, ASTComparisonOperator::Greater);
 
     const auto printStatement = static_cast<ASTPrint*>(condition->body.front().get());
     const auto printValue = static_cast<ASTValue*>(printStatement->expression.get());
@@ -286,10 +286,10 @@ TEST(ParserTest, parseIfElseStatement) {
     ASSERT_EQ(program->body.front()->type, ASTType::Condition);
 
     const auto condition = static_cast<ASTCondition*>(program->body.front().get());
-    const auto conditionExpression = static_cast<ASTBinaryOperation*>(condition->expression.get());
+    const auto conditionExpression = static_cast<ASTComparisonOperation*>(condition->expression.get());
 
     ASSERT_NE(condition, nullptr);
-    ASSERT_EQ(conditionExpression->op, "==");
+    ASSERT_EQ(conditionExpression->op, ASTComparisonOperator::Equal);
 
     ASSERT_EQ(condition->body.size(), 1);
     const auto ifPrint = static_cast<ASTPrint*>(condition->body.front().get());
@@ -472,7 +472,7 @@ TEST(ParserTest, parseBinaryOperationWithNegativeNumber) {
 
     const auto binOp = static_cast<ASTBinaryOperation*>(var->value.get());
     ASSERT_NE(binOp, nullptr);
-    ASSERT_EQ(binOp->op, "+");
+    ASSERT_EQ(binOp->op, ASTBinaryOperator::Add);
 
     const auto leftValue = static_cast<ASTValue*>(binOp->left.get());
     ASSERT_NE(leftValue, nullptr);
@@ -554,11 +554,11 @@ TEST(ParserTest, parsePrintExpressionWithParentheses) {
     ASSERT_TRUE(printStmt);
 
     const auto operation = static_cast<ASTBinaryOperation*>(printStmt->expression.get());
-    ASSERT_EQ(operation->op, "*");
+    ASSERT_EQ(operation->op, ASTBinaryOperator::Multiply);
 
     const auto leftExpr = static_cast<ASTBinaryOperation*>(operation->left.get());
     ASSERT_NE(leftExpr, nullptr);
-    ASSERT_EQ(leftExpr->op, "+");
+    ASSERT_EQ(leftExpr->op, ASTBinaryOperator::Add);
 
     const auto rightExpr = static_cast<ASTValue*>(leftExpr->right.get());
     ASSERT_NE(rightExpr, nullptr);
@@ -588,15 +588,15 @@ TEST(ParserTest, parsePrintNestedParentheses) {
     ASSERT_TRUE(printStmt);
 
     const auto operation = static_cast<ASTBinaryOperation*>(printStmt->expression.get());
-    ASSERT_EQ(operation->op, "*");
+    ASSERT_EQ(operation->op, ASTBinaryOperator::Multiply);
 
     const auto leftExpr = static_cast<ASTBinaryOperation*>(operation->left.get());
     ASSERT_NE(leftExpr, nullptr);
-    ASSERT_EQ(leftExpr->op, "+");
+    ASSERT_EQ(leftExpr->op, ASTBinaryOperator::Add);
 
     const auto rightExpr = static_cast<ASTBinaryOperation*>(operation->right.get());
     ASSERT_NE(rightExpr, nullptr);
-    ASSERT_EQ(rightExpr->op, "+");
+    ASSERT_EQ(rightExpr->op, ASTBinaryOperator::Add);
 
     const auto leftValue = static_cast<ASTValue*>(leftExpr->left.get());
     ASSERT_NE(leftValue, nullptr);
@@ -654,6 +654,33 @@ TEST(ParserTest, PrintFString) {
     ASSERT_EQ(fstring->line, 1);
 }
 
+TEST(ParserTest, SplitFString) {
+    Lexer lexer("println(f\"Hello, {name}! {1 + 2}\");");
+    const std::vector<Token> tokens = lexer.tokenize();
+
+    Parser parser(tokens);
+    auto program = parser.parse();
+
+    const auto print = static_cast<ASTPrint*>(program->body.front().get());
+    ASSERT_EQ(print->expression->type, ASTType::FString);
+
+    const auto fString = static_cast<ASTFString*>(print->expression.get());
+    ASSERT_EQ(fString->parts.size(), 4);
+    ASSERT_EQ(static_cast<ASTValue*>(fString->parts[0].get())->value, "Hello, ");
+    ASSERT_EQ(fString->parts[1]->type, ASTType::Variable);
+    ASSERT_EQ(static_cast<ASTValue*>(fString->parts[2].get())->value, "! ");
+    ASSERT_EQ(fString->parts[3]->type, ASTType::BinaryOperation);
+    ASSERT_EQ(fString->literalLength, 9);
+}
+
+TEST(ParserTest, FStringWithUnclosedBracket) {
+    Lexer lexer("println(f\"{abc\");");
+    const std::vector<Token> tokens = lexer.tokenize();
+
+    Parser parser(tokens);
+    ASSERT_THROW(parser.parse(), ZynkError);
+}
+
 TEST(ParserTest, parseSimpleComparison) {
     Lexer lexer("var isEqual: bool = a == b;");
     const std::vector<Token> tokens = lexer.tokenize();
@@ -669,9 +696,9 @@ TEST(ParserTest, parseSimpleComparison) {
     ASSERT_EQ(var->name, "isEqual");
     ASSERT_EQ(var->varType, ASTValueType::Bool);
 
-    const auto comparison = static_cast<ASTBinaryOperation*>(var->value.get());
+    const auto comparison = static_cast<ASTComparisonOperation*>(var->value.get());
     ASSERT_NE(comparison, nullptr);
-    ASSERT_EQ(comparison->op, "==");
+    ASSERT_EQ(comparison->op, ASTComparisonOperator::Equal);
 
     const auto leftVar = static_cast<ASTVariable*>(comparison->left.get());
     const auto rightVar = static_cast<ASTVariable*>(comparison->right.get());
@@ -693,10 +720,10 @@ TEST(ParserTest, parseGreaterThanComparison) {
     ASSERT_EQ(program->body.front()->type, ASTType::Condition);
 
     const auto condition = static_cast<ASTCondition*>(program->body.front().get());
-    const auto conditionExpression = static_cast<ASTBinaryOperation*>(condition->expression.get());
+    const auto conditionExpression = static_cast<ASTComparisonOperation*>(condition->expression.get());
 
     ASSERT_NE(condition, nullptr);
-    ASSERT_EQ(conditionExpression->op, ">");
+    ASSERT_EQ(conditionExpression->op, ASTComparisonOperator::Greater);
 
     ASSERT_EQ(condition->body.size(), 1);
     const auto printStmt = static_cast<ASTPrint*>(condition->body.front().get());
@@ -761,7 +788,7 @@ TEST(ParserTest, parseFunctionWithMultipleArguments) {
     const auto returnValue = static_cast<ASTBinaryOperation*>(returnStmt->value.get());
 
     ASSERT_NE(returnValue, nullptr);
-    ASSERT_EQ(returnValue->op, "+");
+    ASSERT_EQ(returnValue->op, ASTBinaryOperator::Add);
 
     const auto left = static_cast<ASTVariable*>(returnValue->left.get());
     const auto right = static_cast<ASTVariable*>(returnValue->right.get());
@@ -782,9 +809,9 @@ TEST(ParserTest, parseWhileLoop) {
 
     const auto whileLoop = static_cast<ASTWhile*>(program->body.front().get());
 
-    const auto condition = static_cast<ASTBinaryOperation*>(whileLoop->value.get());
+    const auto condition = static_cast<ASTComparisonOperation*>(whileLoop->value.get());
     ASSERT_NE(condition, nullptr);
-    ASSERT_EQ(condition->op, "<");
+    ASSERT_EQ(condition->op, ASTComparisonOperator::Less);
 
     const auto left = static_cast<ASTVariable*>(condition->left.get());
     const auto right = static_cast<ASTValue*>(condition->right.get());
@@ -802,7 +829,7 @@ TEST(ParserTest, parseWhileLoop) {
 
     const auto newValue = static_cast<ASTBinaryOperation*>(varModify->value.get());
     ASSERT_NE(newValue, nullptr);
-    ASSERT_EQ(newValue->op, "+");
+    ASSERT_EQ(newValue->op, ASTBinaryOperator::Add);
 
     const auto leftValue = static_cast<ASTVariable*>(newValue->left.get());
     const auto rightValue = static_cast<ASTValue*>(newValue->right.get());
@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+
+#include "../src/parsing/include/printer.hpp"
+#include "../src/parsing/include/parser.hpp"
+#include "../src/parsing/include/lexer.hpp"
+#include "../src/execution/optimizer/include/folder.hpp"
+#include "helpers.hpp"
+
+static std::string printSource(const std::string& code) {
+    Lexer lexer(code);
+    Parser parser(lexer.tokenize());
+    auto program = parser.parse();
+    return ASTPrinter().print(*program);
+}
+
+TEST(PrinterTest, PrintsStatements) {
+    const std::string source =
+        "def add(a: int, b: float) -> float {\n"
+        "    return float(a) + b;\n"
+        "}\n"
+        "var x: int = 1;\n"
+        "var y: string;\n"
+        "x = x * 2;\n"
+        "if (x > 1) {\n"
+        "    print(\"big\");\n"
+        "} else {\n"
+        "    println(f\"x is {x}\");\n"
+        "}\n"
+        "while (true) {\n"
+        "    break;\n"
+        "}\n"
+        "println(add(x, 0.5));\n";
+
+    EXPECT_EQ(printSource(source), source);
+}
+
+TEST(PrinterTest, ParenthesizesNestedOperations) {
+    EXPECT_EQ(printSource("println((1 + 2) * 3);"), "println((1 + 2) * 3);\n");
+    EXPECT_EQ(printSource("println((1 < 2) and (true or false));"), "println((1 < 2) and (true or false));\n");
+}
+
+TEST(PrinterTest, OutputParsesToTheSameProgram) {
+    const std::string printed = printSource("var v: int = 1 - -7; if (v == 8) println(readInput(\"> \"));");
+
+    EXPECT_EQ(printSource(printed), printed);
+}
+
+TEST(PrinterTest, PrintsFoldedFloatsAsLiterals) {
+    auto program = parseSource("println(10000000000.0 * 10000000000.0 * 1000000000.0);\nprintln(0.1 + 0.2);");
+    OptimizerStatistics statistics;
+    ConstantFolder(statistics).fold(*program);
+    const std::string printed = ASTPrinter().print(*program);
+
+    EXPECT_EQ(printed, "println(100000000000000000000000000000.0);\nprintln(0.30000000000000004);\n");
+    EXPECT_EQ(printSource(printed), printed);
+}
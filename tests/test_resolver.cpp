@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+
+#include "../src/parsing/include/resolver.hpp"
+#include "../src/parsing/include/parser.hpp"
+#include "../src/parsing/include/lexer.hpp"
+
+static std::unique_ptr<ASTProgram> resolveSource(const std::string& code) {
+    Lexer lexer(code);
+    Parser parser(lexer.tokenize());
+    auto program = parser.parse();
+    Resolver().resolve(*program);
+    return program;
+}
+
+TEST(ResolverTest, ResolveGlobalVariable) {
+    auto program = resolveSource("var x: int = 1; var y: int = x;");
+    ASSERT_EQ(program->frameSize, 2);
+
+    const auto first = static_cast<ASTVariableDeclaration*>(program->body[0].get());
+    const auto second = static_cast<ASTVariableDeclaration*>(program->body[1].get());
+    ASSERT_EQ(first->slot, 0);
+    ASSERT_EQ(second->slot, 1);
+
+    const auto variable = static_cast<ASTVariable*>(second->value.get());
+    ASSERT_EQ(variable->binding.depth, 0);
+    ASSERT_EQ(variable->binding.slot, 0);
+}
+
+TEST(ResolverTest, ResolveFunctionVariables) {
+    auto program = resolveSource(R"(
+        var total: int = 0;
+        def add(a: int) -> null {
+            var b: int = a;
+            total = total + b;
+        }
+    )");
+    const auto function = static_cast<ASTFunction*>(program->body[1].get());
+    ASSERT_EQ(function->frameSize, 2);
+    ASSERT_EQ(static_cast<ASTFunctionArgument*>(function->arguments[0].get())->slot, 0);
+
+    const auto declaration = static_cast<ASTVariableDeclaration*>(function->body[0].get());
+    ASSERT_EQ(declaration->slot, 1);
+    ASSERT_EQ(static_cast<ASTVariable*>(declaration->value.get())->binding.depth, 0);
+
+    const auto modify = static_cast<ASTVariableModify*>(function->body[1].get());
+    ASSERT_EQ(modify->binding.depth, 1);
+    ASSERT_EQ(modify->binding.slot, 0);
+}
+
+TEST(ResolverTest, ResolveVariableDeclaredAfterFunction) {
+    auto program = resolveSource(R"(
+        def show() -> null {
+            println(late);
+        }
+        var late: int = 1;
+    )");
+    const auto function = static_cast<ASTFunction*>(program->body[0].get());
+    const auto print = static_cast<ASTPrint*>(function->body[0].get());
+    const auto variable = static_cast<ASTVariable*>(print->expression.get());
+    ASSERT_EQ(variable->binding.depth, 1);
+    ASSERT_EQ(variable->binding.slot, 0);
+}
+
+TEST(ResolverTest, ShadowedVariableGetsOwnSlot) {
+    auto program = resolveSource(R"(
+        var x: int = 1;
+        if (true) {
+            var x: int = 2;
+            println(x);
+        }
+        println(x);
+    )");
+    const auto condition = static_cast<ASTCondition*>(program->body[1].get());
+    const auto inner = static_cast<ASTVariableDeclaration*>(condition->body[0].get());
+    ASSERT_EQ(inner->slot, 1);
+
+    const auto innerPrint = static_cast<ASTPrint*>(condition->body[1].get());
+    ASSERT_EQ(static_cast<ASTVariable*>(innerPrint->expression.get())->binding.slot, 1);
+
+    const auto outerPrint = static_cast<ASTPrint*>(program->body[2].get());
+    ASSERT_EQ(static_cast<ASTVariable*>(outerPrint->expression.get())->binding.slot, 0);
+}
+
+TEST(ResolverTest, ReuseSlotsOfClosedBlock) {
+    auto program = resolveSource(R"(
+        if (true) {
+            var a: int = 1;
+        }
+        var b: int = 2;
+    )");
+    ASSERT_EQ(program->frameSize, 1);
+    ASSERT_EQ(static_cast<ASTVariableDeclaration*>(program->body[1].get())->slot, 0);
+}
+
+TEST(ResolverTest, LeaveUnknownVariableUnresolved) {
+    auto program = resolveSource("println(unknown);");
+    const auto print = static_cast<ASTPrint*>(program->body[0].get());
+    ASSERT_EQ(static_cast<ASTVariable*>(print->expression.get())->binding.slot, ASTBinding::Unresolved);
+}
+
+TEST(ResolverTest, ResolveFStringExpressions) {
+    auto program = resolveSource("var first: int = 1; var name: string = \"Zynk\"; println(f\"Hello, {name}!\");");
+    const auto print = static_cast<ASTPrint*>(program->body[2].get());
+    const auto fString = static_cast<ASTFString*>(print->expression.get());
+
+    ASSERT_EQ(static_cast<ASTVariable*>(fString->parts[1].get())->binding.slot, 1);
+}
+
+TEST(ResolverTest, BindDeclaredType) {
+    auto program = resolveSource("def half(a: float) -> float { return a / 2; } var name: string = \"Zynk\"; name = name;");
+    const auto function = static_cast<ASTFunction*>(program->body[0].get());
+    const auto returnStatement = static_cast<ASTReturn*>(function->body[0].get());
+    const auto division = static_cast<ASTBinaryOperation*>(returnStatement->value.get());
+    ASSERT_EQ(static_cast<ASTVariable*>(division->left.get())->binding.type, ASTValueType::Float);
+
+    const auto modify = static_cast<ASTVariableModify*>(program->body[2].get());
+    ASSERT_EQ(modify->binding.type, ASTValueType::String);
+}
+
+TEST(ResolverTest, BindWhetherDeclaredWithValue) {
+    auto program = resolveSource("var x: float; var y: float = 1.0; println(x + y);");
+    const auto print = static_cast<ASTPrint*>(program->body[2].get());
+    const auto addition = static_cast<ASTBinaryOperation*>(print->expression.get());
+    ASSERT_FALSE(static_cast<ASTVariable*>(addition->left.get())->binding.initialized);
+    ASSERT_TRUE(static_cast<ASTVariable*>(addition->right.get())->binding.initialized);
+}
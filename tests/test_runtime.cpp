@@ -4,157 +4,286 @@
 #include "../src/parsing/include/ast.hpp"
 #include "../src/errors/include/errors.hpp"
 
+static ASTBinding binding(size_t depth, size_t slot) {
+    ASTBinding result;
+    result.depth = depth;
+    result.slot = slot;
+    return result;
+}
+
 TEST(RuntimeEnvironmentTest, VariableDeclaration) {
     RuntimeEnvironment env;
-    env.enterNewBlock();
+    env.enterProgram(1);
 
-    auto varValue = std::make_unique<ASTValue>("10", ASTValueType::Integer, 10);
-    env.declareVariable("x", std::move(varValue));
+    env.declareVariable("x", 0, ASTValueType::Integer, Value::fromInt(10), 10);
 
-    auto retrievedVar = env.getVariable("x", 10, true);
-    ASSERT_EQ(retrievedVar->value, "10");
+    auto retrievedVar = env.getVariable("x", binding(0, 0), 10);
+    ASSERT_EQ(retrievedVar->value.asInt(), 10);
+    ASSERT_EQ(retrievedVar->type, ASTValueType::Integer);
 
-    auto varValue2 = std::make_unique<ASTValue>("11", ASTValueType::Integer, 11);
-    ASSERT_THROW(env.declareVariable("x", std::move(varValue2)), ZynkError);
-    ASSERT_EQ(env.isVariableDeclared("x"), true);
-    env.exitCurrentBlock();
+    ASSERT_THROW(env.declareVariable("x", 0, ASTValueType::Integer, Value::fromInt(11), 11), ZynkError);
+    env.exitFrame();
 }
 
-TEST(RuntimeEnvironmentTest, VariableDeclarationWithoutDeepSearch) {
+TEST(RuntimeEnvironmentTest, VariableShadowingInNestedBlock) {
     RuntimeEnvironment env;
-    env.enterNewBlock();
+    env.enterProgram(2);
 
-    auto varValue = std::make_unique<ASTValue>("10", ASTValueType::Integer, 10);
-    ASSERT_NO_THROW(env.declareVariable("x", std::move(varValue)));
+    ASSERT_NO_THROW(env.declareVariable("x", 0, ASTValueType::Integer, Value::fromInt(10), 10));
 
     env.enterNewBlock();
-    auto retrievedVar = env.getVariable("x", 10, true);
-    ASSERT_EQ(retrievedVar->line, 10);
-
-    auto varValue2 = std::make_unique<ASTValue>("50", ASTValueType::Integer, 11);
-    ASSERT_NO_THROW(env.declareVariable("x", std::move(varValue2)));
+    ASSERT_EQ(env.getVariable("x", binding(0, 0), 10)->value.asInt(), 10);
 
-    auto retrievedVar2 = env.getVariable("x", 50, false);
-    ASSERT_EQ(retrievedVar2->line, 11);
+    ASSERT_NO_THROW(env.declareVariable("x", 1, ASTValueType::Integer, Value::fromInt(50), 11));
+    ASSERT_EQ(env.getVariable("x", binding(0, 1), 11)->value.asInt(), 50);
     env.exitCurrentBlock();
 
-    auto varValue3 = std::make_unique<ASTValue>("12", ASTValueType::Integer, 12);
-    ASSERT_THROW(env.declareVariable("x", std::move(varValue3)), ZynkError);
-    ASSERT_EQ(env.isVariableDeclared("x"), true);
-    env.exitCurrentBlock();
+    ASSERT_EQ(env.getVariable("x", binding(0, 0), 12)->value.asInt(), 10);
+    ASSERT_THROW(env.declareVariable("x", 0, ASTValueType::Integer, Value::fromInt(12), 12), ZynkError);
+    env.exitFrame();
 }
 
 TEST(RuntimeEnvironmentTest, FunctionDeclaration) {
     RuntimeEnvironment env;
-    env.enterNewBlock();
+    env.enterProgram(0);
 
     auto funcDeclaration = std::make_unique<ASTFunction>("myFunction", ASTValueType::None, 20);
-    ASSERT_NO_THROW(env.declareFunction(std::move(funcDeclaration)));
+    ASSERT_NO_THROW(env.declareFunction(funcDeclaration.get()));
 
     auto retrievedFunc = env.getFunction("myFunction", 20);
     ASSERT_EQ(retrievedFunc->name, "myFunction");
     ASSERT_EQ(retrievedFunc->body.size(), 0);
 
     auto funcDeclaration2 = std::make_unique<ASTFunction>("myFunction", ASTValueType::None, 5);
-    ASSERT_THROW(env.declareFunction(std::move(funcDeclaration2)), ZynkError);
+    ASSERT_THROW(env.declareFunction(funcDeclaration2.get()), ZynkError);
     ASSERT_EQ(env.isFunctionDeclared("myFunction"), true);
-    env.exitCurrentBlock();
+    env.exitFrame();
 }
 
 TEST(RuntimeEnvironmentTest, VariableNotDefinedError) {
     RuntimeEnvironment env;
-    env.enterNewBlock();
+    env.enterProgram(1);
 
-    ASSERT_THROW(env.getVariable("undefinedVar", 1, true), ZynkError);
-    ASSERT_EQ(env.isVariableDeclared("undefinedVar"), false);
+    ASSERT_THROW(env.getVariable("undefinedVar", ASTBinding(), 1), ZynkError);
+    // Resolved, but the declaration wasn't executed yet.
+    ASSERT_THROW(env.getVariable("laterVar", binding(0, 0), 1), ZynkError);
 
-    env.exitCurrentBlock();
+    env.exitFrame();
 }
 
 TEST(RuntimeEnvironmentTest, FunctionNotDefinedError) {
     RuntimeEnvironment env;
-    env.enterNewBlock();
+    env.enterProgram(0);
 
     ASSERT_THROW(env.getFunction("undefinedFunc", 10), ZynkError);
     ASSERT_EQ(env.isFunctionDeclared("undefinedFunc"), false);
 
-    env.exitCurrentBlock();
+    env.exitFrame();
 }
 
 TEST(RuntimeEnvironmentTest, EnterAndExitBlock) {
     RuntimeEnvironment env;
 
     ASSERT_EQ(env.currentBlock(), nullptr);
-    env.enterNewBlock();
+    env.enterProgram(1);
     ASSERT_NE(env.currentBlock(), nullptr);
 
-    auto varValue = std::make_unique<ASTValue>("1.5", ASTValueType::Float, 30);
-    env.declareVariable("x", std::move(varValue));
+    env.declareVariable("x", 0, ASTValueType::Float, Value::fromFloat(1.5), 30);
 
-    ASSERT_EQ(env.isVariableDeclared("x"), true);
     env.enterNewBlock();
-    ASSERT_EQ(env.isVariableDeclared("x"), true);
+    ASSERT_DOUBLE_EQ(env.getVariable("x", binding(0, 0), 30)->value.asFloat(), 1.5);
     env.exitCurrentBlock();
 
-    ASSERT_EQ(env.isVariableDeclared("x"), true);
-    env.exitCurrentBlock();
+    ASSERT_DOUBLE_EQ(env.getVariable("x", binding(0, 0), 30)->value.asFloat(), 1.5);
+    env.exitFrame();
 
     ASSERT_EQ(env.currentBlock(), nullptr);
-    ASSERT_EQ(env.isVariableDeclared("x"), false);
 }
 
-TEST(RuntimeEnvironmentTest, GarbageCollectionAfterBlockExit) {
+TEST(RuntimeEnvironmentTest, SlotsReleasedAfterBlockExit) {
     RuntimeEnvironment env;
+    env.enterProgram(2);
     env.enterNewBlock();
 
-    auto varValue1 = std::make_unique<ASTValue>("1.5", ASTValueType::Float, 40);
-    auto varValue2 = std::make_unique<ASTValue>("5", ASTValueType::Integer, 41);
+    env.declareVariable("var1", 0, ASTValueType::Float, Value::fromFloat(1.5), 40);
+    env.declareVariable("var2", 1, ASTValueType::Integer, Value::fromInt(5), 41);
+    env.exitCurrentBlock();
 
-    env.declareVariable("var1", std::move(varValue1));
-    env.declareVariable("var2", std::move(varValue2));
+    ASSERT_THROW(env.getVariable("var1", binding(0, 0), 42), ZynkError);
+    ASSERT_THROW(env.getVariable("var2", binding(0, 1), 42), ZynkError);
 
-    ASSERT_EQ(env.currentBlock()->variables.size(), 2);
+    // The following block reuses the slots.
+    env.enterNewBlock();
+    ASSERT_NO_THROW(env.declareVariable("var3", 0, ASTValueType::Integer, Value::fromInt(7), 43));
     env.exitCurrentBlock();
-    ASSERT_EQ(env.currentBlock(), nullptr);
+    env.exitFrame();
 }
 
-TEST(RuntimeEnvironmentTest, GarbageCollectionWithNestedBlocks) {
+TEST(RuntimeEnvironmentTest, FunctionFrameReachesEnclosingFrame) {
     RuntimeEnvironment env;
-    env.enterNewBlock();
+    env.enterProgram(1);
+    env.declareVariable("global", 0, ASTValueType::Integer, Value::fromInt(1), 50);
+
+    auto func = std::make_unique<ASTFunction>("func", ASTValueType::None, 51);
+    func->frameSize = 1;
+    env.declareFunction(func.get());
 
-    auto varValue = std::make_unique<ASTValue>("Abc", ASTValueType::String, 50);
-    auto globalVar = std::make_unique<ASTValue>("Abc", ASTValueType::String, 50);
+    env.enterFunction(*func);
+    env.declareVariable("local", 0, ASTValueType::Integer, Value::fromInt(2), 52);
+    ASSERT_EQ(env.getVariable("local", binding(0, 0), 53)->value.asInt(), 2);
+    ASSERT_EQ(env.getVariable("global", binding(1, 0), 53)->value.asInt(), 1);
+    env.exitFrame();
+
+    ASSERT_EQ(env.getVariable("global", binding(0, 0), 54)->value.asInt(), 1);
+    env.exitFrame();
+}
+
+TEST(RuntimeEnvironmentTest, GarbageCollectionWithNestedBlocks) {
+    RuntimeEnvironment env;
+    env.enterProgram(2);
 
     auto globalFunc = std::make_unique<ASTFunction>("globalFunc", ASTValueType::None, 51);
 
-    ASSERT_NO_THROW(env.declareVariable("globalVar", std::move(globalVar)));
-    ASSERT_NO_THROW(env.declareFunction(std::move(globalFunc)));
+    ASSERT_NO_THROW(env.declareVariable("globalVar", 0, ASTValueType::String, Value::fromString("Abc"), 50));
+    ASSERT_NO_THROW(env.declareFunction(globalFunc.get()));
 
-    ASSERT_EQ(env.currentBlock()->variables.size(), 1);
-    ASSERT_EQ(env.currentBlock()->functions.size(), 1);
-    ASSERT_TRUE(env.isVariableDeclared("globalVar"));
     ASSERT_TRUE(env.isFunctionDeclared("globalFunc"));
 
     env.enterNewBlock();
-    auto innerVarValue = std::make_unique<ASTValue>("Cba", ASTValueType::String, 60);
-    env.declareVariable("innerVar", std::move(innerVarValue));
+    env.declareVariable("innerVar", 1, ASTValueType::String, Value::fromString("Cba"), 60);
 
     auto innerFunc = std::make_unique<ASTFunction>("innerFunc", ASTValueType::None, 61);
-    env.declareFunction(std::move(innerFunc));
+    env.declareFunction(innerFunc.get());
 
-    ASSERT_EQ(env.currentBlock()->variables.size(), 1);
-    ASSERT_TRUE(env.isVariableDeclared("innerVar"));
+    ASSERT_EQ(env.getVariable("innerVar", binding(0, 1), 62)->value.asString(), "Cba");
     ASSERT_TRUE(env.isFunctionDeclared("innerFunc"));
 
     env.exitCurrentBlock();
-    ASSERT_EQ(env.currentBlock()->variables.size(), 1);
-    ASSERT_FALSE(env.isVariableDeclared("innerVar"));
+    ASSERT_THROW(env.getVariable("innerVar", binding(0, 1), 63), ZynkError);
     ASSERT_FALSE(env.isFunctionDeclared("innerFunc"));
-    ASSERT_TRUE(env.isVariableDeclared("globalVar"));
+    ASSERT_EQ(env.getVariable("globalVar", binding(0, 0), 63)->value.asString(), "Abc");
     ASSERT_TRUE(env.isFunctionDeclared("globalFunc"));
 
-    env.exitCurrentBlock();
+    env.exitFrame();
     ASSERT_EQ(env.currentBlock(), nullptr);
-    ASSERT_FALSE(env.isVariableDeclared("globalVar"));
     ASSERT_FALSE(env.isFunctionDeclared("globalFunc"));
 }
+
+TEST(RuntimeEnvironmentTest, FunctionVisibleInNestedBlock) {
+    RuntimeEnvironment env;
+    env.enterProgram(0);
+
+    auto outerFunc = std::make_unique<ASTFunction>("outer", ASTValueType::None, 70);
+    env.declareFunction(outerFunc.get());
+
+    env.enterNewBlock();
+    auto innerFunc = std::make_unique<ASTFunction>("inner", ASTValueType::None, 71);
+    env.declareFunction(innerFunc.get());
+    ASSERT_EQ(env.getFunction("outer", 72), outerFunc.get());
+    ASSERT_EQ(env.getFunction("inner", 72), innerFunc.get());
+
+    // The frame of a call is nested in the block the function was declared in.
+    env.enterFunction(*outerFunc);
+    ASSERT_EQ(env.getFunction("outer", 73), outerFunc.get());
+    ASSERT_FALSE(env.isFunctionDeclared("inner"));
+    env.exitFrame();
+
+    env.exitCurrentBlock();
+    env.exitFrame();
+}
+
+TEST(RuntimeEnvironmentTest, FrameStorageReused) {
+    RuntimeEnvironment env;
+    env.enterProgram(0);
+
+    auto func = std::make_unique<ASTFunction>("func", ASTValueType::None, 80);
+    func->frameSize = 2;
+    env.declareFunction(func.get());
+
+    env.enterFunction(*func);
+    env.declareVariable("local", 1, ASTValueType::String, Value::fromString("first"), 81);
+    const Variable* first = env.getVariable("local", binding(0, 1), 82);
+    env.exitFrame();
+
+    env.enterFunction(*func);
+    ASSERT_THROW(env.getVariable("local", binding(0, 1), 83), ZynkError);
+    env.declareVariable("local", 1, ASTValueType::String, Value::fromString("second"), 84);
+    const Variable* second = env.getVariable("local", binding(0, 1), 85);
+    ASSERT_EQ(first, second);
+    ASSERT_EQ(second->value.asString(), "second");
+    env.exitFrame();
+
+    env.exitFrame();
+}
+
+TEST(RuntimeEnvironmentTest, FindSymbolsWithoutThrowing) {
+    RuntimeEnvironment env;
+    ASSERT_EQ(env.findFunction("func"), nullptr);
+    env.enterProgram(1);
+
+    ASSERT_EQ(env.findVariable(ASTBinding()), nullptr);
+    ASSERT_EQ(env.findVariable(binding(0, 0)), nullptr);
+    env.declareVariable("x", 0, ASTValueType::Integer, Value::fromInt(3), 90);
+    ASSERT_EQ(env.findVariable(binding(0, 0))->value.asInt(), 3);
+
+    ASSERT_EQ(env.findFunction("func"), nullptr);
+    auto func = std::make_unique<ASTFunction>("func", ASTValueType::None, 91);
+    env.declareFunction(func.get());
+    ASSERT_EQ(env.findFunction("func"), func.get());
+
+    env.exitFrame();
+}
+
+TEST(RuntimeEnvironmentTest, FindFunctionScopeById) {
+    RuntimeEnvironment env;
+    env.enterProgram(0);
+
+    auto outer = std::make_unique<ASTFunction>("outer", ASTValueType::None, 100);
+    auto inner = std::make_unique<ASTFunction>("inner", ASTValueType::None, 101);
+    outer->id = 0;
+    inner->id = 1;
+    ASSERT_EQ(env.findFunctionScope(*outer, 0), Block::None);
+    env.declareFunction(outer.get());
+    ASSERT_EQ(env.findFunctionScope(*outer, 0), 0);
+
+    // Every call of outer declares inner again, in its own frame.
+    env.enterFunction(*outer, 0);
+    env.declareFunction(inner.get());
+    const size_t firstScope = env.findFunctionScope(*inner, 0);
+    ASSERT_EQ(env.findFunctionScope(*outer, 1), 0);
+
+    env.enterFunction(*outer, 0);
+    ASSERT_EQ(env.findFunctionScope(*inner, 0), Block::None);
+    ASSERT_THROW(env.getFunctionScope(*inner, 0, 102), ZynkError);
+    env.declareFunction(inner.get());
+    ASSERT_NE(env.findFunctionScope(*inner, 0), firstScope);
+    env.exitFrame();
+
+    ASSERT_EQ(env.findFunctionScope(*inner, 0), firstScope);
+    env.exitFrame();
+    ASSERT_EQ(env.findFunctionScope(*inner, 0), Block::None);
+
+    env.exitFrame();
+}
+
+TEST(RuntimeEnvironmentTest, BindArguments) {
+    RuntimeEnvironment env;
+    env.enterProgram(0);
+
+    auto func = std::make_unique<ASTFunction>("func", ASTValueType::None, 110);
+    func->frameSize = 2;
+    env.declareFunction(func.get());
+
+    env.enterFunction(*func, 0);
+    env.bindArgument(0, ASTValueType::Integer, Value::fromInt(1));
+    env.bindArgument(1, ASTValueType::String, Value::fromString("two"));
+    ASSERT_EQ(env.getVariable("a", binding(0, 0), 111)->value.asInt(), 1);
+    ASSERT_EQ(env.getVariable("b", binding(0, 1), 111)->value.asString(), "two");
+    env.exitFrame();
+
+    env.enterFunction(*func, 0);
+    ASSERT_EQ(env.findVariable(binding(0, 0)), nullptr);
+    env.exitFrame();
+
+    env.exitFrame();
+}
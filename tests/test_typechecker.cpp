@@ -2,193 +2,168 @@
 
 #include "../src/execution/typechecker/include/checker.hpp"
 #include "../src/errors/include/errors.hpp"
+#include "../src/parsing/include/resolver.hpp"
+#include "../src/parsing/include/parser.hpp"
+#include "../src/parsing/include/lexer.hpp"
+#include "helpers.hpp"
 
 TEST(TypeCheckerTest, DetermineTypeIntegerValue) {
-    RuntimeEnvironment env;
-    TypeChecker typeChecker(env);
+    TypeChecker typeChecker;
 
     auto ASTValueInt = std::make_unique<ASTValue>("42", ASTValueType::Integer, 1);
     ASSERT_EQ(typeChecker.determineType(ASTValueInt.get()), ASTValueType::Integer);
 }
 
 TEST(TypeCheckerTest, DetermineTypeFloatValue) {
-    RuntimeEnvironment env;
-    TypeChecker typeChecker(env);
+    TypeChecker typeChecker;
 
     auto ASTValueFloat = std::make_unique<ASTValue>("3.14", ASTValueType::Float, 1);
     ASSERT_EQ(typeChecker.determineType(ASTValueFloat.get()), ASTValueType::Float);
 }
 
 TEST(TypeCheckerTest, DetermineTypeStringValue) {
-    RuntimeEnvironment env;
-    TypeChecker typeChecker(env);
+    TypeChecker typeChecker;
 
     auto ASTValueString = std::make_unique<ASTValue>("hello", ASTValueType::String, 1);
     ASSERT_EQ(typeChecker.determineType(ASTValueString.get()), ASTValueType::String);
 }
 
 TEST(TypeCheckerTest, DetermineTypeBooleanValue) {
-    RuntimeEnvironment env;
-    TypeChecker typeChecker(env);
+    TypeChecker typeChecker;
 
     auto ASTValueBool = std::make_unique<ASTValue>("true", ASTValueType::Bool, 1);
     ASSERT_EQ(typeChecker.determineType(ASTValueBool.get()), ASTValueType::Bool);
 }
 
 TEST(TypeCheckerTest, DetermineTypeZeroIntegerValue) {
-    RuntimeEnvironment env;
-    TypeChecker typeChecker(env);
+    TypeChecker typeChecker;
 
     auto ASTValueZeroInt = std::make_unique<ASTValue>("0", ASTValueType::Integer, 1);
     ASSERT_EQ(typeChecker.determineType(ASTValueZeroInt.get()), ASTValueType::Integer);
 }
 
 TEST(TypeCheckerTest, DetermineTypeZeroFloatValue) {
-    RuntimeEnvironment env;
-    TypeChecker typeChecker(env);
+    TypeChecker typeChecker;
 
     auto ASTValueZeroFloat = std::make_unique<ASTValue>("0.0", ASTValueType::Float, 1);
     ASSERT_EQ(typeChecker.determineType(ASTValueZeroFloat.get()), ASTValueType::Float);
 }
 
 TEST(TypeCheckerTest, DetermineTypeEmptyStringValue) {
-    RuntimeEnvironment env;
-    TypeChecker typeChecker(env);
+    TypeChecker typeChecker;
 
     auto ASTValueEmptyString = std::make_unique<ASTValue>("", ASTValueType::String, 1);
     ASSERT_EQ(typeChecker.determineType(ASTValueEmptyString.get()), ASTValueType::String);
 }
 
 TEST(TypeCheckerTest, DetermineTypeFalseBooleanValue) {
-    RuntimeEnvironment env;
-    TypeChecker typeChecker(env);
+    TypeChecker typeChecker;
 
     auto ASTValueFalseBool = std::make_unique<ASTValue>("false", ASTValueType::Bool, 1);
     ASSERT_EQ(typeChecker.determineType(ASTValueFalseBool.get()), ASTValueType::Bool);
 }
 
 TEST(TypeCheckerTest, DetermineTypeIntegerVariable) {
-    RuntimeEnvironment env;
-    TypeChecker typeChecker(env);
-    env.enterNewBlock();
-
-    auto ASTValueInt = std::make_unique<ASTValue>("42", ASTValueType::Integer, 1);
-    env.declareVariable("x", std::move(ASTValueInt));
+    TypeChecker typeChecker;
 
     auto ASTVariableInt = std::make_unique<ASTVariable>("x", 1);
+    ASTVariableInt->binding.slot = 0;
+    ASTVariableInt->binding.type = ASTValueType::Integer;
     ASSERT_EQ(typeChecker.determineType(ASTVariableInt.get()), ASTValueType::Integer);
-    env.exitCurrentBlock();
 }
 
 TEST(TypeCheckerTest, DetermineTypeFloatVariable) {
-    RuntimeEnvironment env;
-    TypeChecker typeChecker(env);
-    env.enterNewBlock();
-
-    auto ASTValueFloat = std::make_unique<ASTValue>("3.14", ASTValueType::Float, 1);
-    env.declareVariable("y", std::move(ASTValueFloat));
+    TypeChecker typeChecker;
 
     auto ASTVariableFloat = std::make_unique<ASTVariable>("y", 1);
+    ASTVariableFloat->binding.slot = 0;
+    ASTVariableFloat->binding.type = ASTValueType::Float;
     ASSERT_EQ(typeChecker.determineType(ASTVariableFloat.get()), ASTValueType::Float);
-    env.exitCurrentBlock();
 }
 
 TEST(TypeCheckerTest, DetermineTypeStringVariable) {
-    RuntimeEnvironment env;
-    TypeChecker typeChecker(env);
-    env.enterNewBlock();
-
-    auto ASTValueString = std::make_unique<ASTValue>("Hello", ASTValueType::String, 1);
-    env.declareVariable("greeting", std::move(ASTValueString));
+    TypeChecker typeChecker;
 
     auto ASTVariableString = std::make_unique<ASTVariable>("greeting", 1);
+    ASTVariableString->binding.slot = 0;
+    ASTVariableString->binding.type = ASTValueType::String;
     ASSERT_EQ(typeChecker.determineType(ASTVariableString.get()), ASTValueType::String);
-    env.exitCurrentBlock();
 }
 
 TEST(TypeCheckerTest, DetermineTypeUndeclaredVariable) {
-    RuntimeEnvironment env;
-    TypeChecker typeChecker(env);
-    env.enterNewBlock();
+    TypeChecker typeChecker;
 
     auto ASTVariableUndeclared = std::make_unique<ASTVariable>("undeclaredVariable", 1);
     ASSERT_THROW(typeChecker.determineType(ASTVariableUndeclared.get()), ZynkError);
-    env.exitCurrentBlock();
 }
 
 TEST(TypeCheckerTest, DetermineTypeIntegerBinaryOperation) {
-    RuntimeEnvironment env;
-    TypeChecker typeChecker(env);
+    TypeChecker typeChecker;
 
     auto ASTLeftValueInt = std::make_unique<ASTValue>("5", ASTValueType::Integer, 1);
     auto ASTRightValueInt = std::make_unique<ASTValue>("3", ASTValueType::Integer, 1);
     auto ASTOperation = std::make_unique<ASTBinaryOperation>(
-        std::move(ASTLeftValueInt), "+", std::move(ASTRightValueInt), 1
+        std::move(ASTLeftValueInt), ASTBinaryOperator::Add, std::move(ASTRightValueInt), 1
     );
     ASSERT_EQ(typeChecker.determineType(ASTOperation.get()), ASTValueType::Integer);
 }
 
 TEST(TypeCheckerTest, DetermineTypeFloatBinaryOperation) {
-    RuntimeEnvironment env;
-    TypeChecker typeChecker(env);
+    TypeChecker typeChecker;
 
     auto ASTLeftValueInt = std::make_unique<ASTValue>("5", ASTValueType::Integer, 1);
     auto ASTRightValueFloat = std::make_unique<ASTValue>("3.14", ASTValueType::Float, 1);
     auto ASTOperation = std::make_unique<ASTBinaryOperation>(
-        std::move(ASTLeftValueInt), "*", std::move(ASTRightValueFloat), 1
+        std::move(ASTLeftValueInt), ASTBinaryOperator::Multiply, std::move(ASTRightValueFloat), 1
     );
     ASSERT_EQ(typeChecker.determineType(ASTOperation.get()), ASTValueType::Float);
 }
 
 TEST(TypeCheckerTest, DetermineTypeMismatchedBinaryOperation) {
-    RuntimeEnvironment env;
-    TypeChecker typeChecker(env);
+    TypeChecker typeChecker;
 
     auto ASTLeftValueString = std::make_unique<ASTValue>("Hello", ASTValueType::String, 1);
     auto ASTRightValueFloat = std::make_unique<ASTValue>("3.14", ASTValueType::Float, 1);
     auto ASTOperation = std::make_unique<ASTBinaryOperation>(
-        std::move(ASTLeftValueString), "+", std::move(ASTRightValueFloat), 1
+        std::move(ASTLeftValueString), ASTBinaryOperator::Add, std::move(ASTRightValueFloat), 1
     );
-    ASSERT_EQ(typeChecker.determineType(ASTOperation.get()), ASTValueType::String);
+    ASSERT_THROW(typeChecker.determineType(ASTOperation.get()), ZynkError);
 }
 
 TEST(TypeCheckerTest, DetermineTypeComparisonOperation) {
-    RuntimeEnvironment env;
-    TypeChecker typeChecker(env);
+    TypeChecker typeChecker;
 
     auto ASTLeftValueInt = std::make_unique<ASTValue>("5", ASTValueType::Integer, 1);
     auto ASTRightValueInt = std::make_unique<ASTValue>("3", ASTValueType::Integer, 1);
     auto ComparisonOperation = std::make_unique<ASTComparisonOperation>(
-        std::move(ASTLeftValueInt), "==", std::move(ASTRightValueInt), 1
+        std::move(ASTLeftValueInt), ASTComparisonOperator::Equal, std::move(ASTRightValueInt), 1
     );
     ASSERT_EQ(typeChecker.determineType(ComparisonOperation.get()), ASTValueType::Bool);
 
     auto ASTLeftValueFloat = std::make_unique<ASTValue>("2.5", ASTValueType::Float, 1);
     auto ASTRightValueFloat = std::make_unique<ASTValue>("2.5", ASTValueType::Float, 1);
     ComparisonOperation = std::make_unique<ASTComparisonOperation>(
-        std::move(ASTLeftValueFloat), "==", std::move(ASTRightValueFloat), 1
+        std::move(ASTLeftValueFloat), ASTComparisonOperator::Equal, std::move(ASTRightValueFloat), 1
     );
     ASSERT_EQ(typeChecker.determineType(ComparisonOperation.get()), ASTValueType::Bool);
 
     auto ASTLeftValueString = std::make_unique<ASTValue>("hello", ASTValueType::String, 1);
     auto ASTRightValueString = std::make_unique<ASTValue>("world", ASTValueType::String, 1);
     ComparisonOperation = std::make_unique<ASTComparisonOperation>(
-        std::move(ASTLeftValueString), "!=", std::move(ASTRightValueString), 1
+        std::move(ASTLeftValueString), ASTComparisonOperator::NotEqual, std::move(ASTRightValueString), 1
     );
     ASSERT_EQ(typeChecker.determineType(ComparisonOperation.get()), ASTValueType::Bool);
 }
 
 TEST(TypeCheckerTest, DetermineTypeFString) {
-    RuntimeEnvironment env;
-    TypeChecker typeChecker(env);
+    TypeChecker typeChecker;
 
     auto fString = std::make_unique<ASTFString>("Street: {name}", 1);
     ASSERT_EQ(typeChecker.determineType(fString.get()), ASTValueType::String);
 }
 
 TEST(TypeCheckerTest, DetermineTypeCastFromFloatToInt) {
-    RuntimeEnvironment env;
-    TypeChecker typeChecker(env);
+    TypeChecker typeChecker;
 
     auto ASTValueFloat = std::make_unique<ASTValue>("3.14", ASTValueType::Float, 1);
     auto ASTCast = std::make_unique<ASTTypeCast>(std::move(ASTValueFloat), ASTValueType::Integer, 1);
@@ -196,8 +171,7 @@ TEST(TypeCheckerTest, DetermineTypeCastFromFloatToInt) {
 }
 
 TEST(TypeCheckerTest, DetermineTypeCastFromStringToFloat) {
-    RuntimeEnvironment env;
-    TypeChecker typeChecker(env);
+    TypeChecker typeChecker;
 
     auto ASTValueString = std::make_unique<ASTValue>("3.14", ASTValueType::String, 1);
     auto ASTCast = std::make_unique<ASTTypeCast>(std::move(ASTValueString), ASTValueType::Float, 1);
@@ -205,8 +179,7 @@ TEST(TypeCheckerTest, DetermineTypeCastFromStringToFloat) {
 }
 
 TEST(TypeCheckerTest, DetermineTypeCastFromIntToBool) {
-    RuntimeEnvironment env;
-    TypeChecker typeChecker(env);
+    TypeChecker typeChecker;
 
     auto ASTValueInt = std::make_unique<ASTValue>("1", ASTValueType::Integer, 1);
     auto ASTCast = std::make_unique<ASTTypeCast>(std::move(ASTValueInt), ASTValueType::Bool, 1);
@@ -214,8 +187,7 @@ TEST(TypeCheckerTest, DetermineTypeCastFromIntToBool) {
 }
 
 TEST(TypeCheckerTest, DetermineTypeAndOperation) {
-    RuntimeEnvironment env;
-    TypeChecker typeChecker(env);
+    TypeChecker typeChecker;
 
     auto ASTLeftValueBool = std::make_unique<ASTValue>("true", ASTValueType::Bool, 1);
     auto ASTRightValueBool = std::make_unique<ASTValue>("false", ASTValueType::Bool, 1);
@@ -226,28 +198,93 @@ TEST(TypeCheckerTest, DetermineTypeAndOperation) {
 }
 
 TEST(TypeCheckerTest, DetermineTypeReturn) {
-    RuntimeEnvironment env;
-    TypeChecker typeChecker(env);
-    env.enterNewBlock();
+    TypeChecker typeChecker;
 
-    auto func = std::make_unique<ASTFunction>("myFunc", ASTValueType::Integer, 1);
     auto returnValue = std::make_unique<ASTValue>("42", ASTValueType::Integer, 1);
     auto returnStmt = std::make_unique<ASTReturn>(std::move(returnValue), 1);
-
-    env.declareFunction(std::move(func));
     ASSERT_EQ(typeChecker.determineType(returnStmt.get()), ASTValueType::Integer);
-    env.exitCurrentBlock();
 }
 
 TEST(TypeCheckerTest, DetermineTypeFunctionCall) {
-    RuntimeEnvironment env;
-    TypeChecker typeChecker(env);
-    env.enterNewBlock();
+    auto program = parseSource("def myFunc() -> int { return 42; } var x: int = myFunc();");
+    const auto declaration = static_cast<ASTVariableDeclaration*>(program->body[1].get());
+    ASSERT_EQ(declaration->value->staticType, ASTValueType::Integer);
+}
+
+TEST(TypeCheckerTest, AnnotateNestedExpressions) {
+    auto program = parseSource("var a: int = 1; var b: float = a * 2.5 + 1;");
+    const auto declaration = static_cast<ASTVariableDeclaration*>(program->body[1].get());
+    const auto sum = static_cast<ASTBinaryOperation*>(declaration->value.get());
+    ASSERT_EQ(sum->staticType, ASTValueType::Float);
+
+    const auto product = static_cast<ASTBinaryOperation*>(sum->left.get());
+    ASSERT_EQ(product->left->staticType, ASTValueType::Integer);
+    ASSERT_EQ(product->right->staticType, ASTValueType::Float);
+}
+
+TEST(TypeCheckerTest, CheckFunctionCalledBeforeDeclaration) {
+    ASSERT_NO_THROW(parseSource(R"(
+        def first() -> int { return second(); }
+        def second() -> int { return 2; }
+    )"));
+}
+
+TEST(TypeCheckerTest, CheckMismatchedDeclaration) {
+    ASSERT_THROW(parseSource("var x: int = \"text\";"), ZynkError);
+}
+
+TEST(TypeCheckerTest, CheckMismatchedModify) {
+    ASSERT_THROW(parseSource("var x: int = 1; x = 2.5;"), ZynkError);
+}
 
-    auto func = std::make_unique<ASTFunction>("myFunc", ASTValueType::Integer, 1);
-    env.declareFunction(std::move(func));
+TEST(TypeCheckerTest, CheckMismatchedArgument) {
+    ASSERT_THROW(parseSource("def show(a: int) -> null { println(a); } show(\"text\");"), ZynkError);
+}
+
+TEST(TypeCheckerTest, CheckInvalidArgumentCount) {
+    ASSERT_THROW(parseSource("def show(a: int) -> null { println(a); } show();"), ZynkError);
+}
+
+TEST(TypeCheckerTest, CheckMismatchedReturn) {
+    ASSERT_THROW(parseSource("def value() -> int { return \"text\"; }"), ZynkError);
+}
+
+TEST(TypeCheckerTest, CheckFunctionBodyThatIsNeverCalled) {
+    ASSERT_THROW(parseSource("def broken() -> null { println(1 + true); }"), ZynkError);
+}
+
+TEST(TypeCheckerTest, CheckUndefinedFunction) {
+    ASSERT_THROW(parseSource("println(missing());"), ZynkError);
+}
+
+TEST(TypeCheckerTest, CheckFunctionOutOfScope) {
+    ASSERT_THROW(parseSource(R"(
+        if (true) {
+            def inner() -> int { return 1; }
+        }
+        println(inner());
+    )"), ZynkError);
+}
+
+TEST(TypeCheckerTest, CheckDuplicateArgument) {
+    ASSERT_THROW(parseSource("def add(a: int, a: int) -> int { return a + a; }"), ZynkError);
+}
+
+TEST(TypeCheckerTest, CheckLogicalOperandsOfDifferentTypes) {
+    // Comparisons bind as tightly as `and`, so the operands here are a bool and an int.
+    auto program = parseSource(R"(
+        var i: int = 5;
+        if (i > 3 and i < 10) { println("in"); }
+        var b: bool = i > 3 and i < 10;
+        println(1 and "x");
+    )");
+    const auto print = static_cast<ASTPrint*>(program->body[3].get());
+    ASSERT_EQ(print->expression->staticType, ASTValueType::None);
+}
 
-    auto funcCall = std::make_unique<ASTFunctionCall>("myFunc", 1);
-    ASSERT_EQ(typeChecker.determineType(funcCall.get()), ASTValueType::Integer);
-    env.exitCurrentBlock();
-}
\ No newline at end of file
+TEST(TypeCheckerTest, CheckLogicalOperandsOfDifferentTypesWhereTypeIsDeclared) {
+    ASSERT_THROW(parseSource("var c: bool = 1 > 2 or 3;"), ZynkError);
+    ASSERT_THROW(parseSource("var c: int = 0; c = 1 and 2.5;"), ZynkError);
+    ASSERT_THROW(parseSource("println((0 or 2.5) + 1);"), ZynkError);
+    ASSERT_THROW(parseSource("def value() -> int { return 1 and \"x\"; }"), ZynkError);
+}
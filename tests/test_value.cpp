@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+#include "../src/value/include/value.hpp"
+#include "../src/value/include/numeric.hpp"
+
+TEST(ValueTest, DefaultIsNone) {
+    const Value value;
+    ASSERT_EQ(value.type(), ASTValueType::None);
+    ASSERT_EQ(value.toString(), "null");
+    ASSERT_FALSE(value.isTruthy());
+}
+
+TEST(ValueTest, FromLiteral) {
+    ASSERT_EQ(Value::fromLiteral("-5", ASTValueType::Integer).asInt(), -5);
+    ASSERT_DOUBLE_EQ(Value::fromLiteral("3.5", ASTValueType::Float).asFloat(), 3.5);
+    ASSERT_TRUE(Value::fromLiteral("true", ASTValueType::Bool).asBool());
+    ASSERT_FALSE(Value::fromLiteral("false", ASTValueType::Bool).asBool());
+    ASSERT_EQ(Value::fromLiteral("Hello", ASTValueType::String).asString(), "Hello");
+    ASSERT_EQ(Value::fromLiteral("null", ASTValueType::None).type(), ASTValueType::None);
+}
+
+TEST(ValueTest, Truthiness) {
+    ASSERT_TRUE(Value::fromInt(1).isTruthy());
+    ASSERT_FALSE(Value::fromInt(0).isTruthy());
+    ASSERT_FALSE(Value::fromFloat(0.0).isTruthy());
+    ASSERT_TRUE(Value::fromString("abc").isTruthy());
+    ASSERT_FALSE(Value::fromString("").isTruthy());
+    ASSERT_FALSE(Value::fromString("false").isTruthy());
+    ASSERT_FALSE(Value::fromString("0").isTruthy());
+}
+
+TEST(ValueTest, StringIsSharedBetweenCopies) {
+    const Value original = Value::fromString("shared");
+    Value copy = original;
+    ASSERT_EQ(&copy.asString(), &original.asString());
+
+    copy = Value::fromInt(5);
+    ASSERT_EQ(original.asString(), "shared");
+    ASSERT_EQ(copy.asInt(), 5);
+}
+
+TEST(ValueTest, MoveLeavesNone) {
+    Value source = Value::fromString("moved");
+    const Value target = std::move(source);
+    ASSERT_EQ(target.asString(), "moved");
+    ASSERT_EQ(source.type(), ASTValueType::None);
+}
+
+TEST(ValueTest, AppendTo) {
+    std::string out;
+    Value::fromInt(42).appendTo(out);
+    out += " ";
+    Value::fromBool(true).appendTo(out);
+    out += " ";
+    Value().appendTo(out);
+    ASSERT_EQ(out, "42 true null");
+}
+
+TEST(ValueTest, FloatShortestRoundTrip) {
+    ASSERT_EQ(Value::fromFloat(3.14).toString(), "3.14");
+    ASSERT_EQ(Value::fromFloat(0.1 + 0.2).toString(), "0.30000000000000004");
+    ASSERT_EQ(Value::fromFloat(-2.0).toString(), "-2.0");
+    ASSERT_EQ(Value::fromFloat(1e300).toString(), "1e+300");
+    ASSERT_EQ(Value::fromInt(INT64_MIN).toString(), "-9223372036854775808");
+}
+
+TEST(NumericTest, ParseInteger) {
+    int64_t value = 0;
+    ASSERT_TRUE(parseInteger(" 42 ", value));
+    ASSERT_EQ(value, 42);
+    ASSERT_TRUE(parseInteger("+7", value));
+    ASSERT_EQ(value, 7);
+    ASSERT_FALSE(parseInteger("12abc", value));
+    ASSERT_FALSE(parseInteger("", value));
+    ASSERT_FALSE(parseInteger("99999999999999999999", value));
+}
+
+TEST(NumericTest, ParseFloat) {
+    double value = 0;
+    ASSERT_TRUE(parseFloat("42.50", value));
+    ASSERT_DOUBLE_EQ(value, 42.5);
+    ASSERT_TRUE(parseFloat("-1e3", value));
+    ASSERT_DOUBLE_EQ(value, -1000);
+    ASSERT_FALSE(parseFloat("abc", value));
+    ASSERT_FALSE(parseFloat("+-1", value));
+}
@@ -0,0 +1,163 @@
+#include <gtest/gtest.h>
+
+#include "../src/execution/vm/include/compiler.hpp"
+#include "../src/execution/vm/include/vm.hpp"
+#include "../src/execution/optimizer/include/optimizer.hpp"
+#include "../src/errors/include/errors.hpp"
+#include "helpers.hpp"
+
+TEST(CompilerTest, CompileBinaryOperation) {
+    auto program = parseSource("println(1 + 2);");
+    Compiler compiler;
+    auto compiled = compiler.compile(*program);
+
+    const std::vector<OpCode> expected = {
+        OpCode::PushConstant,
+        OpCode::PushConstant,
+        OpCode::Add,
+        OpCode::Print,
+        OpCode::Halt,
+    };
+    ASSERT_EQ(compiled->main.code.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); i++) {
+        ASSERT_EQ(compiled->main.code[i].op, expected[i]);
+    }
+    ASSERT_EQ(compiled->constants.size(), 2);
+    ASSERT_EQ(compiled->constants[0].asInt(), 1);
+    ASSERT_EQ(compiled->constants[1].asInt(), 2);
+}
+
+TEST(CompilerTest, CompileFunctionIntoSeparateChunk) {
+    auto program = parseSource(R"(
+        def add(a: int, b: int) -> int {
+            return a + b;
+        }
+        add(1, 2);
+    )");
+    Compiler compiler;
+    auto compiled = compiler.compile(*program);
+
+    ASSERT_EQ(compiled->functions.size(), 1);
+    ASSERT_EQ(compiled->functions[0]->declaration->name, "add");
+
+    const Chunk& body = compiled->functions[0]->chunk;
+    ASSERT_EQ(body.code.back().op, OpCode::ReturnNone);
+    ASSERT_EQ(body.code[body.code.size() - 2].op, OpCode::Return);
+}
+
+TEST(CompilerTest, CompileFStringAheadOfTime) {
+    auto program = parseSource("var x: int = 1; println(f\"x: {x}!\");");
+    Compiler compiler;
+    auto compiled = compiler.compile(*program);
+
+    size_t concatCount = 0;
+    for (const Instruction& instruction : compiled->main.code) {
+        if (instruction.op != OpCode::Concat) continue;
+        ASSERT_EQ(instruction.a, 3);
+        concatCount++;
+    }
+    ASSERT_EQ(concatCount, 1);
+}
+
+TEST(CompilerTest, BreakOutsideLoopThrowsError) {
+    auto program = parseSource("break;");
+    Compiler compiler;
+    ASSERT_THROW(compiler.compile(*program), ZynkError);
+}
+
+TEST(CompilerTest, ReturnOutsideFunctionThrowsError) {
+    auto program = parseSource("return 1;");
+    Compiler compiler;
+    ASSERT_THROW(compiler.compile(*program), ZynkError);
+}
+
+TEST(VirtualMachineTest, ReturnFromNestedLoopInsideCondition) {
+    auto program = parseSource(R"(
+        def find() -> int {
+            var i: int = 0;
+            while (true) {
+                while (true) {
+                    if (i == 3) {
+                        return i;
+                    }
+                    i = i + 1;
+                }
+            }
+        }
+        println(find());
+    )");
+    Compiler compiler;
+    auto compiled = compiler.compile(*program);
+
+    testing::internal::CaptureStdout();
+    VirtualMachine vm;
+    vm.run(*compiled);
+    ASSERT_EQ(testing::internal::GetCapturedStdout(), "3\n");
+}
+
+TEST(VirtualMachineTest, BreakClosesInnerBlocks) {
+    auto program = parseSource(R"(
+        var i: int = 0;
+        while (true) {
+            if (i == 2) {
+                var inner: int = i;
+                break;
+            }
+            i = i + 1;
+        }
+        var inner: string = "outer";
+        println(inner);
+    )");
+    Compiler compiler;
+    auto compiled = compiler.compile(*program);
+
+    testing::internal::CaptureStdout();
+    VirtualMachine vm;
+    vm.run(*compiled);
+    ASSERT_EQ(testing::internal::GetCapturedStdout(), "outer\n");
+}
+
+TEST(VirtualMachineTest, ProgramCanBeRunMultipleTimes) {
+    auto program = parseSource(R"(
+        def greet(name: string) -> null {
+            println(f"Hello, {name}!");
+        }
+        greet("Zynk");
+    )");
+    Compiler compiler;
+    auto compiled = compiler.compile(*program);
+
+    testing::internal::CaptureStdout();
+    VirtualMachine vm;
+    vm.run(*compiled);
+    vm.run(*compiled);
+    ASSERT_EQ(testing::internal::GetCapturedStdout(), "Hello, Zynk!\nHello, Zynk!\n");
+}
+
+TEST(VirtualMachineTest, CountedLoopUsesFusedInstructions) {
+    auto program = parseSource(R"(
+        var n: int = 5;
+        var i: int = 0;
+        var total: int = 0;
+        while (i < n) {
+            total = total + i;
+            i = i + 1;
+        }
+        println(f"{i} {total}");
+    )");
+    Optimizer().optimize(*program);
+    Compiler compiler;
+    auto compiled = compiler.compile(*program);
+
+    ASSERT_EQ(compiled->countedLoops.size(), 1);
+    size_t fused = 0;
+    for (const Instruction& instruction : compiled->main.code) {
+        if (instruction.op == OpCode::CountedTest || instruction.op == OpCode::CountedStep) fused++;
+    }
+    ASSERT_EQ(fused, 2);
+
+    testing::internal::CaptureStdout();
+    VirtualMachine vm;
+    vm.run(*compiled);
+    ASSERT_EQ(testing::internal::GetCapturedStdout(), "5 10\n");
+}